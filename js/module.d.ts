@@ -248,6 +248,7 @@ export declare const enum ERenderingMode {
 	OBS_RECORDING_RENDERING = 2
 }
 export declare const Global: IGlobal;
+export declare const Collection: ICollection;
 export declare const Video: IVideo;
 export declare const OutputFactory: IOutputFactory;
 export declare const AudioEncoderFactory: IAudioEncoderFactory;
@@ -320,10 +321,18 @@ export interface IIPC {
     host(uri: string): void;
     disconnect(): void;
 }
+export interface ITypeInfo {
+    readonly id: string;
+    readonly type: ESourceType;
+    readonly name: string;
+    readonly outputFlags: number;
+    readonly configurable: boolean;
+}
 export interface IGlobal {
     startup(locale: string, path?: string): void;
     shutdown(): void;
     getOutputFlagsFromId(id: string): number;
+    getTypeCatalog(): ITypeInfo[];
     setOutputSource(channel: number, input: ISource): void;
     getOutputSource(channel: number): ISource;
     readonly totalFrames: number;
@@ -333,6 +342,16 @@ export interface IGlobal {
     multipleRendering: boolean;
     readonly version: number;
 }
+export interface ICollectionCounts {
+    readonly inputs: number;
+    readonly scenes: number;
+    readonly transitions: number;
+}
+export interface ICollection {
+    save(path: string): void;
+    load(path: string): ICollectionCounts;
+    exportJSON(path: string): string;
+}
 export interface IBooleanProperty extends IProperty {
 }
 export interface IColorProperty extends IProperty {
@@ -642,7 +661,7 @@ export interface IVolmeter {
     updateInterval: number;
     attach(source: IInput): void;
     detach(): void;
-    addCallback(cb: (magnitude: number[], peak: number[], inputPeak: number[]) => void): ICallbackData;
+    addCallback(cb: (magnitude: Float32Array, peak: Float32Array, inputPeak: Float32Array) => void): ICallbackData;
     removeCallback(cbData: ICallbackData): void;
 }
 export interface ICallbackData {
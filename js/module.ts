@@ -334,6 +334,7 @@ export const enum ERenderingMode {
 }
 
 export const Global: IGlobal = obs.Global;
+export const Collection: ICollection = obs.Collection;
 export const Video: IVideo = obs.Video;
 export const OutputFactory: IOutputFactory = obs.Output;
 export const AudioEncoderFactory: IAudioEncoderFactory = obs.AudioEncoder;
@@ -464,6 +465,14 @@ export interface IIPC {
 	disconnect(): void;
 }
  
+export interface ITypeInfo {
+    readonly id: string;
+    readonly type: ESourceType;
+    readonly name: string;
+    readonly outputFlags: number;
+    readonly configurable: boolean;
+}
+
 export interface IGlobal {
     /**
      * Initializes libobs global context
@@ -483,6 +492,13 @@ export interface IGlobal {
      */
     getOutputFlagsFromId(id: string): number;
 
+    /**
+     * Every registered input, filter and transition type. The result is
+     * cached and only refreshed after modules are opened or initialized.
+     * @returns - One entry per type, inputs first, then filters and transitions
+     */
+    getTypeCatalog(): ITypeInfo[];
+
     /**
      * Output channels are useful in that we can attach multiple
      * sources for output. For the most part, you're generally only
@@ -540,6 +556,41 @@ export interface IGlobal {
     readonly version: number;
 }
 
+export interface ICollectionCounts {
+    readonly inputs: number;
+    readonly scenes: number;
+    readonly transitions: number;
+}
+
+/**
+ * Saves and loads the whole scene collection in a single call, using a
+ * versioned binary snapshot file.
+ */
+export interface ICollection {
+    /**
+     * Writes every public input, scene, scene item and transition, plus
+     * the output channels, to a snapshot file. The file is replaced
+     * atomically.
+     * @param path - Path of the snapshot file
+     */
+    save(path: string): void;
+
+    /**
+     * Creates the objects stored in a snapshot. Sources whose name already
+     * exists are kept as they are. Use the factories' fromName to get them.
+     * @param path - Path of the snapshot file
+     * @returns - Number of objects that were created
+     */
+    load(path: string): ICollectionCounts;
+
+    /**
+     * Decodes a snapshot for debugging, without creating anything.
+     * @param path - Path of the snapshot file
+     * @returns - The snapshot contents as JSON text
+     */
+    exportJSON(path: string): string;
+}
+
 export interface IBooleanProperty extends IProperty {
 
 }
@@ -1048,6 +1099,18 @@ export interface IInput extends ISource {
      * Height of the underlying source
      */
     readonly height: number;
+
+    /**
+     * Non-blocking variant of {@link width}
+     * @returns - A promise resolving to the width of the underlying source
+     */
+    getWidthAsync(): Promise<number>;
+
+    /**
+     * Non-blocking variant of {@link height}
+     * @returns - A promise resolving to the height of the underlying source
+     */
+    getHeightAsync(): Promise<number>;
 }
 
 export interface ISceneFactory {
@@ -1136,6 +1199,12 @@ export interface IScene extends ISource {
      */
     getItems(): ISceneItem[];
 
+    /**
+     * Non-blocking variant of {@link getItems}
+     * @returns - A promise resolving to the array of item instances
+     */
+    getItemsAsync(): Promise<ISceneItem[]>;
+
     /**
      * Connect a callback to a particular signal 
      * associated with this scene. 
@@ -1178,6 +1247,12 @@ export interface ISceneItem {
     /** Position of the item */
     position: IVec2;
 
+    /**
+     * Non-blocking variant of {@link position}
+     * @returns - A promise resolving to the position of the item
+     */
+    getPositionAsync(): Promise<IVec2>;
+
     /** Rotation of the in degrees */
     rotation: number;
 
@@ -1330,6 +1405,18 @@ export interface ISource extends IConfigurable, IReleasable {
      */
     remove(): void;
 
+    /**
+     * Non-blocking variant of {@link properties}
+     * @returns - A promise resolving to the properties of the source
+     */
+    getPropertiesAsync(): Promise<IProperties>;
+
+    /**
+     * Non-blocking variant of {@link settings}
+     * @returns - A promise resolving to the current settings of the source
+     */
+    getSettingsAsync(): Promise<ISettings>;
+
     /**
      * Send a save signal to sources themselves. 
      * This should always be called before saving to disk 
@@ -1468,12 +1555,14 @@ export interface IVolmeter {
     /**
      * Add a callback to the volmeter. Callback will be called
      * each time volume associated with the attached source changes. 
+     * The arrays are views on a buffer owned by the volmeter and are
+     * reused by later calls, copy them to keep the values around.
      * @param cb - A callback that occurs when volume changes.
      */
     addCallback(
-        cb: (magnitude: number[],
-             peak: number[],
-             inputPeak: number[]) => void): ICallbackData;
+        cb: (magnitude: Float32Array,
+             peak: Float32Array,
+             inputPeak: Float32Array) => void): ICallbackData;
 
     /**
      * Remove a callback to prevent events from occuring immediately. 
@@ -1554,6 +1643,13 @@ export interface IModuleFactory extends IFactoryTypes {
     addPath(path: string, dataPath: string): void;
     logLoaded(): void;
     modules(): String[];
+
+    /**
+     * Every module loaded in libobs, described with a single call.
+     * Name, paths, author and description of the returned modules
+     * are served from a cache until a module is opened or initialized.
+     */
+    describeAll(): IModule[];
 }
 
 export interface IModule {
@@ -0,0 +1,182 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "async-call.hpp"
+#include <map>
+#include <mutex>
+#include "controller.hpp"
+#include "error.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+struct PendingCall
+{
+	Napi::Promise::Deferred  deferred;
+	asyncCall::resolver_t    resolver;
+	std::vector<ipc::value>  response;
+};
+
+static Napi::ThreadSafeFunction dispatcher;
+static bool                     dispatcherCreated = false;
+
+// Calls waiting for their response. The IPC callback only carries the key,
+// so a response arriving after the call was rejected finds nothing to settle.
+static std::mutex                       pendingMutex;
+static std::map<uint64_t, PendingCall*> pendingCalls;
+static uint64_t                         pendingNext = 0;
+
+static PendingCall* TakePending(uint64_t key)
+{
+	std::unique_lock<std::mutex> lock(pendingMutex);
+	auto                         it = pendingCalls.find(key);
+	if (it == pendingCalls.end())
+		return nullptr;
+
+	PendingCall* pending = it->second;
+	pendingCalls.erase(it);
+	return pending;
+}
+
+static bool CheckResponse(const std::vector<ipc::value>& response, std::string& error)
+{
+	if (response.size() == 0) {
+		error = "Failed to make IPC call, verify IPC status.";
+		return false;
+	}
+
+	if ((response.size() == 1) && (response[0].type == ipc::type::Null)) {
+		error = response[0].value_str;
+		return false;
+	}
+
+	ErrorCode code = (ErrorCode)response[0].value_union.ui64;
+	if (code != ErrorCode::Ok) {
+		if (response.size() == 1)
+			error = "Error without description.";
+		else
+			error = response[1].value_str;
+		return false;
+	}
+
+	return true;
+}
+
+static void Settle(Napi::Env env, Napi::Function, PendingCall* pending)
+{
+	std::string error;
+	if (!CheckResponse(pending->response, error)) {
+		pending->deferred.Reject(Napi::Error::New(env, error).Value());
+		delete pending;
+		return;
+	}
+
+	Napi::Value value = pending->resolver(env, pending->response);
+	if (env.IsExceptionPending()) {
+		pending->deferred.Reject(env.GetAndClearPendingException().Value());
+	} else {
+		pending->deferred.Resolve(value);
+	}
+	delete pending;
+}
+
+// Runs on the IPC client's reader thread.
+static void OnResponse(const void* data, const std::vector<ipc::value>& rval)
+{
+	PendingCall* pending = TakePending(reinterpret_cast<uintptr_t>(data));
+	if (!pending)
+		return;
+
+	pending->response = rval;
+
+	if (dispatcher.NonBlockingCall(pending, Settle) != napi_ok)
+		delete pending;
+}
+
+static void CreateDispatcher(Napi::Env env)
+{
+	if (dispatcherCreated)
+		return;
+
+	dispatcher = Napi::ThreadSafeFunction::New(
+	    env,
+	    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+	    "AsyncCall",
+	    0,
+	    1,
+	    [](Napi::Env) {});
+	// Outstanding calls must not keep the event loop alive on their own.
+	dispatcher.Unref(env);
+	dispatcherCreated = true;
+}
+
+Napi::Value asyncCall::Call(
+    const Napi::CallbackInfo& info,
+    const std::string&        cname,
+    const std::string&        fname,
+    std::vector<ipc::value>   args,
+    resolver_t                resolver)
+{
+	Napi::Env env = info.Env();
+	CreateDispatcher(env);
+
+	PendingCall* pending = new PendingCall{Napi::Promise::Deferred::New(env), resolver, {}};
+	Napi::Promise promise = pending->deferred.Promise();
+
+	auto conn = Controller::GetInstance().GetConnection();
+	if (!conn) {
+		pending->deferred.Reject(Napi::Error::New(env, "Failed to obtain IPC connection.").Value());
+		delete pending;
+		return promise;
+	}
+
+	uint64_t key;
+	{
+		std::unique_lock<std::mutex> lock(pendingMutex);
+		key = ++pendingNext;
+		pendingCalls.emplace(key, pending);
+	}
+
+	if (!conn->call(cname, fname, std::move(args), OnResponse, reinterpret_cast<void*>(uintptr_t(key)))) {
+		// The connection is gone, nothing in flight will be answered either.
+		asyncCall::RejectPending();
+	}
+
+	return promise;
+}
+
+void asyncCall::RejectPending()
+{
+	std::map<uint64_t, PendingCall*> calls;
+	{
+		std::unique_lock<std::mutex> lock(pendingMutex);
+		calls.swap(pendingCalls);
+	}
+
+	// An empty response settles as "Failed to make IPC call".
+	for (auto& call : calls) {
+		if (!dispatcherCreated || dispatcher.NonBlockingCall(call.second, Settle) != napi_ok)
+			delete call.second;
+	}
+}
+
+Napi::Value asyncCall::Resolved(Napi::Env env, Napi::Value value)
+{
+	Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+	deferred.Resolve(value);
+	return deferred.Promise();
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <functional>
+#include <napi.h>
+#include <string>
+#include <vector>
+#include "ipc-value.hpp"
+
+namespace asyncCall
+{
+	// Converts a validated response into the value the promise resolves with.
+	// Always invoked on the JS thread.
+	typedef std::function<Napi::Value(Napi::Env env, const std::vector<ipc::value>& response)> resolver_t;
+
+	// Issues a non-blocking IPC call and returns a promise for its result.
+	// Calls are pipelined over the shared connection and matched to their
+	// response by the IPC call id, so several of them may be in flight at once.
+	Napi::Value Call(
+	    const Napi::CallbackInfo& info,
+	    const std::string&        cname,
+	    const std::string&        fname,
+	    std::vector<ipc::value>   args,
+	    resolver_t                resolver);
+
+	// Rejects every call still waiting for a response, used when the
+	// connection goes away and the responses will never arrive.
+	void RejectPending();
+
+	// Returns a promise that is already resolved, used when a cached value can
+	// answer the query without a round trip.
+	Napi::Value Resolved(Napi::Env env, Napi::Value value);
+}
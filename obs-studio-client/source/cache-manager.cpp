@@ -17,3 +17,9 @@
 ******************************************************************************/
 
 #include "cache-manager.hpp"
+
+settings_store::Pool& SettingsPool()
+{
+	static settings_store::Pool pool;
+	return pool;
+}
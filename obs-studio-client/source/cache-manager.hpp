@@ -18,6 +18,10 @@
 
 #include "utility-v8.hpp"
 #include "properties.hpp"
+#include "settings-store.hpp"
+
+// Settings JSON is interned, sources with the same settings share one copy.
+settings_store::Pool& SettingsPool();
 
 struct SceneInfo
 {
@@ -36,8 +40,8 @@ struct SourceDataInfo
 	bool isMuted      = false;
 	bool mutedChanged = true;
 
-	std::string setting         = "";
-	bool        settingsChanged = true;
+	settings_store::blob_t setting;
+	bool                   settingsChanged = true;
 
 	osn::property_map_t properties;
 	bool                propertiesChanged = true;
@@ -21,6 +21,7 @@
 #include "error.hpp"
 #include "utility-v8.hpp"
 
+#include <algorithm>
 #include <node.h>
 #include <sstream>
 #include <string>
@@ -35,7 +36,7 @@ std::thread* globalCallback::worker_thread = nullptr;
 Napi::ThreadSafeFunction globalCallback::js_thread;
 bool globalCallback::m_all_workers_stop = false;
 std::mutex globalCallback::mtx_volmeters;
-std::map<uint64_t, Napi::ThreadSafeFunction> globalCallback::volmeters;
+std::map<uint64_t, VolmeterCallback> globalCallback::volmeters;
 
 void globalCallback::Init(Napi::Env env, Napi::Object exports)
 {
@@ -111,24 +112,12 @@ void globalCallback::worker()
 		jsCallback.Call({ result });
     };
 
-    auto volmeter_callback = []( Napi::Env env, Napi::Function jsCallback, VolmeterData* data ) {
-		Napi::Array magnitude = Napi::Array::New(env);
-		Napi::Array peak = Napi::Array::New(env);
-		Napi::Array input_peak = Napi::Array::New(env);
-
-		for (size_t i = 0; i < data->magnitude.size(); i++) {
-			magnitude.Set(i, Napi::Number::New(env, data->magnitude[i]));
-		}
-		for (size_t i = 0; i < data->peak.size(); i++) {
-			peak.Set(i, Napi::Number::New(env, data->peak[i]));
-		}
-		for (size_t i = 0; i < data->input_peak.size(); i++) {
-			input_peak.Set(i, Napi::Number::New(env, data->input_peak[i]));
-		}
-
-		if (data->magnitude.size() > 0 && data->peak.size() > 0 && data->input_peak.size() > 0) {
-			jsCallback.Call({ magnitude, peak, input_peak });
-		}
+    // Levels are handed over as Float32Array views on the meter's own buffer, the same views are
+    // passed again on later ticks so nothing is allocated per call.
+    auto volmeter_callback = []( Napi::Env env, Napi::Function jsCallback, VolmeterSlot* slot ) {
+		slot->UpdateViews(env);
+		jsCallback.Call({ slot->magnitude.Value(), slot->peak.Value(), slot->input_peak.Value() });
+		slot->owner->Release();
     };
 
 	size_t totalSleepMS = 0;
@@ -181,24 +170,26 @@ void globalCallback::worker()
 
 			index++;
 
-			for (auto vol: volmeters) {
-				VolmeterData* data     = new VolmeterData{{}, {}, {}};
+			for (auto& vol: volmeters) {
 				size_t channels = response[index++].value_union.i32;
 				bool isMuted = response[index++].value_union.i32;
-				if (!channels)
+				if (!channels || isMuted)
 					continue;
-				if (!isMuted) {
-					data->magnitude.resize(channels);
-					data->peak.resize(channels);
-					data->input_peak.resize(channels);
-					for (size_t ch = 0; ch < channels; ch++) {
-						data->magnitude[ch]  = response[index + ch * 3 + 0].value_union.fp32;
-						data->peak[ch]       = response[index + ch * 3 + 1].value_union.fp32;
-						data->input_peak[ch] = response[index + ch * 3 + 2].value_union.fp32;
+
+				// JS is still behind by two ticks, drop this one rather than queue more.
+				VolmeterSlot* slot = vol.second.buffer->Acquire();
+				if (slot) {
+					slot->channels = uint32_t(std::min<size_t>(channels, VOLMETER_MAX_CHANNELS));
+					for (size_t ch = 0; ch < slot->channels; ch++) {
+						slot->levels[ch]                             = response[index + ch * 3 + 0].value_union.fp32;
+						slot->levels[VOLMETER_MAX_CHANNELS + ch]     = response[index + ch * 3 + 1].value_union.fp32;
+						slot->levels[2 * VOLMETER_MAX_CHANNELS + ch] = response[index + ch * 3 + 2].value_union.fp32;
 					}
-					vol.second.NonBlockingCall(data, volmeter_callback);
-					index += (3 * channels);
+					vol.second.buffer->Submit(slot);
+					if (vol.second.callback.NonBlockingCall(slot, volmeter_callback) != napi_ok)
+						vol.second.buffer->Release();
 				}
+				index += (3 * channels);
 			}
 
 		}
@@ -216,21 +207,25 @@ void globalCallback::worker()
 
 void globalCallback::add_volmeter(napi_env env, uint64_t id, Napi::Function cb)
 {
+	// The buffer lives until the last queued tick was delivered, which is when the finalizer runs.
+	VolmeterBuffer* buffer = new VolmeterBuffer(Napi::Env(env));
 	Napi::ThreadSafeFunction vol_thread = Napi::ThreadSafeFunction::New(
       env,
       cb,
       "Volmeter",
       0,
       1,
-      []( Napi::Env ) {} );
-	volmeters.insert(std::make_pair(id, vol_thread));
+      []( Napi::Env, VolmeterBuffer* buffer ) { delete buffer; },
+      buffer );
+	volmeters.insert(std::make_pair(id, VolmeterCallback{vol_thread, buffer}));
 }
 
 void globalCallback::remove_volmeter(uint64_t id)
 {
-	if (volmeters.find(id) == volmeters.end())
+	auto it = volmeters.find(id);
+	if (it == volmeters.end())
 		return;
-	
-	volmeters[id].Release();
-	volmeters.erase(id);
+
+	it->second.callback.Release();
+	volmeters.erase(it);
 }
\ No newline at end of file
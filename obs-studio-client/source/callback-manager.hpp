@@ -35,6 +35,14 @@ struct SourceSizeInfoData
 	std::vector<SourceSizeInfo*> items;
 };
 
+struct VolmeterBuffer;
+
+struct VolmeterCallback
+{
+	Napi::ThreadSafeFunction callback;
+	VolmeterBuffer*          buffer;
+};
+
 namespace globalCallback
 {
 	extern bool isWorkerRunning;
@@ -45,7 +53,7 @@ namespace globalCallback
 	extern bool m_all_workers_stop;
 
 	extern std::mutex mtx_volmeters;
-	extern std::map<uint64_t, Napi::ThreadSafeFunction> volmeters;
+	extern std::map<uint64_t, VolmeterCallback> volmeters;
 
 	void worker(void);
 	void start_worker(napi_env env, Napi::Function async_callback);
@@ -0,0 +1,101 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "collection.hpp"
+#include <ipc-value.hpp>
+#include "controller.hpp"
+#include "error.hpp"
+#include "ipc-registry.hpp"
+#include "utility-v8.hpp"
+
+Napi::FunctionReference osn::Collection::constructor;
+
+Napi::Object osn::Collection::Init(Napi::Env env, Napi::Object exports) {
+	Napi::HandleScope scope(env);
+	Napi::Function func =
+		DefineClass(env,
+		"Collection",
+		{
+			StaticMethod("save", &osn::Collection::save),
+			StaticMethod("load", &osn::Collection::load),
+			StaticMethod("exportJSON", &osn::Collection::exportJSON),
+		});
+	exports.Set("Collection", func);
+	osn::Collection::constructor = Napi::Persistent(func);
+	osn::Collection::constructor.SuppressDestruct();
+	return exports;
+}
+
+osn::Collection::Collection(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<osn::Collection>(info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+}
+
+Napi::Value osn::Collection::save(const Napi::CallbackInfo& info)
+{
+	std::string path = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(conn, ipc_registry::Collection::Save, path);
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Collection::load(const Napi::CallbackInfo& info)
+{
+	std::string path = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(conn, ipc_registry::Collection::Load, path);
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object counts = Napi::Object::New(info.Env());
+	counts.Set("inputs", Napi::Number::New(info.Env(), response[1].value_union.ui32));
+	counts.Set("scenes", Napi::Number::New(info.Env(), response[2].value_union.ui32));
+	counts.Set("transitions", Napi::Number::New(info.Env(), response[3].value_union.ui32));
+	return counts;
+}
+
+Napi::Value osn::Collection::exportJSON(const Napi::CallbackInfo& info)
+{
+	std::string path = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    ipc_registry::call_synchronous(conn, ipc_registry::Collection::ExportJSON, path);
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::String::New(info.Env(), response[1].value_str);
+}
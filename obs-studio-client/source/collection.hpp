@@ -0,0 +1,35 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <napi.h>
+
+namespace osn
+{
+	class Collection : public Napi::ObjectWrap<osn::Collection>
+	{
+		public:
+		static Napi::FunctionReference constructor;
+		static Napi::Object Init(Napi::Env env, Napi::Object exports);
+		Collection(const Napi::CallbackInfo& info);
+
+		static Napi::Value save(const Napi::CallbackInfo& info);
+		static Napi::Value load(const Napi::CallbackInfo& info);
+		static Napi::Value exportJSON(const Napi::CallbackInfo& info);
+	};
+}
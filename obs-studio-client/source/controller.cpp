@@ -18,11 +18,16 @@
 
 #include "controller.hpp"
 #include <codecvt>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <locale>
 #include <sstream>
 #include <string>
+#include "async-call.hpp"
+#include "error.hpp"
+#include "ipc-registry.hpp"
+#include "server-readiness.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -50,10 +55,13 @@ return OSN_VERSION; \
 #include <wchar.h>
 #include <windows.h>
 #else
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <libproc.h>
 #include <iostream>
 #include <spawn.h>
+#include <unistd.h>
 extern char **environ;
 #endif
 
@@ -259,7 +267,10 @@ static void write_pid_file(std::string& pid_path, uint64_t pid)
 
 Controller::Controller() {}
 
-Controller::~Controller() {}
+Controller::~Controller()
+{
+	closeReadiness();
+}
 
 std::shared_ptr<ipc::client> Controller::host(const std::string& uri)
 {
@@ -288,8 +299,12 @@ std::shared_ptr<ipc::client> Controller::host(const std::string& uri)
 
 	check_pid_file(pid_path);
 
+	closeReadiness();
+	m_readyEvent = CreateEventA(NULL, TRUE, FALSE, readiness::EventName(uri).c_str());
+
 	procId = spawn(serverBinaryPath, commandLine.str(), workingDirectory);
 	if (procId.id == 0) {
+		closeReadiness();
 		return nullptr;
 	}
 
@@ -325,7 +340,27 @@ std::shared_ptr<ipc::client> Controller::host(const std::string& uri)
     char *argv[] = {"obs64", uri_str.data(), (char*)version.c_str(), (char*)serverBinaryPath.c_str(), NULL};
     remove(uri.c_str());
 
-	int ret  = posix_spawnp(&pid, serverBinaryPath.c_str(), NULL, NULL, argv, environ);
+	// The server inherits the write end and writes to it once it listens
+	closeReadiness();
+	int readyPipe[2] = {-1, -1};
+	std::vector<std::string> env;
+	if (pipe(readyPipe) == 0) {
+		fcntl(readyPipe[0], F_SETFD, FD_CLOEXEC);
+		m_readyFd = readyPipe[0];
+		env.push_back(std::string(readiness::FdEnvironmentVariable) + "=" + std::to_string(readyPipe[1]));
+	}
+	for (char** var = environ; *var; var++) {
+		if (strncmp(*var, readiness::FdEnvironmentVariable, strlen(readiness::FdEnvironmentVariable)) != 0)
+			env.push_back(*var);
+	}
+	std::vector<char*> envp;
+	for (std::string& var : env)
+		envp.push_back(&var[0]);
+	envp.push_back(nullptr);
+
+	int ret  = posix_spawnp(&pid, serverBinaryPath.c_str(), NULL, NULL, argv, envp.data());
+	if (readyPipe[1] != -1)
+		close(readyPipe[1]);
     // Connect
     std::shared_ptr<ipc::client> cl = connect(uri);
     if (!cl) { // Assume the server broke or was not allowed to run.
@@ -350,6 +385,18 @@ std::shared_ptr<ipc::client> Controller::connect(
 	if (m_connection)
 		return nullptr;
 
+	// A server we spawned tells us when it listens, so the loop below normally
+	// succeeds on its first attempt. It remains the fallback for servers that
+	// were started elsewhere or never signal.
+	ServerReadiness serverState = waitForServerReady(std::chrono::seconds(30));
+	closeReadiness();
+	if (serverState == ServerReadiness::Exited) {
+#ifdef WIN32
+		is_process_alive(procId);
+#endif
+		return nullptr;
+	}
+
 	std::shared_ptr<ipc::client> cl;
 	using std::chrono::high_resolution_clock;
 	high_resolution_clock::time_point begin_time = high_resolution_clock::now();
@@ -383,17 +430,76 @@ std::shared_ptr<ipc::client> Controller::connect(
 		return nullptr;
 	}
 
+	// Both sides are built from the same ipc-registry.hpp, a server built from
+	// another one would silently misinterpret our calls.
+	std::vector<ipc::value> response =
+	    ipc_registry::call_synchronous(cl, ipc_registry::System::GetRegistryDigest);
+	if (response.size() < 2 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok
+	    || response[1].value_union.ui32 != ipc_registry::digest) {
+		procId.exit_code = ProcessInfo::VERSION_MISMATCH;
+		return nullptr;
+	}
+
 	m_connection = cl;
 	return m_connection;
 }
 
+Controller::ServerReadiness Controller::waitForServerReady(std::chrono::milliseconds timeout)
+{
+#ifdef WIN32
+	if (!m_readyEvent)
+		return ServerReadiness::Unknown;
+
+	HANDLE handles[2] = {(HANDLE)m_readyEvent, (HANDLE)procId.handle};
+	DWORD  count      = procId.handle ? 2 : 1;
+	switch (WaitForMultipleObjects(count, handles, FALSE, DWORD(timeout.count()))) {
+	case WAIT_OBJECT_0:
+		return ServerReadiness::Ready;
+	case WAIT_OBJECT_0 + 1:
+		return ServerReadiness::Exited;
+	default:
+		return ServerReadiness::Unknown;
+	}
+#else
+	if (m_readyFd == -1)
+		return ServerReadiness::Unknown;
+
+	// Readable means either the ready byte or EOF because the server died
+	pollfd pfd = {m_readyFd, POLLIN, 0};
+	if (poll(&pfd, 1, int(timeout.count())) <= 0)
+		return ServerReadiness::Unknown;
+
+	char    ready = 0;
+	ssize_t bytes = read(m_readyFd, &ready, 1);
+	if (bytes == 1)
+		return ServerReadiness::Ready;
+	return bytes == 0 ? ServerReadiness::Exited : ServerReadiness::Unknown;
+#endif
+}
+
+void Controller::closeReadiness()
+{
+#ifdef WIN32
+	if (m_readyEvent) {
+		CloseHandle((HANDLE)m_readyEvent);
+		m_readyEvent = nullptr;
+	}
+#else
+	if (m_readyFd != -1) {
+		close(m_readyFd);
+		m_readyFd = -1;
+	}
+#endif
+}
+
 void Controller::disconnect()
 {
 	if (m_isServer) {
-		m_connection->call_synchronous_helper("System", "Shutdown", {});
+		ipc_registry::call_synchronous(m_connection, ipc_registry::System::Shutdown);
 		m_isServer = false;
 	}
 	m_connection = nullptr;
+	asyncCall::RejectPending();
 }
 
 DWORD Controller::GetExitCode() {
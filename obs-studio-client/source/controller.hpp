@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #pragma once
+#include <chrono>
 #include <memory>
 #include <map>
 #include <string>
@@ -54,8 +55,26 @@ class Controller
 
 	std::shared_ptr<ipc::client> GetConnection();
 
+	private:
+	enum class ServerReadiness
+	{
+		Ready,
+		Exited,
+		Unknown,
+	};
+
+	// Blocks until the server we spawned signals that it listens, exits, or the
+	// timeout expires. Unknown also covers servers we did not spawn.
+	ServerReadiness waitForServerReady(std::chrono::milliseconds timeout);
+	void closeReadiness();
+
 	private:
 	bool                         m_isServer = false;
 	std::shared_ptr<ipc::client> m_connection;
 	ipc::ProcessInfo                  procId;
+#ifdef WIN32
+	void* m_readyEvent = nullptr;
+#else
+	int m_readyFd = -1;
+#endif
 };
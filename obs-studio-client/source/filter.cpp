@@ -24,6 +24,7 @@
 #include "error.hpp"
 #include "ipc-value.hpp"
 #include "shared.hpp"
+#include "type-catalog.hpp"
 #include "utility.hpp"
 
 Napi::FunctionReference osn::Filter::constructor;
@@ -40,6 +41,8 @@ Napi::Object osn::Filter::Init(Napi::Env env, Napi::Object exports) {
 			InstanceAccessor("configurable", &osn::Filter::CallIsConfigurable, nullptr),
 			InstanceAccessor("properties", &osn::Filter::CallGetProperties, nullptr),
 			InstanceAccessor("settings", &osn::Filter::CallGetSettings, nullptr),
+			InstanceMethod("getPropertiesAsync", &osn::Filter::CallGetPropertiesAsync),
+			InstanceMethod("getSettingsAsync", &osn::Filter::CallGetSettingsAsync),
 			InstanceAccessor("type", &osn::Filter::CallGetType, nullptr),
 			InstanceAccessor("name", &osn::Filter::CallGetName, &osn::Filter::CallSetName),
 			InstanceAccessor("outputFlags", &osn::Filter::CallGetOutputFlags, nullptr),
@@ -82,22 +85,7 @@ osn::Filter::Filter(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Filter::Types(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Filter", "Types", {});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	size_t count = response.size() - 1;
-	Napi::Array types = Napi::Array::New(info.Env(), count);
-
-	for (size_t idx = 0; idx < count; idx++)
-		types.Set(idx, Napi::String::New(info.Env(), response[1 + idx].value_str));
-
-	return types;
+	return osn::TypeCatalog::Types(info, osn::TypeCatalog::TYPE_FILTER);
 }
 
 Napi::Value osn::Filter::Create(const Napi::CallbackInfo& info)
@@ -159,6 +147,16 @@ Napi::Value osn::Filter::CallGetSettings(const Napi::CallbackInfo& info)
 	return osn::ISource::GetSettings(info, this->sourceId);
 }
 
+Napi::Value osn::Filter::CallGetPropertiesAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
+Napi::Value osn::Filter::CallGetSettingsAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetSettingsAsync(info, this->sourceId);
+}
+
 
 Napi::Value osn::Filter::CallGetType(const Napi::CallbackInfo& info)
 {
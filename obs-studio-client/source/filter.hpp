@@ -39,6 +39,8 @@ namespace osn
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
 		Napi::Value CallGetProperties(const Napi::CallbackInfo& info);
 		Napi::Value CallGetSettings(const Napi::CallbackInfo& info);
+		Napi::Value CallGetPropertiesAsync(const Napi::CallbackInfo& info);
+		Napi::Value CallGetSettingsAsync(const Napi::CallbackInfo& info);
 
 		Napi::Value CallGetType(const Napi::CallbackInfo& info);
 		Napi::Value CallGetName(const Napi::CallbackInfo& info);
@@ -22,9 +22,11 @@
 #include <mutex>
 #include "controller.hpp"
 #include "error.hpp"
+#include "ipc-registry.hpp"
 #include "input.hpp"
 #include "scene.hpp"
 #include "transition.hpp"
+#include "type-catalog.hpp"
 #include "utility-v8.hpp"
 
 Napi::FunctionReference osn::Global::constructor;
@@ -38,6 +40,7 @@ Napi::Object osn::Global::Init(Napi::Env env, Napi::Object exports) {
 			StaticMethod("getOutputSource", &osn::Global::getOutputSource),
 			StaticMethod("setOutputSource", &osn::Global::setOutputSource),
 			StaticMethod("getOutputFlagsFromId", &osn::Global::getOutputFlagsFromId),
+			StaticMethod("getTypeCatalog", &osn::Global::getTypeCatalog),
 
 			StaticAccessor("laggedFrames", &osn::Global::laggedFrames, nullptr),
 			StaticAccessor("totalFrames", &osn::Global::totalFrames, nullptr),
@@ -67,7 +70,7 @@ Napi::Value osn::Global::getOutputSource(const Napi::CallbackInfo& info)
 		return info.Env().Undefined();
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Global", "GetOutputSource", {ipc::value(channel)});
+	    ipc_registry::call_synchronous(conn, ipc_registry::Global::GetOutputSource, channel);
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -109,7 +112,8 @@ Napi::Value osn::Global::setOutputSource(const Napi::CallbackInfo& info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	conn->call("Global", "SetOutputSource", {ipc::value(channel), ipc::value(input ? input->sourceId : UINT64_MAX)});
+	ipc_registry::call(
+	    conn, ipc_registry::Global::SetOutputSource, channel, uint64_t(input ? input->sourceId : UINT64_MAX));
 
 	return info.Env().Undefined();
 }
@@ -118,12 +122,21 @@ Napi::Value osn::Global::getOutputFlagsFromId(const Napi::CallbackInfo& info)
 {
 	std::string id = info[0].ToString().Utf8Value();
 
+	// A failed fetch already raised a JS exception.
+	if (!osn::TypeCatalog::Get(info))
+		return info.Env().Undefined();
+
+	const osn::TypeInfo* typeInfo = osn::TypeCatalog::Find(info, id);
+	if (typeInfo)
+		return Napi::Number::New(info.Env(), typeInfo->outputFlags);
+
+	// Scenes and unknown ids are not part of the catalog.
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Global", "GetOutputFlagsFromId", {ipc::value(id)});
+	    ipc_registry::call_synchronous(conn, ipc_registry::Global::GetOutputFlagsFromId, id);
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -131,13 +144,36 @@ Napi::Value osn::Global::getOutputFlagsFromId(const Napi::CallbackInfo& info)
 	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
 }
 
+Napi::Value osn::Global::getTypeCatalog(const Napi::CallbackInfo& info)
+{
+	const std::vector<osn::TypeInfo>* catalog = osn::TypeCatalog::Get(info);
+	if (!catalog)
+		return info.Env().Undefined();
+
+	Napi::Array types = Napi::Array::New(info.Env(), catalog->size());
+
+	for (size_t idx = 0; idx < catalog->size(); idx++) {
+		const osn::TypeInfo& ti   = catalog->at(idx);
+		Napi::Object         type = Napi::Object::New(info.Env());
+
+		type.Set("id", Napi::String::New(info.Env(), ti.id));
+		type.Set("type", Napi::Number::New(info.Env(), ti.type));
+		type.Set("name", Napi::String::New(info.Env(), ti.displayName));
+		type.Set("outputFlags", Napi::Number::New(info.Env(), ti.outputFlags));
+		type.Set("configurable", Napi::Boolean::New(info.Env(), ti.capabilities & osn::TypeCatalog::CAP_CONFIGURABLE));
+		types.Set(idx, type);
+	}
+
+	return types;
+}
+
 Napi::Value osn::Global::laggedFrames(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "LaggedFrames", {});
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(conn, ipc_registry::Global::LaggedFrames);
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -151,7 +187,7 @@ Napi::Value osn::Global::totalFrames(const Napi::CallbackInfo& info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "TotalFrames", {});
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(conn, ipc_registry::Global::TotalFrames);
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -165,7 +201,7 @@ Napi::Value osn::Global::getLocale(const Napi::CallbackInfo& info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "GetLocale", {});
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(conn, ipc_registry::Global::GetLocale);
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -179,7 +215,7 @@ void osn::Global::setLocale(const Napi::CallbackInfo& info, const Napi::Value &v
 	if (!conn)
 		return;
 
-	conn->call("Global", "SetLocale", {ipc::value(value.ToString().Utf8Value())});
+	ipc_registry::call(conn, ipc_registry::Global::SetLocale, value.ToString().Utf8Value());
 }
 
 Napi::Value osn::Global::getMultipleRendering(const Napi::CallbackInfo& info)
@@ -188,7 +224,7 @@ Napi::Value osn::Global::getMultipleRendering(const Napi::CallbackInfo& info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "GetMultipleRendering", {});
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(conn, ipc_registry::Global::GetMultipleRendering);
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -202,5 +238,5 @@ void osn::Global::setMultipleRendering(const Napi::CallbackInfo& info, const Nap
 	if (!conn)
 		return;
 
-	conn->call("Global", "SetMultipleRendering", {ipc::value(value.ToBoolean().Value())});
+	ipc_registry::call(conn, ipc_registry::Global::SetMultipleRendering, int32_t(value.ToBoolean().Value()));
 }
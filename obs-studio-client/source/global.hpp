@@ -31,6 +31,7 @@ namespace osn
 		static Napi::Value getOutputSource(const Napi::CallbackInfo& info);
 		static Napi::Value setOutputSource(const Napi::CallbackInfo& info);
 		static Napi::Value getOutputFlagsFromId(const Napi::CallbackInfo& info);
+		static Napi::Value getTypeCatalog(const Napi::CallbackInfo& info);
 		static Napi::Value laggedFrames(const Napi::CallbackInfo& info);
 		static Napi::Value totalFrames(const Napi::CallbackInfo& info);
 		static Napi::Value getLocale(const Napi::CallbackInfo& info);
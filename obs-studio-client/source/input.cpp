@@ -22,15 +22,24 @@
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "filter.hpp"
+#include "ipc-registry.hpp"
 #include "ipc-value.hpp"
+#include "settings-store.hpp"
 #include "shared.hpp"
+#include "type-catalog.hpp"
 #include "utility.hpp"
 
 Napi::FunctionReference osn::Input::constructor;
 
+// Settings blobs the server is believed to hold, only the keys matter.
+static settings_store::Lru<bool> serverBlobs;
+// Settings returned by earlier creates, keyed by input type and settings blob.
+static settings_store::Lru<settings_store::blob_t> createResults;
+
 Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 	Napi::HandleScope scope(env);
 	Napi::Function func =
@@ -54,6 +63,8 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 			InstanceAccessor("showing", &osn::Input::Showing, nullptr),
 			InstanceAccessor("width", &osn::Input::Width, nullptr),
 			InstanceAccessor("height", &osn::Input::Height, nullptr),
+			InstanceMethod("getWidthAsync", &osn::Input::WidthAsync),
+			InstanceMethod("getHeightAsync", &osn::Input::HeightAsync),
 			InstanceAccessor("volume", &osn::Input::GetVolume, &osn::Input::SetVolume),
 			InstanceAccessor("syncOffset", &osn::Input::GetSyncOffset, &osn::Input::SetSyncOffset),
 			InstanceAccessor("audioMixers", &osn::Input::GetAudioMixers, &osn::Input::SetAudioMixers),
@@ -66,6 +77,8 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 			InstanceAccessor("configurable", &osn::Input::CallIsConfigurable, nullptr),
 			InstanceAccessor("properties", &osn::Input::CallGetProperties, nullptr),
 			InstanceAccessor("settings", &osn::Input::CallGetSettings, nullptr),
+			InstanceMethod("getPropertiesAsync", &osn::Input::CallGetPropertiesAsync),
+			InstanceMethod("getSettingsAsync", &osn::Input::CallGetSettingsAsync),
 			InstanceAccessor("type", &osn::Input::CallGetType, nullptr),
 			InstanceAccessor("name", &osn::Input::CallGetName, &osn::Input::CallSetName),
 			InstanceAccessor("outputFlags", &osn::Input::CallGetOutputFlags, nullptr),
@@ -113,22 +126,7 @@ osn::Input::Input(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Input::Types(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Types", {});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	std::vector<std::string> types;
-
-	for (size_t i = 1; i < response.size(); i++) {
-		types.push_back(response[i].value_str);
-	}
-
-	return utilv8::ToValue<std::string>(info, types);
+	return osn::TypeCatalog::Types(info, osn::TypeCatalog::TYPE_INPUT);
 }
 
 Napi::Value osn::Input::Create(const Napi::CallbackInfo& info)
@@ -159,31 +157,64 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo& info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	auto params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
-	if (settings.Utf8Value().length() != 0) {
-		std::string value;
-		if (utilv8::FromValue(settings, value)) {
-			params.push_back(ipc::value(value));
-		}
+	std::string settingsJson = settings.Utf8Value();
+	std::string hotkeysJson  = hotkeys.Utf8Value();
+	uint64_t    settingsId   = settingsJson.size() != 0 ? settings_store::hash(settingsJson) : 0;
+
+	// Settings the same type and blob produced last time, the server leaves
+	// them out of the response when they did not change.
+	uint64_t               resultKey = settings_store::hash(settingsJson, settings_store::hash(type));
+	settings_store::blob_t known;
+	uint64_t               knownId = 0;
+	if (createResults.find(resultKey, known))
+		knownId = settings_store::hash(*known);
+
+	bool held      = false;
+	bool reference = settingsId != 0 && serverBlobs.find(settingsId, held);
+
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(
+	    conn,
+	    ipc_registry::Input::CreateInterned,
+	    type,
+	    name,
+	    settingsId,
+	    uint64_t(settingsJson.size()),
+	    reference ? std::string() : settingsJson,
+	    knownId,
+	    hotkeysJson);
+
+	// The server dropped the blob in the meantime, send it in full.
+	if (reference && response.size() > 1 && (ErrorCode)response[0].value_union.ui64 == ErrorCode::NotFound) {
+		serverBlobs.erase(settingsId);
+		response = ipc_registry::call_synchronous(
+		    conn,
+		    ipc_registry::Input::CreateInterned,
+		    type,
+		    name,
+		    settingsId,
+		    uint64_t(settingsJson.size()),
+		    settingsJson,
+		    knownId,
+		    hotkeysJson);
 	}
-	if (hotkeys.Utf8Value().length() != 0) {
-		std::string value;
-		if (utilv8::FromValue(hotkeys, value)) {
-			params.push_back(ipc::value(value));
-		}
-	}
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Create", {std::move(params)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
+	if (settingsId != 0)
+		serverBlobs.insert(settingsId, true);
+
+	settings_store::blob_t result = known;
+	if (!known || response[2].value_union.ui64 != knownId)
+		result = SettingsPool().intern(response[3].value_str);
+	createResults.insert(resultKey, result);
+
 	SourceDataInfo* sdi = new SourceDataInfo;
 	sdi->name           = name;
 	sdi->obs_sourceId   = type;
 	sdi->id             = response[1].value_union.ui64;
-	sdi->setting        = response[2].value_str;
-	sdi->audioMixers    = response[3].value_union.ui32;
+	sdi->setting        = result;
+	sdi->audioMixers    = response[4].value_union.ui32;
 
 	CacheManager<SourceDataInfo*>::getInstance().Store(response[1].value_union.ui64, name, sdi);
 
@@ -230,7 +261,7 @@ Napi::Value osn::Input::CreatePrivate(const Napi::CallbackInfo& info)
 	sdi->name           = name;
 	sdi->obs_sourceId   = type;
 	sdi->id             = response[1].value_union.ui64;
-	sdi->setting        = response[2].value_str;
+	sdi->setting        = SettingsPool().intern(response[2].value_str);
 	sdi->audioMixers    = response[3].value_union.ui32;
 
 	CacheManager<SourceDataInfo*>::getInstance().Store(response[1].value_union.ui64, name, sdi);
@@ -392,6 +423,21 @@ Napi::Value osn::Input::Height(const Napi::CallbackInfo& info)
 	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
 }
 
+static Napi::Value ProcessDimension(Napi::Env env, const std::vector<ipc::value>& response)
+{
+	return Napi::Number::New(env, response[1].value_union.ui32);
+}
+
+Napi::Value osn::Input::WidthAsync(const Napi::CallbackInfo& info)
+{
+	return asyncCall::Call(info, "Input", "GetWidth", {ipc::value((uint64_t)this->sourceId)}, ProcessDimension);
+}
+
+Napi::Value osn::Input::HeightAsync(const Napi::CallbackInfo& info)
+{
+	return asyncCall::Call(info, "Input", "GetHeight", {ipc::value((uint64_t)this->sourceId)}, ProcessDimension);
+}
+
 Napi::Value osn::Input::GetVolume(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
@@ -722,6 +768,16 @@ Napi::Value osn::Input::CallGetSettings(const Napi::CallbackInfo& info)
 	return osn::ISource::GetSettings(info, this->sourceId);
 }
 
+Napi::Value osn::Input::CallGetPropertiesAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
+Napi::Value osn::Input::CallGetSettingsAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetSettingsAsync(info, this->sourceId);
+}
+
 
 Napi::Value osn::Input::CallGetType(const Napi::CallbackInfo& info)
 {
@@ -50,6 +50,8 @@ namespace osn
 		Napi::Value Showing(const Napi::CallbackInfo& info);
 		Napi::Value Width(const Napi::CallbackInfo& info);
 		Napi::Value Height(const Napi::CallbackInfo& info);
+		Napi::Value WidthAsync(const Napi::CallbackInfo& info);
+		Napi::Value HeightAsync(const Napi::CallbackInfo& info);
 		Napi::Value GetVolume(const Napi::CallbackInfo& info);
 		void SetVolume(const Napi::CallbackInfo& info, const Napi::Value &value);
 		Napi::Value GetSyncOffset(const Napi::CallbackInfo& info);
@@ -67,6 +69,8 @@ namespace osn
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
 		Napi::Value CallGetProperties(const Napi::CallbackInfo& info);
 		Napi::Value CallGetSettings(const Napi::CallbackInfo& info);
+		Napi::Value CallGetPropertiesAsync(const Napi::CallbackInfo& info);
+		Napi::Value CallGetSettingsAsync(const Napi::CallbackInfo& info);
 
 		Napi::Value CallGetType(const Napi::CallbackInfo& info);
 		Napi::Value CallGetName(const Napi::CallbackInfo& info);
@@ -19,6 +19,7 @@
 #include "isource.hpp"
 #include <error.hpp>
 #include <functional>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
@@ -64,40 +65,26 @@ Napi::Value osn::ISource::IsConfigurable(const Napi::CallbackInfo& info, uint64_
 	return Napi::Boolean::New(info.Env(), (bool)response[1].value_union.i32);
 }
 
-Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t id)
+static Napi::Value WrapProperties(Napi::Env env, uint64_t id, const osn::property_map_t& pmap)
 {
-	osn::ISource* source =
-		Napi::ObjectWrap<osn::ISource>::Unwrap(info.This().ToObject());
-	if (!source)
-		return info.Env().Undefined();
+	std::shared_ptr<osn::property_map_t> pSomeObject = std::make_shared<osn::property_map_t>(pmap);
+	auto prop_ptr = Napi::External<osn::property_map_t>::New(env, pSomeObject.get());
+	auto instance =
+		osn::Properties::constructor.New({
+			prop_ptr,
+			Napi::Number::New(env, (uint32_t)id)
+			});
+	return instance;
+}
+
+static Napi::Value ProcessProperties(Napi::Env env, uint64_t id, const std::vector<ipc::value>& response)
+{
+	if (response.size() == 1)
+		return env.Null();
 
 	SourceDataInfo* sdi =
 		CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
 
-	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0) {
-		std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(sdi->properties);
-		auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-		auto instance =
-			osn::Properties::constructor.New({
-				prop_ptr,
-				Napi::Number::New(info.Env(), (uint32_t)id)
-				});
-		return instance;
-	}
-
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	if (response.size() == 1)
-		return info.Env().Null();
-
 	osn::property_map_t pmap;
 	for (size_t idx = 1; idx < response.size(); ++idx) {
 		auto raw_property = obs::Property::deserialize(response[idx].value_bin);
@@ -281,34 +268,84 @@ Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t
 		sdi->properties        = pmap;
 		sdi->propertiesChanged = false;
 	}
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-	auto instance =
-		osn::Properties::constructor.New({
-			prop_ptr,
-			Napi::Number::New(info.Env(), (uint32_t)id)
-			});
-	return instance;
+	return WrapProperties(env, id, pmap);
 }
 
-Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo& info, uint64_t id)
+Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t id)
 {
 	osn::ISource* source =
 		Napi::ObjectWrap<osn::ISource>::Unwrap(info.This().ToObject());
 	if (!source)
 		return info.Env().Undefined();
 
-	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
+	SourceDataInfo* sdi =
+		CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
+
+	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0)
+		return WrapProperties(info.Env(), id, sdi->properties);
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return ProcessProperties(info.Env(), id, response);
+}
+
+Napi::Value osn::ISource::GetPropertiesAsync(const Napi::CallbackInfo& info, uint64_t id)
+{
+	SourceDataInfo* sdi =
+		CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
+
+	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0)
+		return asyncCall::Resolved(info.Env(), WrapProperties(info.Env(), id, sdi->properties));
+
+	return asyncCall::Call(
+	    info,
+	    "Source",
+	    "GetProperties",
+	    {ipc::value(id)},
+	    [id](Napi::Env env, const std::vector<ipc::value>& response) {
+		    return ProcessProperties(env, id, response);
+	    });
+}
+
+static Napi::Value ParseSettings(Napi::Env env, const std::string& jsondata)
+{
+	Napi::Object json = env.Global().Get("JSON").As<Napi::Object>();
 	Napi::Function parse = json.Get("parse").As<Napi::Function>();
+	return parse.Call(json, {Napi::String::New(env, jsondata)});
+}
 
+static Napi::Value ProcessSettings(Napi::Env env, uint64_t id, const std::vector<ipc::value>& response)
+{
 	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
 
-	if (sdi && !sdi->settingsChanged && sdi->setting.size() > 0) {
-		Napi::String jsondata = Napi::String::New(info.Env(), sdi->setting);
-		Napi::Object jsonObj = parse.Call(json, {jsondata}).As<Napi::Object>();
-		return jsonObj;
+	if (sdi) {
+		sdi->setting         = SettingsPool().intern(response[1].value_str);
+		sdi->settingsChanged = false;
 	}
 
+	return ParseSettings(env, response[1].value_str);
+}
+
+Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo& info, uint64_t id)
+{
+	osn::ISource* source =
+		Napi::ObjectWrap<osn::ISource>::Unwrap(info.This().ToObject());
+	if (!source)
+		return info.Env().Undefined();
+
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
+
+	if (sdi && !sdi->settingsChanged && sdi->setting && sdi->setting->size() > 0)
+		return ParseSettings(info.Env(), *sdi->setting);
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -319,15 +356,24 @@ Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo& info, uint64_t i
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	Napi::String jsondata = Napi::String::New(info.Env(), response[1].value_str);
-	Napi::Object jsonObj = parse.Call(json, {jsondata}).As<Napi::Object>();
+	return ProcessSettings(info.Env(), id, response);
+}
 
-	if (sdi) {
-		sdi->setting         = response[1].value_str;
-		sdi->settingsChanged = false;
-	}
+Napi::Value osn::ISource::GetSettingsAsync(const Napi::CallbackInfo& info, uint64_t id)
+{
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
 
-	return jsonObj;
+	if (sdi && !sdi->settingsChanged && sdi->setting && sdi->setting->size() > 0)
+		return asyncCall::Resolved(info.Env(), ParseSettings(info.Env(), *sdi->setting));
+
+	return asyncCall::Call(
+	    info,
+	    "Source",
+	    "GetSettings",
+	    {ipc::value(id)},
+	    [id](Napi::Env env, const std::vector<ipc::value>& response) {
+		    return ProcessSettings(env, id, response);
+	    });
 }
 
 void osn::ISource::Update(const Napi::CallbackInfo& info, uint64_t id)
@@ -342,9 +388,9 @@ void osn::ISource::Update(const Napi::CallbackInfo& info, uint64_t id)
 
 	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
 
-	if (sdi && sdi->setting.size() > 0) {
+	if (sdi && sdi->setting && sdi->setting->size() > 0) {
 		auto newSettings = nlohmann::json::parse(jsondata);
-		auto settings    = nlohmann::json::parse(sdi->setting);
+		auto settings    = nlohmann::json::parse(*sdi->setting);
 
 		nlohmann::json::iterator it = newSettings.begin();
 		while (!shouldUpdate && it != newSettings.end()) {
@@ -372,7 +418,7 @@ void osn::ISource::Update(const Napi::CallbackInfo& info, uint64_t id)
 			return;
 
 		if (sdi) {
-			sdi->setting           = response[1].value_str;
+			sdi->setting           = SettingsPool().intern(response[1].value_str);
 			sdi->settingsChanged   = false;
 			sdi->propertiesChanged = true;
 		}
@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <string>
+#include "collection.hpp"
 #include "controller.hpp"
 #include "fader.hpp"
 #include "filter.hpp"
@@ -98,6 +99,7 @@ Napi::Object main_node(Napi::Env env, Napi::Object exports) {
 	osn::PropertyObject::Init(env, exports);
 	osn::Filter::Init(env, exports);
 	osn::Global::Init(env, exports);
+	osn::Collection::Init(env, exports);
 	osn::Scene::Init(env, exports);
 	osn::SceneItem::Init(env, exports);
 	osn::Transition::Init(env, exports);
@@ -17,17 +17,97 @@
 ******************************************************************************/
 
 #include <condition_variable>
+#include <map>
 #include <mutex>
 #include <string>
 #include "controller.hpp"
 #include "error.hpp"
 #include "ipc-value.hpp"
 #include "shared.hpp"
+#include "type-catalog.hpp"
 #include "utility.hpp"
 #include "module.hpp"
 
 Napi::FunctionReference osn::Module::constructor;
 
+struct ModuleDescriptor
+{
+	std::string fileName;
+	std::string name;
+	std::string author;
+	std::string description;
+	std::string binaryPath;
+	std::string dataPath;
+};
+
+// Filled by a single Module.DescribeAll call the first time a module is inspected,
+// dropped whenever a module is opened or initialized.
+static std::map<uint64_t, ModuleDescriptor> descriptors;
+static bool                                 descriptorsValid = false;
+
+static bool FetchDescriptors(const Napi::CallbackInfo& info, std::vector<uint64_t>* ids = nullptr)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return false;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Module", "DescribeAll", {});
+
+	if (!ValidateResponse(info, response))
+		return false;
+
+	descriptors.clear();
+
+	uint32_t count = response[1].value_union.ui32;
+	for (size_t idx = 2; count > 0 && idx + 6 < response.size(); idx += 7, count--) {
+		ModuleDescriptor md;
+		md.fileName    = response[idx + 1].value_str;
+		md.name        = response[idx + 2].value_str;
+		md.author      = response[idx + 3].value_str;
+		md.description = response[idx + 4].value_str;
+		md.binaryPath  = response[idx + 5].value_str;
+		md.dataPath    = response[idx + 6].value_str;
+
+		if (ids)
+			ids->push_back(response[idx].value_union.ui64);
+		descriptors.insert_or_assign(response[idx].value_union.ui64, std::move(md));
+	}
+	descriptorsValid = true;
+
+	return true;
+}
+
+void osn::Module::InvalidateDescriptors()
+{
+	descriptors.clear();
+	descriptorsValid = false;
+}
+
+Napi::Value osn::Module::DescriptorField(
+    const Napi::CallbackInfo& info,
+    std::string ModuleDescriptor::*field,
+    const char*                    fname)
+{
+	if (!descriptorsValid && !FetchDescriptors(info))
+		return info.Env().Undefined();
+
+	auto it = descriptors.find(this->moduleId);
+	if (it != descriptors.end())
+		return Napi::String::New(info.Env(), it->second.*field);
+
+	// Not a loaded module, let the server report why.
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Module", fname, {ipc::value(this->moduleId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::String::New(info.Env(), response[1].value_str);
+}
+
 Napi::Object osn::Module::Init(Napi::Env env, Napi::Object exports) {
 	Napi::HandleScope scope(env);
 	Napi::Function func =
@@ -36,6 +116,7 @@ Napi::Object osn::Module::Init(Napi::Env env, Napi::Object exports) {
 		{
 			StaticMethod("open", &osn::Module::Open),
 			StaticMethod("modules", &osn::Module::Modules),
+			StaticMethod("describeAll", &osn::Module::DescribeAll),
 
 			InstanceMethod("initialize", &osn::Module::Initialize),
 
@@ -82,6 +163,9 @@ Napi::Value osn::Module::Open(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
+	osn::TypeCatalog::Invalidate();
+	osn::Module::InvalidateDescriptors();
+
     auto instance =
         osn::Module::constructor.New({
             Napi::Number::New(info.Env(), response[1].value_union.ui64)
@@ -111,107 +195,64 @@ Napi::Value osn::Module::Modules(const Napi::CallbackInfo& info)
 	return modules;
 }
 
-Napi::Value osn::Module::Initialize(const Napi::CallbackInfo& info)
+Napi::Value osn::Module::DescribeAll(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
+	std::vector<uint64_t> ids;
+	if (!FetchDescriptors(info, &ids))
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "Initialize", {ipc::value(this->moduleId)});
+	Napi::Array modules = Napi::Array::New(info.Env(), ids.size());
 
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
+	for (size_t i = 0; i < ids.size(); i++)
+		modules.Set(i, osn::Module::constructor.New({Napi::Number::New(info.Env(), ids[i])}));
 
-	return Napi::Boolean::New(info.Env(), response[1].value_union.i32);
+	return modules;
 }
 
-Napi::Value osn::Module::Name(const Napi::CallbackInfo& info)
+Napi::Value osn::Module::Initialize(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetName", {ipc::value(this->moduleId)});
+	    conn->call_synchronous_helper("Module", "Initialize", {ipc::value(this->moduleId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	return Napi::String::New(info.Env(), response[1].value_str);
+	osn::TypeCatalog::Invalidate();
+	osn::Module::InvalidateDescriptors();
+
+	return Napi::Boolean::New(info.Env(), response[1].value_union.i32);
 }
 
-Napi::Value osn::Module::FileName(const Napi::CallbackInfo& info)
+Napi::Value osn::Module::Name(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetFileName", {ipc::value(this->moduleId)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
+	return DescriptorField(info, &ModuleDescriptor::name, "GetName");
+}
 
-	return Napi::String::New(info.Env(), response[1].value_str);
+Napi::Value osn::Module::FileName(const Napi::CallbackInfo& info)
+{
+	return DescriptorField(info, &ModuleDescriptor::fileName, "GetFileName");
 }
 
 Napi::Value osn::Module::Description(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetDescription", {ipc::value(this->moduleId)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	return Napi::String::New(info.Env(), response[1].value_str);
+	return DescriptorField(info, &ModuleDescriptor::description, "GetDescription");
 }
 
 Napi::Value osn::Module::Author(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetAuthor", {ipc::value(this->moduleId)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	return Napi::String::New(info.Env(), response[1].value_str);
+	return DescriptorField(info, &ModuleDescriptor::author, "GetAuthor");
 }
 
 Napi::Value osn::Module::BinaryPath(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetBinaryPath", {ipc::value(this->moduleId)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	return Napi::String::New(info.Env(), response[1].value_str);
+	return DescriptorField(info, &ModuleDescriptor::binaryPath, "GetBinaryPath");
 }
 
 Napi::Value osn::Module::DataPath(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetDataPath", {ipc::value(this->moduleId)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	return Napi::String::New(info.Env(), response[1].value_str);
-}
\ No newline at end of file
+	return DescriptorField(info, &ModuleDescriptor::dataPath, "GetDataPath");
+}
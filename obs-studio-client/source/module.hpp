@@ -20,6 +20,8 @@
 #include <napi.h>
 #include "utility-v8.hpp"
 
+struct ModuleDescriptor;
+
 namespace osn
 {
 	class Module : public Napi::ObjectWrap<osn::Module>
@@ -34,6 +36,8 @@ namespace osn
 
 		static Napi::Value Open(const Napi::CallbackInfo& info);
 		static Napi::Value Modules(const Napi::CallbackInfo& info);
+		static Napi::Value DescribeAll(const Napi::CallbackInfo& info);
+		static void        InvalidateDescriptors();
 
 		Napi::Value Initialize(const Napi::CallbackInfo& info);
 
@@ -43,5 +47,11 @@ namespace osn
 		Napi::Value Description(const Napi::CallbackInfo& info);
 		Napi::Value BinaryPath(const Napi::CallbackInfo& info);
 		Napi::Value DataPath(const Napi::CallbackInfo& info);
+
+		private:
+		Napi::Value DescriptorField(
+		    const Napi::CallbackInfo& info,
+		    std::string ModuleDescriptor::*field,
+		    const char*                    fname);
 	};
 }
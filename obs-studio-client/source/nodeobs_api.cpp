@@ -19,9 +19,12 @@
 #include "controller.hpp"
 #include "error.hpp"
 #include "nodeobs_api.hpp"
+#include <map>
 #include <sstream>
 #include <string>
 #include "shared.hpp"
+#include "module.hpp"
+#include "type-catalog.hpp"
 #include "utility.hpp"
 #include "volmeter.hpp"
 #include "callback-manager.hpp"
@@ -30,6 +33,9 @@
 
 Napi::ThreadSafeFunction js_thread;
 
+// Chrome trace-event JSON of the last OBS_API_initAPI call, as sent by the server.
+static std::string startupTrace;
+
 Napi::Value api::OBS_API_initAPI(const Napi::CallbackInfo& info)
 {
 	std::string path;
@@ -46,6 +52,10 @@ Napi::Value api::OBS_API_initAPI(const Napi::CallbackInfo& info)
 
 	conn->set_freez_callback(ipc_freez_callback, path);
 
+	// All plugins are loaded by the server during init.
+	osn::TypeCatalog::Invalidate();
+	osn::Module::InvalidateDescriptors();
+
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "API", "OBS_API_initAPI", {ipc::value(path), ipc::value(language), ipc::value(version)});
 
@@ -60,9 +70,20 @@ Napi::Value api::OBS_API_initAPI(const Napi::CallbackInfo& info)
 		}
 	}
 
+	startupTrace = response.size() > 2 ? response[2].value_str : "";
+
 	return Napi::Number::New(info.Env(), response[1].value_union.i32);
 }
 
+Napi::Value api::OBS_API_getStartupTrace(const Napi::CallbackInfo& info)
+{
+	if (startupTrace.empty())
+		return info.Env().Undefined();
+
+	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
+	return json.Get("parse").As<Napi::Function>().Call(json, {Napi::String::New(info.Env(), startupTrace)});
+}
+
 Napi::Value api::OBS_API_destroyOBS_API(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
@@ -70,6 +91,8 @@ Napi::Value api::OBS_API_destroyOBS_API(const Napi::CallbackInfo& info)
 		return info.Env().Undefined();
 
 	conn->call("API", "OBS_API_destroyOBS_API", {});
+	osn::TypeCatalog::Invalidate();
+	osn::Module::InvalidateDescriptors();
 
 #ifdef __APPLE__
 	if (js_thread)
@@ -136,6 +159,15 @@ Napi::Value api::OBS_API_getPerformanceStatistics(const Napi::CallbackInfo& info
 		Napi::String::New(info.Env(), "diskSpaceAvailable"),
 		Napi::String::New(info.Env(),diskSpaceAvailable));
 
+	if (response.size() >= 14) {
+		statistics.Set(
+			Napi::String::New(info.Env(), "recordingStartLatency"),
+			Napi::Number::New(info.Env(), response[12].value_union.fp64));
+		statistics.Set(
+			Napi::String::New(info.Env(), "recordingStartArmed"),
+			Napi::Boolean::New(info.Env(), response[13].value_union.ui32 != 0));
+	}
+
 	return statistics;
 }
 
@@ -167,50 +199,80 @@ Napi::Value api::InitShutdownSequence(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+struct HotkeyInfo
+{
+	std::string objectName;
+	uint32_t    objectType;
+	std::string hotkeyName;
+	std::string hotkeyDesc;
+	uint64_t    hotkeyId;
+};
+
+// Mirror of the server hotkey index, only the changes since hotkeyGeneration are transferred.
+static std::map<uint64_t, HotkeyInfo> hotkeyCache;
+static uint64_t                       hotkeyGeneration = 0;
+
 Napi::Value api::OBS_API_QueryHotkeys(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_QueryHotkeys", {});
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("API", "OBS_API_QueryHotkeysDelta", {ipc::value(hotkeyGeneration)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
+	bool   full    = response[2].value_union.ui32 != 0;
+	size_t changed = response[3].value_union.ui32;
+	if (full)
+		hotkeyCache.clear();
+
+	size_t responseIndex = 4;
+	for (size_t i = 0; i < changed; i++, responseIndex += 5) {
+		HotkeyInfo hotkey;
+		hotkey.objectName = response[responseIndex + 0].value_str;
+		hotkey.objectType = response[responseIndex + 1].value_union.ui32;
+		hotkey.hotkeyName = response[responseIndex + 2].value_str;
+		hotkey.hotkeyDesc = response[responseIndex + 3].value_str;
+		hotkey.hotkeyId   = response[responseIndex + 4].value_union.ui64;
+		hotkeyCache[hotkey.hotkeyId] = std::move(hotkey);
+	}
+	for (; responseIndex < response.size(); responseIndex++)
+		hotkeyCache.erase(response[responseIndex].value_union.ui64);
+
+	hotkeyGeneration = response[1].value_union.ui64;
+
 	Napi::Array hotkeyInfos = Napi::Array::New(info.Env());
 
 	// For each hotkey info that we need to fill
-	for (int i = 0; i < (response.size() - 1) / 5; i++) {
-		int                   responseIndex = i * 5 + 1;
-		Napi::Object object     = Napi::Object::New(info.Env());
-		std::string  objectName = response[responseIndex + 0].value_str;
-		uint32_t     objectType = response[responseIndex + 1].value_union.ui32;
-		std::string  hotkeyName = response[responseIndex + 2].value_str;
-		std::string  hotkeyDesc = response[responseIndex + 3].value_str;
-		uint64_t     hotkeyId   = response[responseIndex + 4].value_union.ui64;
+	uint32_t i = 0;
+	for (auto& kv : hotkeyCache) {
+		const HotkeyInfo& hotkey = kv.second;
+		Napi::Object      object = Napi::Object::New(info.Env());
 
 		object.Set(
 			Napi::String::New(info.Env(), "ObjectName"),
-			Napi::String::New(info.Env(), objectName));
+			Napi::String::New(info.Env(), hotkey.objectName));
 
 		object.Set(
 			Napi::String::New(info.Env(), "ObjectType"),
-			Napi::Number::New(info.Env(), objectType));
+			Napi::Number::New(info.Env(), hotkey.objectType));
 
 		object.Set(
 			Napi::String::New(info.Env(), "HotkeyName"),
-			Napi::String::New(info.Env(), hotkeyName));
+			Napi::String::New(info.Env(), hotkey.hotkeyName));
 
 		object.Set(
 			Napi::String::New(info.Env(), "HotkeyDesc"),
-			Napi::String::New(info.Env(), hotkeyDesc));
+			Napi::String::New(info.Env(), hotkey.hotkeyDesc));
 
 		object.Set(
 			Napi::String::New(info.Env(), "HotkeyId"),
-			Napi::Number::New(info.Env(), hotkeyId));
+			Napi::Number::New(info.Env(), hotkey.hotkeyId));
 
-		hotkeyInfos.Set(i, object);
+		hotkeyInfos.Set(i++, object);
 	}
 
 	return hotkeyInfos;
@@ -311,6 +373,7 @@ Napi::Value api::RequestPermissions(const Napi::CallbackInfo& info)
 void api::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(Napi::String::New(env, "OBS_API_initAPI"), Napi::Function::New(env, api::OBS_API_initAPI));
+	exports.Set(Napi::String::New(env, "OBS_API_getStartupTrace"), Napi::Function::New(env, api::OBS_API_getStartupTrace));
 	exports.Set(Napi::String::New(env, "OBS_API_destroyOBS_API"), Napi::Function::New(env, api::OBS_API_destroyOBS_API));
 	exports.Set(Napi::String::New(env, "OBS_API_getPerformanceStatistics"), Napi::Function::New(env, api::OBS_API_getPerformanceStatistics));
 	exports.Set(Napi::String::New(env, "SetWorkingDirectory"), Napi::Function::New(env, api::SetWorkingDirectory));
@@ -32,6 +32,7 @@ namespace api
     void Init(Napi::Env env, Napi::Object exports);
 
 	Napi::Value OBS_API_initAPI(const Napi::CallbackInfo& info);
+	Napi::Value OBS_API_getStartupTrace(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_destroyOBS_API(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_getPerformanceStatistics(const Napi::CallbackInfo& info);
 	Napi::Value SetWorkingDirectory(const Napi::CallbackInfo& info);
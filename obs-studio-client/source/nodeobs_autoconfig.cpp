@@ -17,22 +17,46 @@
 ******************************************************************************/
 
 #include "nodeobs_autoconfig.hpp"
+#include <condition_variable>
+#include <mutex>
 #include "shared.hpp"
 
 bool autoConfig::isWorkerRunning = false;
 bool autoConfig::worker_stop = true;
 uint32_t autoConfig::sleepIntervalMS = 33;
-autoConfig::Worker* autoConfig::asyncWorker = nullptr;
 std::thread* autoConfig::worker_thread = nullptr;
-std::vector<std::thread*> autoConfig::ac_queue_task_workers;
+Napi::ThreadSafeFunction autoConfig::js_thread;
 
-#ifdef WIN32
-const char* ac_sem_name = nullptr; // Not used on Windows
-HANDLE ac_sem;
-#else
-const char* ac_sem_name = "autoconfig-semaphore";
-sem_t *ac_sem;
-#endif
+static std::mutex              worker_mtx;
+static std::condition_variable worker_cv;
+
+// Runs on the JS thread, every progress record of a wizard run goes through here.
+static void dispatch(Napi::Env env, Napi::Function jsCallback, AutoConfigInfo* data)
+{
+	Napi::Object result = Napi::Object::New(env);
+
+	result.Set(
+		Napi::String::New(env, "event"),
+		Napi::String::New(env, data->event));
+	result.Set(
+		Napi::String::New(env, "description"),
+		Napi::String::New(env, data->description));
+
+	if (data->event.compare("error") != 0) {
+		result.Set(
+			Napi::String::New(env, "percentage"),
+			Napi::Number::New(env, data->percentage));
+	}
+
+	delete data;
+	jsCallback.Call({ result });
+}
+
+void autoConfig::post(AutoConfigInfo* data)
+{
+	if (worker_stop || js_thread.NonBlockingCall(data, dispatch) != napi_ok)
+		delete data;
+}
 
 void autoConfig::worker()
 {
@@ -49,18 +73,22 @@ void autoConfig::worker()
 
 		{
 			std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
+			if (response.size() < 2) {
 				goto do_sleep;
 			}
 
 			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<AutoConfigInfo> data = std::make_shared<AutoConfigInfo>();
+			if (error != ErrorCode::Ok)
+				goto do_sleep;
+
+			uint32_t count = response[1].value_union.ui32;
+			for (size_t idx = 2; count > 0 && idx + 2 < response.size(); idx += 3, count--) {
+				AutoConfigInfo* data = new AutoConfigInfo;
 
-				data->event       = response[1].value_str;
-				data->description = response[2].value_str;
-				data->percentage  = response[3].value_union.fp64;
-				ac_queue_task_workers.push_back(new std::thread(&autoConfig::queueTask, data));
+				data->event       = response[idx].value_str;
+				data->description = response[idx + 1].value_str;
+				data->percentage  = response[idx + 2].value_union.fp64;
+				js_thread.BlockingCall(data, dispatch);
 			}
 		}
 
@@ -68,18 +96,27 @@ void autoConfig::worker()
 		auto tp_end  = std::chrono::high_resolution_clock::now();
 		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
 		totalSleepMS = sleepIntervalMS - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
+
+		std::unique_lock<std::mutex> ulock(worker_mtx);
+		worker_cv.wait_for(ulock, std::chrono::milliseconds(totalSleepMS), []() { return worker_stop; });
 	}
 	return;
 }
 
-void autoConfig::start_worker()
+void autoConfig::start_worker(napi_env env, Napi::Function async_callback)
 {
 	if (!worker_stop)
 		return;
 
+	js_thread = Napi::ThreadSafeFunction::New(
+		env,
+		async_callback,
+		"AutoConfig",
+		0,
+		1,
+		[]( Napi::Env ) {} );
+
 	worker_stop = false;
-	ac_sem = create_semaphore(ac_sem_name);
 	worker_thread = new std::thread(&autoConfig::worker);
 }
 
@@ -88,16 +125,18 @@ void autoConfig::stop_worker()
 	if (worker_stop != false)
 		return;
 
-	worker_stop = true;
+	{
+		std::unique_lock<std::mutex> ulock(worker_mtx);
+		worker_stop = true;
+		worker_cv.notify_one();
+	}
 	if (worker_thread->joinable()) {
 		worker_thread->join();
 	}
-	for (auto queue_worker: ac_queue_task_workers) {
-		if (queue_worker->joinable()) {
-			queue_worker->join();
-		}
-	}
-	remove_semaphore(ac_sem, ac_sem_name);
+	delete worker_thread;
+	worker_thread = nullptr;
+
+	js_thread.Release();
 }
 
 Napi::Value autoConfig::InitializeAutoConfig(const Napi::CallbackInfo& info)
@@ -117,10 +156,7 @@ Napi::Value autoConfig::InitializeAutoConfig(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	asyncWorker = new autoConfig::Worker(async_callback);
-	asyncWorker->SuppressDestruct();
-
-	start_worker();
+	start_worker(info.Env(), async_callback);
 	isWorkerRunning = true;
 
 	return Napi::Boolean::New(info.Env(), true);
@@ -165,19 +201,13 @@ Napi::Value autoConfig::StartRecordingEncoderTest(const Napi::CallbackInfo& info
 	return info.Env().Undefined();
 }
 
-void autoConfig::queueTask(std::shared_ptr<AutoConfigInfo> data) {
-	wait_semaphore(ac_sem);
-	asyncWorker->SetData(data);
-	asyncWorker->Queue();
-}
-
 Napi::Value autoConfig::StartCheckSettings(const Napi::CallbackInfo& info)
 {
-	std::shared_ptr<AutoConfigInfo> startData = std::make_shared<AutoConfigInfo>();
-	startData->event                          = "starting_step";
-	startData->description                    = "checking_settings";
-	startData->percentage                     = 0;
-	ac_queue_task_workers.push_back(new std::thread(&autoConfig::queueTask, startData));
+	AutoConfigInfo* startData = new AutoConfigInfo;
+	startData->event          = "starting_step";
+	startData->description    = "checking_settings";
+	startData->percentage     = 0;
+	post(startData);
 
 	auto conn = GetConnection(info);
 	if (!conn)
@@ -188,8 +218,8 @@ Napi::Value autoConfig::StartCheckSettings(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	bool                            success  = (bool)response[1].value_union.ui32;
-	std::shared_ptr<AutoConfigInfo> stopData = std::make_shared<AutoConfigInfo>();
+	bool            success  = (bool)response[1].value_union.ui32;
+	AutoConfigInfo* stopData = new AutoConfigInfo;
 	if (!success) {
 		stopData->event       = "error";
 		stopData->description = "invalid_settings";
@@ -199,7 +229,7 @@ Napi::Value autoConfig::StartCheckSettings(const Napi::CallbackInfo& info)
 	}
 
 	stopData->percentage = 100;
-	ac_queue_task_workers.push_back(new std::thread(&autoConfig::queueTask, stopData));
+	post(stopData);
 
 	return info.Env().Undefined();
 }
@@ -256,7 +286,7 @@ Napi::Value autoConfig::TerminateAutoConfig(const Napi::CallbackInfo& info)
 
 	if (isWorkerRunning)
 		stop_worker();
-	delete asyncWorker;
+	isWorkerRunning = false;
 	return info.Env().Undefined();
 }
 
@@ -21,12 +21,18 @@
 #include "error.hpp"
 #include "utility-v8.hpp"
 
+#include <map>
 #include <node.h>
 #include <sstream>
 #include <string>
 #include "shared.hpp"
 #include "utility.hpp"
 #include "callback-manager.hpp"
+#include "frame-tap.hpp"
+
+// Mappings of the frame taps by key. Each one backs an external ArrayBuffer
+// whose finalizer unmaps it, so views handed out stay valid after destroy.
+static std::map<std::string, Napi::Reference<Napi::ArrayBuffer>*> frameTaps;
 
 #ifdef WIN32
 static BOOL CALLBACK EnumChromeWindowsProc(HWND hwnd, LPARAM lParam)
@@ -281,6 +287,194 @@ Napi::Value display::OBS_content_createIOSurface(const Napi::CallbackInfo& info)
 	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
 }
 
+Napi::Value display::OBS_content_setDisplayMaxFPS(const Napi::CallbackInfo& info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+	uint32_t    fps = info[1].ToNumber().Uint32Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayMaxFPS", {ipc::value(key), ipc::value(fps)});
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_setDisplayHidden(const Napi::CallbackInfo& info)
+{
+	std::string key    = info[0].ToString().Utf8Value();
+	int32_t     hidden = info[1].ToBoolean().Value() ? 1 : 0;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayHidden", {ipc::value(key), ipc::value(hidden)});
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_getDisplayRenderStats(const Napi::CallbackInfo& info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Display", "OBS_content_getDisplayRenderStats", {ipc::value(key)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object stats = Napi::Object::New(info.Env());
+	stats.Set("renderedFrames", Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	stats.Set("skippedFrames", Napi::Number::New(info.Env(), double(response[2].value_union.ui64)));
+	return stats;
+}
+
+Napi::Value display::OBS_content_createFrameTap(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 5 || !info[0].IsString() || !info[1].IsNumber() || !info[2].IsNumber() || !info[3].IsNumber()
+	    || !info[4].IsNumber()) {
+		Napi::TypeError::New(info.Env(), "String key, rendering mode, width, height and fps expected")
+		    .ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	std::string key    = info[0].ToString().Utf8Value();
+	int32_t     mode   = info[1].ToNumber().Int32Value();
+	uint32_t    width  = info[2].ToNumber().Uint32Value();
+	uint32_t    height = info[3].ToNumber().Uint32Value();
+	uint32_t    fps    = info[4].ToNumber().Uint32Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Display",
+	    "OBS_content_createFrameTap",
+	    {ipc::value(key), ipc::value(mode), ipc::value(width), ipc::value(height), ipc::value(fps)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	frametap::SharedMemory* memory = new frametap::SharedMemory();
+	const frametap::Header* header = nullptr;
+	if (memory->Open(response[1].value_str))
+		header = static_cast<const frametap::Header*>(memory->Data());
+
+	if (!header || memory->Size() < sizeof(frametap::Header) || header->magic != frametap::Magic
+	    || header->version != frametap::Version
+	    || memory->Size() < frametap::MappingSize(header->stride, header->height)) {
+		delete memory;
+		conn->call_synchronous_helper("Display", "OBS_content_destroyFrameTap", {ipc::value(key)});
+		Napi::Error::New(info.Env(), "Failed to map the frame tap shared memory.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(
+	    info.Env(),
+	    memory->Data(),
+	    memory->Size(),
+	    [](Napi::Env, void*, frametap::SharedMemory* memory) { delete memory; },
+	    memory);
+	frameTaps[key] = new Napi::Reference<Napi::ArrayBuffer>(Napi::Persistent(buffer));
+
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_destroyFrameTap(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 1 || !info[0].IsString()) {
+		Napi::TypeError::New(info.Env(), "String key expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	auto found = frameTaps.find(key);
+	if (found != frameTaps.end()) {
+		delete found->second;
+		frameTaps.erase(found);
+	}
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Display", "OBS_content_destroyFrameTap", {ipc::value(key)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_getFrameTapFrame(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 1 || !info[0].IsString()) {
+		Napi::TypeError::New(info.Env(), "String key expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto found = frameTaps.find(key);
+	if (found == frameTaps.end())
+		return info.Env().Undefined();
+
+	Napi::ArrayBuffer       buffer = found->second->Value();
+	const frametap::Header* header = static_cast<const frametap::Header*>(buffer.Data());
+
+	uint64_t sequence = header->latest.load(std::memory_order_acquire);
+	if (sequence == 0)
+		return info.Env().Undefined();
+
+	uint32_t              index = frametap::SlotIndex(sequence);
+	const frametap::Slot& slot  = header->slots[index];
+	if (slot.sequence.load(std::memory_order_acquire) != sequence)
+		return info.Env().Undefined();
+
+	Napi::Object frame = Napi::Object::New(info.Env());
+	frame.Set("sequence", Napi::Number::New(info.Env(), double(sequence)));
+	frame.Set("timestamp", Napi::Number::New(info.Env(), double(slot.timestamp)));
+	frame.Set("width", Napi::Number::New(info.Env(), header->width));
+	frame.Set("height", Napi::Number::New(info.Env(), header->height));
+	frame.Set("stride", Napi::Number::New(info.Env(), header->stride));
+	frame.Set(
+	    "data",
+	    Napi::Uint8Array::New(
+	        info.Env(),
+	        size_t(header->frameSize),
+	        buffer,
+	        frametap::FramesOffset + size_t(index) * size_t(header->frameSize)));
+	return frame;
+}
+
+Napi::Value display::OBS_content_isFrameTapFrameValid(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+		Napi::TypeError::New(info.Env(), "String key and frame sequence expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	std::string key      = info[0].ToString().Utf8Value();
+	uint64_t    sequence = uint64_t(info[1].ToNumber().DoubleValue());
+
+	auto found = frameTaps.find(key);
+	if (found == frameTaps.end() || sequence == 0)
+		return Napi::Boolean::New(info.Env(), false);
+
+	// The server rewrites a slot SlotCount frames later, so a frame read from
+	// the view is intact as long as its slot still carries its sequence.
+	const frametap::Header* header = static_cast<const frametap::Header*>(found->second->Value().Data());
+	const frametap::Slot&   slot   = header->slots[frametap::SlotIndex(sequence)];
+	return Napi::Boolean::New(info.Env(), slot.sequence.load(std::memory_order_acquire) == sequence);
+}
+
 void display::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(
@@ -319,4 +513,25 @@ void display::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(
 		Napi::String::New(env, "OBS_content_createIOSurface"),
 		Napi::Function::New(env, display::OBS_content_createIOSurface));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_setDisplayMaxFPS"),
+		Napi::Function::New(env, display::OBS_content_setDisplayMaxFPS));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_setDisplayHidden"),
+		Napi::Function::New(env, display::OBS_content_setDisplayHidden));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_getDisplayRenderStats"),
+		Napi::Function::New(env, display::OBS_content_getDisplayRenderStats));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_createFrameTap"),
+		Napi::Function::New(env, display::OBS_content_createFrameTap));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_destroyFrameTap"),
+		Napi::Function::New(env, display::OBS_content_destroyFrameTap));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_getFrameTapFrame"),
+		Napi::Function::New(env, display::OBS_content_getFrameTapFrame));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_isFrameTapFrameValid"),
+		Napi::Function::New(env, display::OBS_content_isFrameTapFrameValid));
 }
\ No newline at end of file
@@ -35,4 +35,11 @@ namespace display
 	Napi::Value OBS_content_setShouldDrawUI(const Napi::CallbackInfo& info);
 	Napi::Value OBS_content_setDrawGuideLines(const Napi::CallbackInfo& info);
 	Napi::Value OBS_content_createIOSurface(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_setDisplayMaxFPS(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_setDisplayHidden(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_getDisplayRenderStats(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_createFrameTap(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_destroyFrameTap(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_getFrameTapFrame(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_isFrameTapFrameValid(const Napi::CallbackInfo& info);
 }
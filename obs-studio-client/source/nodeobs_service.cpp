@@ -115,6 +115,16 @@ Napi::Value service::OBS_service_startRecording(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value service::OBS_service_armRecording(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Service", "OBS_service_armRecording", {});
+	return info.Env().Undefined();
+}
+
 Napi::Value service::OBS_service_startReplayBuffer(const Napi::CallbackInfo& info)
 {
 	if (!isWorkerRunning) {
@@ -206,27 +216,55 @@ Napi::Value service::OBS_service_getLastReplay(const Napi::CallbackInfo& info)
 	return Napi::String::New(info.Env(), response.at(1).value_str);
 }
 
+// Indexed by the OutputType and OutputSignal values sent by the server.
+static const char* outputTypeNames[] = {"streaming", "recording", "replay-buffer"};
+static const char* outputSignalNames[] = {"start",
+                                          "stop",
+                                          "starting",
+                                          "stopping",
+                                          "activate",
+                                          "deactivate",
+                                          "reconnect",
+                                          "reconnect_success",
+                                          "writing",
+                                          "wrote",
+                                          "writing_error",
+                                          "segment_closed"};
+
+template<size_t N>
+static const char* EnumName(const char* (&names)[N], uint32_t value)
+{
+	return value < N ? names[value] : "unknown";
+}
+
 void service::worker()
 {
-    auto callback = []( Napi::Env env, Napi::Function jsCallback, SignalInfo* data ) {
-		Napi::Object result = Napi::Object::New(env);
-
-		result.Set(
-			Napi::String::New(env, "type"),
-			Napi::String::New(env, data->outputType));
-		result.Set(
-			Napi::String::New(env, "signal"),
-			Napi::String::New(env, data->signal));
-		result.Set(
-			Napi::String::New(env, "code"),
-			Napi::Number::New(env, data->code));
-		result.Set(
-			Napi::String::New(env, "error"),
-			Napi::String::New(env, data->errorMessage));
-
-		jsCallback.Call({ result });
+    auto callback = []( Napi::Env env, Napi::Function jsCallback, std::vector<SignalInfo>* data ) {
+		for (auto& signal : *data) {
+			Napi::Object result = Napi::Object::New(env);
+
+			result.Set(
+				Napi::String::New(env, "type"),
+				Napi::String::New(env, signal.outputType));
+			result.Set(
+				Napi::String::New(env, "signal"),
+				Napi::String::New(env, signal.signal));
+			result.Set(
+				Napi::String::New(env, "code"),
+				Napi::Number::New(env, signal.code));
+			result.Set(
+				Napi::String::New(env, "error"),
+				Napi::String::New(env, signal.errorMessage));
+			result.Set(
+				Napi::String::New(env, "path"),
+				Napi::String::New(env, signal.path));
+
+			jsCallback.Call({ result });
+		}
+		delete data;
     };
-	size_t totalSleepMS = 0;
+	size_t   totalSleepMS = 0;
+	uint64_t nextSequence = 0;
 
 	while (!worker_stop) {
 		auto tp_start = std::chrono::high_resolution_clock::now();
@@ -240,19 +278,37 @@ void service::worker()
 		// Call
 		{
 			std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
+			if (response.size() < 3) {
 				goto do_sleep;
 			}
 
 			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				SignalInfo* data = new SignalInfo{ "", "", 0, ""};
-				data->outputType   = response[1].value_str;
-				data->signal       = response[2].value_str;
-				data->code         = response[3].value_union.i32;
-				data->errorMessage = response[4].value_str;
-				js_thread.BlockingCall( data, callback );
+			if (error != ErrorCode::Ok)
+				goto do_sleep;
+
+			uint64_t firstSequence = response[1].value_union.ui64;
+			uint32_t count         = response[2].value_union.ui32;
+			if (count == 0 || response.size() < 3 + size_t(count) * 5)
+				goto do_sleep;
+
+			std::vector<SignalInfo>* data = new std::vector<SignalInfo>();
+			data->reserve(count + 1);
+
+			// The server ring dropped signals we never saw, let the frontend know how many.
+			if (nextSequence != 0 && firstSequence > nextSequence) {
+				data->push_back(SignalInfo{"service", "signals_lost", int(firstSequence - nextSequence), "", ""});
 			}
+			nextSequence = firstSequence + count;
+
+			for (size_t idx = 3; idx < 3 + size_t(count) * 5; idx += 5) {
+				data->push_back(SignalInfo{
+				    EnumName(outputTypeNames, response[idx].value_union.ui32),
+				    EnumName(outputSignalNames, response[idx + 1].value_union.ui32),
+				    response[idx + 2].value_union.i32,
+				    response[idx + 3].value_str,
+				    response[idx + 4].value_str});
+			}
+			js_thread.BlockingCall( data, callback );
 		}
 
 	do_sleep:
@@ -414,6 +470,9 @@ void service::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(
 		Napi::String::New(env, "OBS_service_startRecording"),
 		Napi::Function::New(env, service::OBS_service_startRecording));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_armRecording"),
+		Napi::Function::New(env, service::OBS_service_armRecording));
 	exports.Set(
 		Napi::String::New(env, "OBS_service_startReplayBuffer"),
 		Napi::Function::New(env, service::OBS_service_startReplayBuffer));
@@ -27,6 +27,7 @@ struct SignalInfo
 	std::string signal;
 	int         code;
 	std::string errorMessage;
+	std::string path;
 };
 
 namespace service
@@ -50,6 +51,7 @@ namespace service
 
 	Napi::Value OBS_service_startStreaming(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_startRecording(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_armRecording(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_startReplayBuffer(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_stopStreaming(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_stopRecording(const Napi::CallbackInfo& info);
@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "input.hpp"
@@ -49,11 +50,14 @@ Napi::Object osn::Scene::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("orderItems", &osn::Scene::OrderItems),
 			InstanceMethod("getItemAtIdx", &osn::Scene::GetItemAtIndex),
 			InstanceMethod("getItems", &osn::Scene::GetItems),
+			InstanceMethod("getItemsAsync", &osn::Scene::GetItemsAsync),
 			InstanceMethod("getItemsInRange", &osn::Scene::GetItemsInRange),
 
 			InstanceAccessor("configurable", &osn::Scene::CallIsConfigurable, nullptr),
 			InstanceAccessor("properties", &osn::Scene::CallGetProperties, nullptr),
 			InstanceAccessor("settings", &osn::Scene::CallGetSettings, nullptr),
+			InstanceMethod("getPropertiesAsync", &osn::Scene::CallGetPropertiesAsync),
+			InstanceMethod("getSettingsAsync", &osn::Scene::CallGetSettingsAsync),
 			InstanceAccessor("type", &osn::Scene::CallGetType, nullptr),
 			InstanceAccessor("name", &osn::Scene::CallGetName, &osn::Scene::CallSetName),
 			InstanceAccessor("outputFlags", &osn::Scene::CallGetOutputFlags, nullptr),
@@ -512,52 +516,38 @@ Napi::Value osn::Scene::GetItemAtIndex(const Napi::CallbackInfo& info)
     return instance;
 }
 
-Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo& info)
+static Napi::Value CachedItems(Napi::Env env, SceneInfo* si)
 {
-	SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(this->sourceId);
-
-	if (si && si->itemsOrderCached) {
-		Napi::Array array = Napi::Array::New(info.Env(), int(si->items.size()) - 1);
-		size_t index = 0;
-		bool itemRemoved = false;
-
-		for (auto item : si->items) {
-			SceneItemData*  sid = CacheManager<SceneItemData*>::getInstance().Retrieve(item.first);
-			if (!sid) {
-				itemRemoved = true;
-				break;
-			}
-			auto instance =
-				osn::SceneItem::constructor.New({
-					Napi::Number::New(info.Env(), item.second)
-					});
-			array.Set(uint32_t(index++), instance);
-		}
-		if (!itemRemoved) {
-			return array;
-		}
-	}
-
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
+	Napi::Array array = Napi::Array::New(env, int(si->items.size()) - 1);
+	size_t index = 0;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Scene", "GetItems", std::vector<ipc::value>{ipc::value(this->sourceId)});
+	for (auto item : si->items) {
+		SceneItemData*  sid = CacheManager<SceneItemData*>::getInstance().Retrieve(item.first);
+		if (!sid)
+			return Napi::Value();
 
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
+		auto instance =
+			osn::SceneItem::constructor.New({
+				Napi::Number::New(env, item.second)
+				});
+		array.Set(uint32_t(index++), instance);
+	}
+	return array;
+}
 
-	Napi::Array array = Napi::Array::New(info.Env(), int((response.size()) - 1)/2);
+static Napi::Value ProcessItems(Napi::Env env, uint64_t sceneId, const std::vector<ipc::value>& response)
+{
+	Napi::Array array = Napi::Array::New(env, int((response.size()) - 1)/2);
 	size_t index = 0;
 	for (size_t i = 1; i < response.size(); i++) {
 		auto instance =
 			osn::SceneItem::constructor.New({
-				Napi::Number::New(info.Env(), response[i++].value_union.ui64)
+				Napi::Number::New(env, response[i++].value_union.ui64)
 				});
 		array.Set(uint32_t(index++), instance);
 	}
 
+	SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(sceneId);
 	if (si) {
 		si->items.clear();
 
@@ -571,6 +561,50 @@ Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo& info)
 	return array;
 }
 
+Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo& info)
+{
+	SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(this->sourceId);
+
+	if (si && si->itemsOrderCached) {
+		Napi::Value array = CachedItems(info.Env(), si);
+		if (!array.IsEmpty())
+			return array;
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Scene", "GetItems", std::vector<ipc::value>{ipc::value(this->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return ProcessItems(info.Env(), this->sourceId, response);
+}
+
+Napi::Value osn::Scene::GetItemsAsync(const Napi::CallbackInfo& info)
+{
+	SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(this->sourceId);
+
+	if (si && si->itemsOrderCached) {
+		Napi::Value array = CachedItems(info.Env(), si);
+		if (!array.IsEmpty())
+			return asyncCall::Resolved(info.Env(), array);
+	}
+
+	uint64_t sceneId = this->sourceId;
+	return asyncCall::Call(
+	    info,
+	    "Scene",
+	    "GetItems",
+	    {ipc::value(sceneId)},
+	    [sceneId](Napi::Env env, const std::vector<ipc::value>& response) {
+		    return ProcessItems(env, sceneId, response);
+	    });
+}
+
 Napi::Value osn::Scene::GetItemsInRange(const Napi::CallbackInfo& info)
 {
 	int32_t from = info[0].ToNumber().Int32Value();
@@ -615,6 +649,16 @@ Napi::Value osn::Scene::CallGetSettings(const Napi::CallbackInfo& info)
 	return osn::ISource::GetSettings(info, this->sourceId);
 }
 
+Napi::Value osn::Scene::CallGetPropertiesAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
+Napi::Value osn::Scene::CallGetSettingsAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetSettingsAsync(info, this->sourceId);
+}
+
 
 Napi::Value osn::Scene::CallGetType(const Napi::CallbackInfo& info)
 {
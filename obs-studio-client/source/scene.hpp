@@ -49,11 +49,14 @@ namespace osn
 		Napi::Value OrderItems(const Napi::CallbackInfo& info);
 		Napi::Value GetItemAtIndex(const Napi::CallbackInfo& info);
 		Napi::Value GetItems(const Napi::CallbackInfo& info);
+		Napi::Value GetItemsAsync(const Napi::CallbackInfo& info);
 		Napi::Value GetItemsInRange(const Napi::CallbackInfo& info);
 
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
 		Napi::Value CallGetProperties(const Napi::CallbackInfo& info);
 		Napi::Value CallGetSettings(const Napi::CallbackInfo& info);
+		Napi::Value CallGetPropertiesAsync(const Napi::CallbackInfo& info);
+		Napi::Value CallGetSettingsAsync(const Napi::CallbackInfo& info);
 
 		Napi::Value CallGetType(const Napi::CallbackInfo& info);
 		Napi::Value CallGetName(const Napi::CallbackInfo& info);
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <string>
 
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "input.hpp"
@@ -63,6 +64,7 @@ Napi::Object osn::SceneItem::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("remove", &osn::SceneItem::Remove),
 			InstanceMethod("deferUpdateBegin", &osn::SceneItem::DeferUpdateBegin),
 			InstanceMethod("deferUpdateEnd", &osn::SceneItem::DeferUpdateEnd),
+			InstanceMethod("getPositionAsync", &osn::SceneItem::GetPositionAsync),
 		});
 	exports.Set("SceneItem", func);
 	osn::SceneItem::constructor = Napi::Persistent(func);
@@ -348,16 +350,39 @@ void osn::SceneItem::SetRecordingVisible(const Napi::CallbackInfo& info, const N
 	}
 }
 
+static Napi::Object CachedPosition(Napi::Env env, SceneItemData* sid)
+{
+	Napi::Object obj = Napi::Object::New(env);
+	obj.Set("x", Napi::Number::New(env, sid->posX));
+	obj.Set("y", Napi::Number::New(env, sid->posY));
+	return obj;
+}
+
+static Napi::Value ProcessPosition(Napi::Env env, uint64_t itemId, const std::vector<ipc::value>& response)
+{
+	float x = response[1].value_union.fp32;
+	float y = response[2].value_union.fp32;
+
+	Napi::Object obj = Napi::Object::New(env);
+	obj.Set("x", Napi::Number::New(env, x));
+	obj.Set("y", Napi::Number::New(env, y));
+
+	SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(itemId);
+	if (sid) {
+		sid->posX       = x;
+		sid->posY       = y;
+		sid->posChanged = false;
+	}
+
+	return obj;
+}
+
 Napi::Value osn::SceneItem::GetPosition(const Napi::CallbackInfo& info)
 {
 	SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(this->itemId);
 
-	if (sid && !sid->posChanged) {
-		Napi::Object obj = Napi::Object::New(info.Env());
-		obj.Set("x", Napi::Number::New(info.Env(), sid->posX));
-		obj.Set("y", Napi::Number::New(info.Env(), sid->posY));
-		return obj;
-	}
+	if (sid && !sid->posChanged)
+		return CachedPosition(info.Env(), sid);
 
 	auto conn = GetConnection(info);
 	if (!conn)
@@ -368,18 +393,26 @@ Napi::Value osn::SceneItem::GetPosition(const Napi::CallbackInfo& info)
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
-	float x = response[1].value_union.fp32;
-	float y = response[2].value_union.fp32;
 
-	Napi::Object obj = Napi::Object::New(info.Env());
-	obj.Set("x", Napi::Number::New(info.Env(), x));
-	obj.Set("y", Napi::Number::New(info.Env(), y));
+	return ProcessPosition(info.Env(), this->itemId, response);
+}
 
-	sid->posX       = x;
-	sid->posY       = y;
-	sid->posChanged = false;
+Napi::Value osn::SceneItem::GetPositionAsync(const Napi::CallbackInfo& info)
+{
+	SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(this->itemId);
 
-	return obj;
+	if (sid && !sid->posChanged)
+		return asyncCall::Resolved(info.Env(), CachedPosition(info.Env(), sid));
+
+	uint64_t itemId = this->itemId;
+	return asyncCall::Call(
+	    info,
+	    "SceneItem",
+	    "GetPosition",
+	    {ipc::value(itemId)},
+	    [itemId](Napi::Env env, const std::vector<ipc::value>& response) {
+		    return ProcessPosition(env, itemId, response);
+	    });
 }
 
 void osn::SceneItem::SetPosition(const Napi::CallbackInfo& info, const Napi::Value &value)
@@ -48,6 +48,7 @@ namespace osn
 		void SetRecordingVisible(const Napi::CallbackInfo& info, const Napi::Value &value);
 
 		Napi::Value GetPosition(const Napi::CallbackInfo& info);
+		Napi::Value GetPositionAsync(const Napi::CallbackInfo& info);
 		void SetPosition(const Napi::CallbackInfo& info, const Napi::Value &value);
 		Napi::Value GetRotation(const Napi::CallbackInfo& info);
 		void SetRotation(const Napi::CallbackInfo& info, const Napi::Value &value);
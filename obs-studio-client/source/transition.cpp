@@ -24,6 +24,7 @@
 #include "error.hpp"
 #include "ipc-value.hpp"
 #include "shared.hpp"
+#include "type-catalog.hpp"
 #include "utility.hpp"
 
 Napi::FunctionReference osn::Transition::constructor;
@@ -47,6 +48,8 @@ Napi::Object osn::Transition::Init(Napi::Env env, Napi::Object exports) {
 			InstanceAccessor("configurable", &osn::Transition::CallIsConfigurable, nullptr),
 			InstanceAccessor("properties", &osn::Transition::CallGetProperties, nullptr),
 			InstanceAccessor("settings", &osn::Transition::CallGetSettings, nullptr),
+			InstanceMethod("getPropertiesAsync", &osn::Transition::CallGetPropertiesAsync),
+			InstanceMethod("getSettingsAsync", &osn::Transition::CallGetSettingsAsync),
 			InstanceAccessor("type", &osn::Transition::CallGetType, nullptr),
 			InstanceAccessor("name", &osn::Transition::CallGetName, &osn::Transition::CallSetName),
 			InstanceAccessor("outputFlags", &osn::Transition::CallGetOutputFlags, nullptr),
@@ -89,23 +92,7 @@ osn::Transition::Transition(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Transition::Types(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Types", {});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	size_t count = response.size() - 1;
-	Napi::Array types = Napi::Array::New(info.Env(), count);
-
-	for (size_t idx = 0; idx < count; idx++) {
-		types.Set(idx, Napi::String::New(info.Env(), response[1 + idx].value_str));
-	}
-
-	return types;
+	return osn::TypeCatalog::Types(info, osn::TypeCatalog::TYPE_TRANSITION);
 }
 
 Napi::Value osn::Transition::Create(const Napi::CallbackInfo& info)
@@ -314,6 +301,16 @@ Napi::Value osn::Transition::CallGetSettings(const Napi::CallbackInfo& info)
 	return osn::ISource::GetSettings(info, this->sourceId);
 }
 
+Napi::Value osn::Transition::CallGetPropertiesAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
+Napi::Value osn::Transition::CallGetSettingsAsync(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetSettingsAsync(info, this->sourceId);
+}
+
 
 Napi::Value osn::Transition::CallGetType(const Napi::CallbackInfo& info)
 {
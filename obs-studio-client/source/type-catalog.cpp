@@ -0,0 +1,96 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "type-catalog.hpp"
+#include "controller.hpp"
+#include "error.hpp"
+#include "ipc-registry.hpp"
+#include "ipc-value.hpp"
+#include "utility.hpp"
+
+std::vector<osn::TypeInfo>    osn::TypeCatalog::types;
+std::map<std::string, size_t> osn::TypeCatalog::typesById;
+bool                          osn::TypeCatalog::valid = false;
+
+const std::vector<osn::TypeInfo>* osn::TypeCatalog::Get(const Napi::CallbackInfo& info)
+{
+	if (valid)
+		return &types;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return nullptr;
+
+	std::vector<ipc::value> response = ipc_registry::call_synchronous(conn, ipc_registry::Global::GetTypeCatalog);
+
+	if (!ValidateResponse(info, response))
+		return nullptr;
+
+	types.clear();
+	typesById.clear();
+	for (size_t idx = 1; idx + 4 < response.size(); idx += 5) {
+		TypeInfo ti;
+		ti.type         = response[idx].value_union.ui32;
+		ti.id           = response[idx + 1].value_str;
+		ti.displayName  = response[idx + 2].value_str;
+		ti.outputFlags  = response[idx + 3].value_union.ui32;
+		ti.capabilities = response[idx + 4].value_union.ui32;
+
+		typesById.emplace(ti.id, types.size());
+		types.push_back(std::move(ti));
+	}
+	valid = true;
+
+	return &types;
+}
+
+const osn::TypeInfo* osn::TypeCatalog::Find(const Napi::CallbackInfo& info, const std::string& id)
+{
+	if (!Get(info))
+		return nullptr;
+
+	auto it = typesById.find(id);
+	if (it == typesById.end())
+		return nullptr;
+
+	return &types[it->second];
+}
+
+Napi::Value osn::TypeCatalog::Types(const Napi::CallbackInfo& info, uint32_t type)
+{
+	const std::vector<TypeInfo>* catalog = Get(info);
+	if (!catalog)
+		return info.Env().Undefined();
+
+	Napi::Array result = Napi::Array::New(info.Env());
+	uint32_t    count  = 0;
+
+	for (const TypeInfo& ti : *catalog) {
+		if (ti.type == type)
+			result.Set(count++, Napi::String::New(info.Env(), ti.id));
+	}
+
+	return result;
+}
+
+void osn::TypeCatalog::Invalidate()
+{
+	valid = false;
+	types.clear();
+	typesById.clear();
+}
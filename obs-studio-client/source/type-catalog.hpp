@@ -0,0 +1,65 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <map>
+#include <napi.h>
+#include <string>
+#include <vector>
+
+namespace osn
+{
+	struct TypeInfo
+	{
+		uint32_t    type;
+		std::string id;
+		std::string displayName;
+		uint32_t    outputFlags;
+		uint32_t    capabilities;
+	};
+
+	// Source, filter and transition types can only change when plugins are loaded, so
+	// the catalog is fetched once and kept until Module.Open/Initialize or API init.
+	class TypeCatalog
+	{
+		public:
+		// Matches obs_source_type on the server.
+		enum SourceType : uint32_t
+		{
+			TYPE_INPUT      = 0,
+			TYPE_FILTER     = 1,
+			TYPE_TRANSITION = 2,
+		};
+
+		// Matches osn::Global::TypeCapabilities on the server.
+		enum Capabilities : uint32_t
+		{
+			CAP_CONFIGURABLE = 1 << 0,
+		};
+
+		static const std::vector<TypeInfo>* Get(const Napi::CallbackInfo& info);
+		static const TypeInfo*              Find(const Napi::CallbackInfo& info, const std::string& id);
+		static Napi::Value                  Types(const Napi::CallbackInfo& info, uint32_t type);
+		static void                         Invalidate();
+
+		private:
+		static std::vector<TypeInfo>         types;
+		static std::map<std::string, size_t> typesById;
+		static bool                          valid;
+	};
+}
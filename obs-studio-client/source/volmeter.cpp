@@ -28,6 +28,53 @@
 #include "utility.hpp"
 #include "callback-manager.hpp"
 
+VolmeterBuffer::VolmeterBuffer(Napi::Env env)
+{
+	const size_t slotSize = 3 * VOLMETER_MAX_CHANNELS * sizeof(float);
+
+	Napi::ArrayBuffer arrayBuffer = Napi::ArrayBuffer::New(env, 2 * slotSize);
+	buffer                        = Napi::Persistent(arrayBuffer);
+
+	for (size_t i = 0; i < 2; i++) {
+		slots[i].owner  = this;
+		slots[i].offset = i * slotSize;
+		slots[i].levels = reinterpret_cast<float*>(static_cast<uint8_t*>(arrayBuffer.Data()) + slots[i].offset);
+	}
+}
+
+VolmeterSlot* VolmeterBuffer::Acquire()
+{
+	// With one tick pending it is the last one submitted, the other slot is free.
+	if (pending.load() >= 2)
+		return nullptr;
+	return &slots[1 - lastSlot];
+}
+
+void VolmeterBuffer::Submit(VolmeterSlot* slot)
+{
+	lastSlot = uint32_t(slot - slots);
+	pending++;
+}
+
+void VolmeterBuffer::Release()
+{
+	pending--;
+}
+
+void VolmeterSlot::UpdateViews(Napi::Env env)
+{
+	if (viewChannels == channels && !magnitude.IsEmpty())
+		return;
+
+	Napi::ArrayBuffer arrayBuffer = owner->buffer.Value();
+	const size_t      stride      = VOLMETER_MAX_CHANNELS * sizeof(float);
+
+	magnitude    = Napi::Persistent(Napi::Float32Array::New(env, channels, arrayBuffer, offset));
+	peak         = Napi::Persistent(Napi::Float32Array::New(env, channels, arrayBuffer, offset + stride));
+	input_peak   = Napi::Persistent(Napi::Float32Array::New(env, channels, arrayBuffer, offset + 2 * stride));
+	viewChannels = channels;
+}
+
 Napi::FunctionReference osn::Volmeter::constructor;
 
 Napi::Object osn::Volmeter::Init(Napi::Env env, Napi::Object exports) {
@@ -17,15 +17,50 @@
 ******************************************************************************/
 
 #pragma once
+#include <atomic>
 #include <napi.h>
 #include <thread>
 #include "utility-v8.hpp"
 
-struct VolmeterData
+// Same as MAX_AUDIO_CHANNELS in libobs.
+#define VOLMETER_MAX_CHANNELS 8
+
+struct VolmeterBuffer;
+
+// One tick worth of levels: magnitude, peak and input peak, each VOLMETER_MAX_CHANNELS floats long,
+// stored back to back in the meter's ArrayBuffer. The Float32Array views over it are only rebuilt
+// when the channel count changes.
+struct VolmeterSlot
 {
-	std::vector<float> magnitude;
-	std::vector<float> peak;
-	std::vector<float> input_peak;
+	VolmeterBuffer* owner    = nullptr;
+	float*          levels   = nullptr;
+	size_t          offset   = 0;
+	uint32_t        channels = 0;
+
+	uint32_t                            viewChannels = 0;
+	Napi::Reference<Napi::Float32Array> magnitude;
+	Napi::Reference<Napi::Float32Array> peak;
+	Napi::Reference<Napi::Float32Array> input_peak;
+
+	void UpdateViews(Napi::Env env);
+};
+
+// Double buffered levels of one volmeter. The callback worker fills the slot JS is not looking at
+// and queues it, at most two ticks are ever in flight so a slot is never written while it is read.
+struct VolmeterBuffer
+{
+	Napi::Reference<Napi::ArrayBuffer> buffer;
+	VolmeterSlot                       slots[2];
+	std::atomic<uint32_t>              pending{0};
+	uint32_t                           lastSlot = 1;
+
+	VolmeterBuffer(Napi::Env env);
+
+	// Called by the worker, returns nullptr while JS still has both slots.
+	VolmeterSlot* Acquire();
+	void          Submit(VolmeterSlot* slot);
+	// Called on the JS thread once the callback is done with the slot.
+	void Release();
 };
 
 namespace osn
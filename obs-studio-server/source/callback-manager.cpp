@@ -26,8 +26,83 @@
 #include "osn-source.hpp"
 #include "osn-volmeter.hpp"
 
-std::mutex                             sources_sizes_mtx;
-std::map<std::string, SourceSizeInfo*> sources;
+// Nanoseconds between two size checks of the active sources.
+static const uint64_t SIZE_CHECK_INTERVAL_NS = 100000000;
+
+std::mutex                            sources_sizes_mtx;
+std::map<uint64_t, SourceSizeInfo*>   sources;
+std::vector<uint64_t>                 dirty_sources;
+std::set<SourceSizeInfo*>             active_sources;
+uint64_t                              size_check_last = 0;
+
+static void MarkDirty(SourceSizeInfo* si, bool forceReport)
+{
+	si->forceReport |= forceReport;
+	if (si->dirty)
+		return;
+	si->dirty = true;
+	dirty_sources.push_back(si->id);
+}
+
+static void MarkDirty(uint64_t id, bool forceReport)
+{
+	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+	auto                         it = sources.find(id);
+	if (it != sources.end())
+		MarkDirty(it->second, forceReport);
+}
+
+static void source_changed_cb(void* data, calldata_t* cd)
+{
+	MarkDirty(uint64_t(reinterpret_cast<uintptr_t>(data)), false);
+}
+
+static void source_renamed_cb(void* data, calldata_t* cd)
+{
+	// The client tracks sizes by name, so report the source under its new name.
+	MarkDirty(uint64_t(reinterpret_cast<uintptr_t>(data)), true);
+}
+
+static void source_activated_cb(void* data, calldata_t* cd)
+{
+	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+	auto                         it = sources.find(uint64_t(reinterpret_cast<uintptr_t>(data)));
+	if (it == sources.end())
+		return;
+
+	active_sources.insert(it->second);
+	MarkDirty(it->second, false);
+}
+
+static void source_deactivated_cb(void* data, calldata_t* cd)
+{
+	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+	auto                         it = sources.find(uint64_t(reinterpret_cast<uintptr_t>(data)));
+	if (it != sources.end())
+		active_sources.erase(it->second);
+}
+
+// Size changes without any signal, e.g. a media source opening a file, are caught here.
+// libobs has no signal for a new async frame size, so this cannot be signal driven.
+// It runs from GlobalQuery on the IPC thread and only walks the active sources, the
+// others are checked again when they get activated. Expects sources_sizes_mtx held.
+static void CheckActiveSizes()
+{
+	uint64_t now = os_gettime_ns();
+	if (now - size_check_last < SIZE_CHECK_INTERVAL_NS)
+		return;
+	size_check_last = now;
+
+	for (SourceSizeInfo* si : active_sources) {
+		if (si->dirty)
+			continue;
+
+		if (si->width != obs_source_get_width(si->source) || si->height != obs_source_get_height(si->source))
+			MarkDirty(si, false);
+	}
+}
+
+static const char* source_size_signals[] = {"update", "update_flags", "show"};
 
 void CallbackManager::Register(ipc::server& srv)
 {
@@ -47,21 +122,31 @@ void CallbackManager::GlobalQuery(
 {	
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
-	if (!sources.empty()) {
-		sources_sizes_mtx.lock();
-		uint32_t size = 0;
+	// Only the sources flagged by a signal or the size check are looked at.
+	{
+		std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+		uint32_t                     size = 0;
+
+		CheckActiveSizes();
+
+		for (uint64_t uid : dirty_sources) {
+			auto item = sources.find(uid);
+			if (item == sources.end())
+				continue;
+
+			SourceSizeInfo* si = item->second;
+			si->dirty          = false;
 
-		for (auto item : sources) {
-			SourceSizeInfo* si = item.second;
 			// See if width or height changed here
 			uint32_t newWidth  = obs_source_get_width(si->source);
 			uint32_t newHeight = obs_source_get_height(si->source);
 			uint32_t newFlags  = obs_source_get_output_flags(si->source);
 
-			if (si->width != newWidth || si->height != newHeight || si->flags != newFlags) {
-				si->width = newWidth;
-				si->height = newHeight;
-				si->flags  = newFlags;
+			if (si->width != newWidth || si->height != newHeight || si->flags != newFlags || si->forceReport) {
+				si->width       = newWidth;
+				si->height      = newHeight;
+				si->flags       = newFlags;
+				si->forceReport = false;
 
 				rval.push_back(ipc::value(obs_source_get_name(si->source)));
 				rval.push_back(ipc::value(si->width));
@@ -71,11 +156,9 @@ void CallbackManager::GlobalQuery(
 				size++;
 			}
 		}
+		dirty_sources.clear();
 
 		rval.insert(rval.begin() + 1, ipc::value(size));
-		sources_sizes_mtx.unlock();
-	} else {
-		rval.insert(rval.begin() + 1, ipc::value((uint32_t)0));
 	}
 	
 	uint64_t size_buffer = args[0].value_union.ui64;
@@ -98,34 +181,74 @@ void CallbackManager::GlobalQuery(
 
 void CallbackManager::addSource(obs_source_t* source)
 {
+	if (!source)
+		return;
+
 	uint32_t flags= obs_source_get_output_flags(source);
 	if ((flags & OBS_SOURCE_VIDEO) == 0)
 		return;
 
-	if (!source ||
-		obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER ||
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER ||
 		obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION ||
 		obs_source_get_type(source) == OBS_SOURCE_TYPE_SCENE)
 		return;
 
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	if (uid == UINT64_MAX)
+		return;
+
 	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
 
 	SourceSizeInfo* si               = new SourceSizeInfo;
 	si->source                       = source;
+	si->id                           = uid;
 	si->width                        = obs_source_get_width(source);
 	si->height                       = obs_source_get_height(source);
 
-	sources.emplace(std::make_pair(std::string(obs_source_get_name(source)), si));
+	// Flags start out unknown, so every new source is reported once.
+	auto result = sources.emplace(std::make_pair(uid, si));
+	if (!result.second) {
+		delete si;
+		return;
+	}
+	MarkDirty(si, false);
+	ulock.unlock();
+
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : source_size_signals)
+		signal_handler_connect(sh, signal, source_changed_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+	signal_handler_connect(sh, "rename", source_renamed_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+	signal_handler_connect(sh, "activate", source_activated_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+	signal_handler_connect(sh, "deactivate", source_deactivated_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+
+	// Checked after connecting, so an activation in between cannot be missed.
+	// Signals are never connected under the lock, their callbacks take it.
+	ulock.lock();
+	auto it = sources.find(uid);
+	if (it != sources.end() && it->second == si && obs_source_active(source))
+		active_sources.insert(si);
 }
 void CallbackManager::removeSource(obs_source_t* source)
 {
-	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
-	
 	if (!source)
 		return;
 
-	const char* name = obs_source_get_name(source);
-	
-	if (name)
-		sources.erase(name);
-}
\ No newline at end of file
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+
+	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+	auto                         item = sources.find(uid);
+	if (item == sources.end())
+		return;
+
+	active_sources.erase(item->second);
+	delete item->second;
+	sources.erase(item);
+	ulock.unlock();
+
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : source_size_signals)
+		signal_handler_disconnect(sh, signal, source_changed_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+	signal_handler_disconnect(sh, "rename", source_renamed_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+	signal_handler_disconnect(sh, "activate", source_activated_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+	signal_handler_disconnect(sh, "deactivate", source_deactivated_cb, reinterpret_cast<void*>(uintptr_t(uid)));
+}
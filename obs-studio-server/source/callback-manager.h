@@ -25,8 +25,10 @@
 #include <mutex>
 #include <obs.h>
 #include <queue>
+#include <set>
 #include <string>
 #include <thread>
+#include <vector>
 #include <util/config-file.h>
 #include <util/dstr.h>
 #include <util/platform.h>
@@ -37,9 +39,14 @@
 struct SourceSizeInfo
 {
 	obs_source_t* source;
+	uint64_t      id = 0;
 	uint32_t      width = 0;
 	uint32_t      height = 0;
 	uint32_t      flags = 0;
+
+	// Queued for the next GlobalQuery, forceReport sends it even if nothing changed.
+	bool          dirty = false;
+	bool          forceReport = false;
 };
 
 class CallbackManager
@@ -0,0 +1,159 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "gs-overlay.h"
+
+// Length of a guideline in world units, the preview scissor clips it.
+static const float_t GUIDELINE_LENGTH = 65535.0f;
+
+void GS::OverlayVertices::Clear()
+{
+	positions.clear();
+	colors.clear();
+}
+
+size_t GS::OverlayVertices::Size() const
+{
+	return positions.size();
+}
+
+void GS::OverlayVertices::Push(const vec3& position, uint32_t color)
+{
+	positions.push_back(position);
+	colors.push_back(color);
+}
+
+size_t GS::OverlayVertices::Draws(size_t capacity) const
+{
+	return (positions.size() + capacity - 1) / capacity;
+}
+
+void GS::OverlayBatch::Clear()
+{
+	m_lines.Clear();
+	m_triangles.Clear();
+	m_guidelines.Clear();
+}
+
+void GS::OverlayBatch::AddOutline(const matrix4& mtx, uint32_t color)
+{
+	vec3 corners[4];
+	vec3_set(&corners[0], 0, 0, 0);
+	vec3_set(&corners[1], 1, 0, 0);
+	vec3_set(&corners[2], 1, 1, 0);
+	vec3_set(&corners[3], 0, 1, 0);
+	for (size_t n = 0; n < 4; n++)
+		vec3_transform(&corners[n], &corners[n], &mtx);
+
+	for (size_t n = 0; n < 4; n++) {
+		m_lines.Push(corners[n], color);
+		m_lines.Push(corners[(n + 1) % 4], color);
+	}
+}
+
+void GS::OverlayBatch::AddHandle(
+    float_t        x,
+    float_t        y,
+    const matrix4& mtx,
+    const vec2&    size,
+    uint32_t       fillColor,
+    uint32_t       borderColor)
+{
+	vec3 center;
+	vec3_set(&center, x, y, 0);
+	vec3_transform(&center, &center, &mtx);
+
+	float_t left = center.x - size.x / 2, right = center.x + size.x / 2;
+	float_t top = center.y - size.y / 2, bottom = center.y + size.y / 2;
+
+	vec3 corners[4];
+	vec3_set(&corners[0], left, top, 0);
+	vec3_set(&corners[1], right, top, 0);
+	vec3_set(&corners[2], right, bottom, 0);
+	vec3_set(&corners[3], left, bottom, 0);
+
+	// Fill
+	m_triangles.Push(corners[0], fillColor);
+	m_triangles.Push(corners[1], fillColor);
+	m_triangles.Push(corners[3], fillColor);
+	m_triangles.Push(corners[1], fillColor);
+	m_triangles.Push(corners[3], fillColor);
+	m_triangles.Push(corners[2], fillColor);
+
+	// Border
+	for (size_t n = 0; n < 4; n++) {
+		m_lines.Push(corners[n], borderColor);
+		m_lines.Push(corners[(n + 1) % 4], borderColor);
+	}
+}
+
+void GS::OverlayBatch::AddGuideline(float_t x, float_t y, const matrix4& mtx, uint32_t color)
+{
+	vec3 center;
+	vec3_set(&center, 0.5f, 0.5f, 0);
+	vec3_transform(&center, &center, &mtx);
+
+	vec3 pos;
+	vec3_set(&pos, x, y, 0);
+	vec3_transform(&pos, &pos, &mtx);
+
+	vec3 normal;
+	vec3_sub(&normal, &center, &pos);
+	vec3_norm(&normal, &normal);
+
+	// The guideline points away from the center along the dominant axis.
+	vec3 direction;
+	if (normal.y > 0.5f) {
+		vec3_set(&direction, 0, -1, 0);
+	} else if (normal.y < -0.5f) {
+		vec3_set(&direction, 0, 1, 0);
+	} else if (normal.x < -0.5f) {
+		vec3_set(&direction, 1, 0, 0);
+	} else if (normal.x > 0.5f) {
+		vec3_set(&direction, -1, 0, 0);
+	} else {
+		vec3_set(&direction, 1, 0, 0);
+	}
+
+	vec3 end;
+	vec3_mulf(&end, &direction, GUIDELINE_LENGTH);
+	vec3_add(&end, &end, &pos);
+
+	m_guidelines.Push(pos, color);
+	m_guidelines.Push(end, color);
+}
+
+const GS::OverlayVertices& GS::OverlayBatch::GetLines() const
+{
+	return m_lines;
+}
+
+const GS::OverlayVertices& GS::OverlayBatch::GetTriangles() const
+{
+	return m_triangles;
+}
+
+const GS::OverlayVertices& GS::OverlayBatch::GetGuidelines() const
+{
+	return m_guidelines;
+}
+
+bool GS::OverlayBatch::Empty() const
+{
+	return m_lines.Size() == 0 && m_triangles.Size() == 0 && m_guidelines.Size() == 0;
+}
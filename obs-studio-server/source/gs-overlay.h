@@ -0,0 +1,103 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <vector>
+extern "C" {
+#pragma warning(push)
+#pragma warning(disable : 4201)
+#include <graphics/matrix4.h>
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+#pragma warning(pop)
+}
+
+namespace GS
+{
+	/*!
+	* \brief A stream of colored vertices in world space.
+	* Colors use the packed 0xAABBGGRR layout expected by gs_vb_data.
+	*/
+	struct OverlayVertices
+	{
+		std::vector<vec3>     positions;
+		std::vector<uint32_t> colors;
+
+		void   Clear();
+		size_t Size() const;
+		void   Push(const vec3& position, uint32_t color);
+
+		/*!
+		* \brief Number of draws needed to submit the stream through a vertex
+		* buffer holding at most 'capacity' vertices.
+		*/
+		size_t Draws(size_t capacity) const;
+	};
+
+	/*!
+	* \brief CPU-side batcher for selection overlays.
+	* Accumulates the outline, resize handles and guidelines of every selected
+	* item for one frame, so the display can submit them with a handful of
+	* draws using per-vertex colors. Does not touch the graphics subsystem.
+	*/
+	class OverlayBatch
+	{
+		public:
+		void Clear();
+
+		/*!
+		* \brief Add the outline of the unit square transformed by mtx.
+		* Emits 4 line segments into the line stream.
+		*/
+		void AddOutline(const matrix4& mtx, uint32_t color);
+
+		/*!
+		* \brief Add a screen-aligned resize handle.
+		* The handle is centered on the point (x, y) of the unit square transformed by mtx.
+		* Emits a filled quad into the triangle stream and its border into the line stream.
+		*
+		* \param size Width and height of the handle in world units.
+		*/
+		void AddHandle(
+		    float_t        x,
+		    float_t        y,
+		    const matrix4& mtx,
+		    const vec2&    size,
+		    uint32_t       fillColor,
+		    uint32_t       borderColor);
+
+		/*!
+		* \brief Add a guideline from the edge point (x, y) of the transformed unit square
+		* outward, away from the center of the square.
+		* Guidelines are meant to be clipped to the preview area and so go into their own stream.
+		*/
+		void AddGuideline(float_t x, float_t y, const matrix4& mtx, uint32_t color);
+
+		const OverlayVertices& GetLines() const;
+		const OverlayVertices& GetTriangles() const;
+		const OverlayVertices& GetGuidelines() const;
+
+		bool Empty() const;
+
+		private:
+		OverlayVertices m_lines;
+		OverlayVertices m_triangles;
+		OverlayVertices m_guidelines;
+	};
+} // namespace GS
@@ -0,0 +1,315 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "gs-streamvertexbuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "gs-vertexpool.h"
+extern "C" {
+#pragma warning(push)
+#pragma warning(disable : 4201)
+#include <obs.h>
+#pragma warning(pop)
+}
+
+GS::StreamVertexBuffer::StreamVertexBuffer(uint32_t maximumVertices, uint32_t streams)
+{
+	if (maximumVertices > MAXIMUM_VERTICES) {
+		throw std::out_of_range("maximumVertices out of range");
+	}
+	if (!(streams & STREAM_POSITIONS)) {
+		throw std::invalid_argument("positions are required");
+	}
+
+	m_size       = 0;
+	m_capacity   = maximumVertices;
+	m_streams    = streams;
+	m_dirtyBegin = 0;
+	m_dirtyEnd   = 0;
+
+	SetupVertexBuffer();
+
+	// In case of device being removed, try again to create VertexBuffer
+	// after manually rebuilding GPU device
+	if (!m_vertexbuffer) {
+		blog(LOG_ERROR, "GS::StreamVertexBuffer: fail to create buffer, trying to rebuild device");
+
+		obs_enter_graphics();
+		gs_rebuild_device();
+		obs_leave_graphics();
+
+		// A failed creation destroys the vertex data together with the arrays
+		// it points at, so everything has to be set up from scratch.
+		SetupVertexBuffer();
+
+		if (!m_vertexbuffer) {
+			throw std::runtime_error("Failed to create vertex buffer.");
+		}
+	}
+}
+
+GS::StreamVertexBuffer::~StreamVertexBuffer()
+{
+	if (m_vertexbufferdata) {
+		memset(m_vertexbufferdata, 0, sizeof(gs_vb_data));
+		if (!m_vertexbuffer) {
+			gs_vbdata_destroy(m_vertexbufferdata);
+		}
+		m_vertexbufferdata = nullptr;
+	}
+	if (m_vertexbuffer) {
+		obs_enter_graphics();
+		gs_vertexbuffer_destroy(m_vertexbuffer);
+		obs_leave_graphics();
+		m_vertexbuffer = nullptr;
+	}
+
+	ReleaseStream(m_positions, sizeof(vec3));
+	ReleaseStream(m_normals, sizeof(vec3));
+	ReleaseStream(m_tangents, sizeof(vec3));
+	ReleaseStream(m_colors, sizeof(uint32_t));
+	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+		ReleaseStream(m_uvs[n], sizeof(vec4));
+	}
+	if (m_layerdata) {
+		VertexPool::Get().Release(m_layerdata, sizeof(gs_tvertarray) * MAXIMUM_UVW_LAYERS);
+		m_layerdata = nullptr;
+	}
+}
+
+void GS::StreamVertexBuffer::Resize(uint32_t new_size)
+{
+	if (new_size > m_capacity) {
+		throw std::out_of_range("new_size out of range");
+	}
+	if (new_size > m_size) {
+		MarkDirty(m_size, new_size);
+	}
+	m_size = new_size;
+}
+
+uint32_t GS::StreamVertexBuffer::Size() const
+{
+	return m_size;
+}
+
+uint32_t GS::StreamVertexBuffer::Capacity() const
+{
+	return m_capacity;
+}
+
+bool GS::StreamVertexBuffer::Empty() const
+{
+	return m_size == 0;
+}
+
+uint32_t GS::StreamVertexBuffer::GetStreams() const
+{
+	return m_streams;
+}
+
+vec3* GS::StreamVertexBuffer::GetPositions()
+{
+	return m_positions;
+}
+
+vec3* GS::StreamVertexBuffer::GetNormals()
+{
+	if (!m_normals) {
+		throw std::invalid_argument("normals were not declared");
+	}
+	return m_normals;
+}
+
+vec3* GS::StreamVertexBuffer::GetTangents()
+{
+	if (!m_tangents) {
+		throw std::invalid_argument("tangents were not declared");
+	}
+	return m_tangents;
+}
+
+uint32_t* GS::StreamVertexBuffer::GetColors()
+{
+	if (!m_colors) {
+		throw std::invalid_argument("colors were not declared");
+	}
+	return m_colors;
+}
+
+vec4* GS::StreamVertexBuffer::GetUVLayer(size_t idx)
+{
+	if (idx >= MAXIMUM_UVW_LAYERS) {
+		throw std::out_of_range("idx out of range");
+	}
+	if (!m_uvs[idx]) {
+		throw std::invalid_argument("uvs were not declared");
+	}
+	return m_uvs[idx];
+}
+
+template<typename T>
+void GS::StreamVertexBuffer::Write(T* dst, uint32_t offset, const T* src, uint32_t count)
+{
+	if (uint64_t(offset) + count > m_capacity) {
+		throw std::out_of_range("write out of range");
+	}
+
+	dst += offset;
+	if (memcmp(dst, src, sizeof(T) * count) == 0)
+		return;
+
+	// Narrow the copy down to the vertices that actually differ.
+	uint32_t first = 0, last = count;
+	while (memcmp(&dst[first], &src[first], sizeof(T)) == 0)
+		first++;
+	while (memcmp(&dst[last - 1], &src[last - 1], sizeof(T)) == 0)
+		last--;
+
+	memcpy(&dst[first], &src[first], sizeof(T) * (last - first));
+	MarkDirty(offset + first, offset + last);
+}
+
+void GS::StreamVertexBuffer::WritePositions(uint32_t offset, const vec3* src, uint32_t count)
+{
+	Write(GetPositions(), offset, src, count);
+}
+
+void GS::StreamVertexBuffer::WriteColors(uint32_t offset, const uint32_t* src, uint32_t count)
+{
+	Write(GetColors(), offset, src, count);
+}
+
+void GS::StreamVertexBuffer::WriteUVs(size_t layer, uint32_t offset, const vec4* src, uint32_t count)
+{
+	Write(GetUVLayer(layer), offset, src, count);
+}
+
+void GS::StreamVertexBuffer::MarkDirty(uint32_t begin, uint32_t end)
+{
+	if (begin >= end)
+		return;
+
+	if (m_dirtyBegin >= m_dirtyEnd) {
+		m_dirtyBegin = begin;
+		m_dirtyEnd   = end;
+	} else {
+		m_dirtyBegin = std::min(m_dirtyBegin, begin);
+		m_dirtyEnd   = std::max(m_dirtyEnd, end);
+	}
+}
+
+bool GS::StreamVertexBuffer::IsDirty() const
+{
+	return m_dirtyBegin < m_dirtyEnd;
+}
+
+gs_vertbuffer_t* GS::StreamVertexBuffer::Update()
+{
+	if (m_size > m_capacity)
+		throw std::out_of_range("size is larger than capacity");
+
+	// Changes past the vertices in use are picked up once the buffer grows over them.
+	if (!IsDirty() || m_dirtyBegin >= m_size)
+		return m_vertexbuffer;
+
+	// Only flush the vertices in use.
+	m_vertexbufferdata = gs_vertexbuffer_get_data(m_vertexbuffer);
+	BindVertexBufferData(m_size);
+
+	obs_enter_graphics();
+	gs_vertexbuffer_flush(m_vertexbuffer);
+	obs_leave_graphics();
+
+	// Keep the full arrays bound so a device rebuild can recreate the buffer.
+	BindVertexBufferData(m_capacity);
+
+	if (m_dirtyEnd > m_size) {
+		m_dirtyBegin = m_size;
+	} else {
+		m_dirtyBegin = m_dirtyEnd = 0;
+	}
+
+	return m_vertexbuffer;
+}
+
+gs_vertbuffer_t* GS::StreamVertexBuffer::Get()
+{
+	return m_vertexbuffer;
+}
+
+void* GS::StreamVertexBuffer::AcquireStream(uint32_t stream, size_t elementSize)
+{
+	if (!(m_streams & stream))
+		return nullptr;
+	return VertexPool::Get().Acquire(elementSize * m_capacity);
+}
+
+void GS::StreamVertexBuffer::ReleaseStream(void* mem, size_t elementSize)
+{
+	VertexPool::Get().Release(mem, elementSize * m_capacity);
+}
+
+void GS::StreamVertexBuffer::SetupVertexBuffer()
+{
+	// Allocate memory for the declared streams.
+	m_positions = static_cast<vec3*>(AcquireStream(STREAM_POSITIONS, sizeof(vec3)));
+	m_normals   = static_cast<vec3*>(AcquireStream(STREAM_NORMALS, sizeof(vec3)));
+	m_tangents  = static_cast<vec3*>(AcquireStream(STREAM_TANGENTS, sizeof(vec3)));
+	m_colors    = static_cast<uint32_t*>(AcquireStream(STREAM_COLORS, sizeof(uint32_t)));
+	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+		m_uvs[n] = static_cast<vec4*>(AcquireStream(STREAM_UVS, sizeof(vec4)));
+	}
+	m_layerdata = nullptr;
+	if (m_streams & STREAM_UVS) {
+		m_layerdata =
+		    static_cast<gs_tvertarray*>(VertexPool::Get().Acquire(sizeof(gs_tvertarray) * MAXIMUM_UVW_LAYERS));
+	}
+
+	// Allocate GPU
+	m_vertexbufferdata = gs_vbdata_create();
+	BindVertexBufferData(m_capacity);
+
+	obs_enter_graphics();
+	m_vertexbuffer = gs_vertexbuffer_create(m_vertexbufferdata, GS_DYNAMIC);
+	obs_leave_graphics();
+
+	if (m_vertexbuffer) {
+		m_vertexbufferdata = gs_vertexbuffer_get_data(m_vertexbuffer);
+		BindVertexBufferData(m_capacity);
+	}
+}
+
+void GS::StreamVertexBuffer::BindVertexBufferData(uint32_t count)
+{
+	memset(m_vertexbufferdata, 0, sizeof(gs_vb_data));
+	m_vertexbufferdata->num      = count;
+	m_vertexbufferdata->points   = m_positions;
+	m_vertexbufferdata->normals  = m_normals;
+	m_vertexbufferdata->tangents = m_tangents;
+	m_vertexbufferdata->colors   = m_colors;
+	if (m_layerdata) {
+		m_vertexbufferdata->num_tex = MAXIMUM_UVW_LAYERS;
+		m_vertexbufferdata->tvarray = m_layerdata;
+		for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+			m_layerdata[n].array = m_uvs[n];
+			m_layerdata[n].width = 4;
+		}
+	}
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include "gs-limits.h"
+extern "C" {
+#pragma warning(push)
+#pragma warning(disable : 4201)
+#include <graphics/graphics.h>
+#pragma warning(pop)
+}
+
+namespace GS
+{
+	enum VertexStreams : uint32_t
+	{
+		STREAM_POSITIONS = 1u << 0,
+		STREAM_NORMALS   = 1u << 1,
+		STREAM_TANGENTS  = 1u << 2,
+		STREAM_COLORS    = 1u << 3,
+		/// MAXIMUM_UVW_LAYERS layers of vec4.
+		STREAM_UVS = 1u << 4,
+	};
+
+	/*!
+	* \brief Dynamic vertex buffer that only holds the streams it is created with.
+	* Storage comes from the shared GS::VertexPool and writes are tracked in a dirty range,
+	* Update() skips the upload entirely while nothing changed and otherwise only uploads
+	* the vertices in use instead of the whole capacity.
+	*/
+	class StreamVertexBuffer
+	{
+		public:
+		/*!
+		* \brief Create a Vertex Buffer with a specific number of Vertices.
+		*
+		* \param maximumVertices Maximum amount of vertices to store.
+		* \param streams Combination of GS::VertexStreams to allocate, must include STREAM_POSITIONS.
+		*/
+		StreamVertexBuffer(uint32_t maximumVertices, uint32_t streams);
+
+		virtual ~StreamVertexBuffer();
+
+		StreamVertexBuffer(StreamVertexBuffer const& other) = delete;
+		void operator=(StreamVertexBuffer const& other) = delete;
+
+		/*!
+		* \brief Change the number of vertices in use.
+		* Growing marks the new vertices as dirty.
+		*/
+		void Resize(uint32_t new_size);
+
+		uint32_t Size() const;
+
+		uint32_t Capacity() const;
+
+		bool Empty() const;
+
+		uint32_t GetStreams() const;
+
+		/*!
+		* \brief Directly access a stream.
+		* Writing through these pointers requires a matching MarkDirty() call.
+		* Throws std::invalid_argument if the stream was not declared.
+		*/
+		vec3*     GetPositions();
+		vec3*     GetNormals();
+		vec3*     GetTangents();
+		uint32_t* GetColors();
+		vec4*     GetUVLayer(size_t idx);
+
+		/*!
+		* \brief Copy into a stream starting at offset.
+		* Only the part that differs from the current content is copied and marked dirty.
+		*/
+		void WritePositions(uint32_t offset, const vec3* src, uint32_t count);
+		void WriteColors(uint32_t offset, const uint32_t* src, uint32_t count);
+		void WriteUVs(size_t layer, uint32_t offset, const vec4* src, uint32_t count);
+
+		/*!
+		* \brief Mark the vertices [begin, end) as modified.
+		*/
+		void MarkDirty(uint32_t begin, uint32_t end);
+
+		bool IsDirty() const;
+
+		/*!
+		* \brief Upload pending changes and return the GPU buffer.
+		* libobs can only flush a buffer from its first vertex, so any change inside the
+		* vertices in use uploads [0, Size()).
+		*/
+		gs_vertbuffer_t* Update();
+
+		/*!
+		* \brief Return the GPU buffer without uploading.
+		*/
+		gs_vertbuffer_t* Get();
+
+		private:
+		void* AcquireStream(uint32_t stream, size_t elementSize);
+		void  ReleaseStream(void* mem, size_t elementSize);
+		void  SetupVertexBuffer();
+		void  BindVertexBufferData(uint32_t count);
+		template<typename T>
+		void Write(T* dst, uint32_t offset, const T* src, uint32_t count);
+
+		private:
+		uint32_t m_size;
+		uint32_t m_capacity;
+		uint32_t m_streams;
+		uint32_t m_dirtyBegin;
+		uint32_t m_dirtyEnd;
+
+		// Memory Storage, null for streams that were not declared.
+		vec3*     m_positions;
+		vec3*     m_normals;
+		vec3*     m_tangents;
+		uint32_t* m_colors;
+		vec4*     m_uvs[MAXIMUM_UVW_LAYERS];
+
+		// OBS GS Data
+		gs_vb_data*      m_vertexbufferdata;
+		gs_vertbuffer_t* m_vertexbuffer;
+		gs_tvertarray*   m_layerdata;
+	};
+} // namespace GS
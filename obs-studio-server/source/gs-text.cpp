@@ -0,0 +1,112 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "gs-text.h"
+#include <stdio.h>
+
+// Glyphs are laid out on a 4x4 grid in the atlas.
+static const float_t GLYPH_UV_SIZE = 1.0f / 4.0f;
+
+static bool GetGlyphUV(char glyph, float_t& uvX, float_t& uvY)
+{
+	static const char* atlas = "1234567890px";
+	for (size_t idx = 0; atlas[idx] != '\0'; idx++) {
+		if (atlas[idx] == glyph) {
+			uvX = GLYPH_UV_SIZE * (idx % 4);
+			uvY = GLYPH_UV_SIZE * (idx / 4);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GS::TextLabel::operator==(const TextLabel& other) const
+{
+	return pixels == other.pixels && size == other.size && x == other.x && y == other.y;
+}
+
+bool GS::TextLabel::operator!=(const TextLabel& other) const
+{
+	return !(*this == other);
+}
+
+GS::TextRunCache::TextRunCache(size_t maximumRuns) : m_maximumRuns(maximumRuns) {}
+
+void GS::TextRunCache::BuildRun(const char* text, float_t size, TextRun& run)
+{
+	run.positions.clear();
+	run.uvs.clear();
+	run.length = 0;
+
+	for (; text[run.length] != '\0'; run.length++) {
+		float_t uvX, uvY;
+		if (!GetGlyphUV(text[run.length], uvX, uvY))
+			continue;
+
+		float_t x = run.length * size;
+		float_t u = uvX + GLYPH_UV_SIZE, v = uvY + GLYPH_UV_SIZE;
+
+		const float_t quad[6][4] = {
+		    {x, 0, uvX, uvY},           // Top Left
+		    {x + size, 0, u, uvY},      // Top Right
+		    {x, size * 2, uvX, v},      // Bottom Left
+		    {x + size, 0, u, uvY},      // Top Right
+		    {x, size * 2, uvX, v},      // Bottom Left
+		    {x + size, size * 2, u, v}, // Bottom Right
+		};
+		for (size_t n = 0; n < 6; n++) {
+			vec3 position;
+			vec4 uv;
+			vec3_set(&position, quad[n][0], quad[n][1], 0);
+			vec4_set(&uv, quad[n][2], quad[n][3], 0, 0);
+			run.positions.push_back(position);
+			run.uvs.push_back(uv);
+		}
+	}
+}
+
+const GS::TextRun& GS::TextRunCache::GetDistanceLabel(uint32_t pixels, float_t size)
+{
+	auto key = std::make_pair(pixels, size);
+	auto it  = m_runs.find(key);
+	if (it != m_runs.end())
+		return it->second;
+
+	char buf[16];
+	snprintf(buf, sizeof(buf), "%u px", pixels);
+
+	TextRun& run = m_runs[key];
+	BuildRun(buf, size, run);
+	return run;
+}
+
+void GS::TextRunCache::Trim()
+{
+	if (m_runs.size() > m_maximumRuns)
+		m_runs.clear();
+}
+
+void GS::TextRunCache::Clear()
+{
+	m_runs.clear();
+}
+
+size_t GS::TextRunCache::Size() const
+{
+	return m_runs.size();
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <map>
+#include <utility>
+#include <vector>
+extern "C" {
+#pragma warning(push)
+#pragma warning(disable : 4201)
+#include <graphics/vec3.h>
+#include <graphics/vec4.h>
+#pragma warning(pop)
+}
+
+namespace GS
+{
+	/*!
+	* \brief Glyph quads for one string, laid out from the origin.
+	* Every printable glyph is two triangles (6 vertices) of size x 2*size,
+	* uvs address the 4x4 glyph atlas in resources/roboto.png.
+	*/
+	struct TextRun
+	{
+		std::vector<vec3> positions;
+		std::vector<vec4> uvs;
+		/// Advance of the run in glyphs, blanks included.
+		size_t length = 0;
+	};
+
+	/*!
+	* \brief Placement of a distance label for one frame.
+	* Two frames with equal labels produce identical text vertices.
+	*/
+	struct TextLabel
+	{
+		uint32_t pixels;
+		float_t  size;
+		float_t  x;
+		float_t  y;
+
+		bool operator==(const TextLabel& other) const;
+		bool operator!=(const TextLabel& other) const;
+	};
+
+	/*!
+	* \brief Cache of prebuilt "N px" glyph runs keyed by (pixels, size).
+	* Does not touch the graphics subsystem.
+	*/
+	class TextRunCache
+	{
+		public:
+		TextRunCache(size_t maximumRuns = 256);
+
+		/*!
+		* \brief Lay out text at the origin, glyphs advance by size along x.
+		* Characters missing from the atlas only advance.
+		*/
+		static void BuildRun(const char* text, float_t size, TextRun& run);
+
+		/*!
+		* \brief Get the run for the label "<pixels> px", building it on first use.
+		* The reference stays valid until the next call to Trim or Clear.
+		*/
+		const TextRun& GetDistanceLabel(uint32_t pixels, float_t size);
+
+		/*!
+		* \brief Drop every run if the cache grew past its limit.
+		* Call between frames, never while references are held.
+		*/
+		void Trim();
+
+		void   Clear();
+		size_t Size() const;
+
+		private:
+		std::map<std::pair<uint32_t, float_t>, TextRun> m_runs;
+		size_t                                          m_maximumRuns;
+	};
+} // namespace GS
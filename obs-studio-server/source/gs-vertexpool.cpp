@@ -0,0 +1,98 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "gs-vertexpool.h"
+#include <cstring>
+#include <new>
+#include "util-memory.h"
+
+// Smallest block handed out, 2^8 bytes.
+static const size_t MINIMUM_CLASS = 8;
+// Largest pooled block, 2^28 bytes covers MAXIMUM_VERTICES of vec4. Larger blocks bypass the pool.
+static const size_t MAXIMUM_CLASS = 28;
+// Released blocks kept per size class, anything above is freed right away.
+static const size_t BLOCKS_PER_CLASS = 8;
+
+GS::VertexPool& GS::VertexPool::Get()
+{
+	static VertexPool pool;
+	return pool;
+}
+
+GS::VertexPool::~VertexPool()
+{
+	Clear();
+}
+
+bool GS::VertexPool::GetSizeClass(size_t size, size_t& sizeClass, size_t& blockSize)
+{
+	for (sizeClass = MINIMUM_CLASS; sizeClass <= MAXIMUM_CLASS; sizeClass++) {
+		blockSize = size_t(1) << sizeClass;
+		if (blockSize >= size)
+			return true;
+	}
+	blockSize = size;
+	return false;
+}
+
+void* GS::VertexPool::Acquire(size_t size)
+{
+	size_t sizeClass, blockSize;
+	void*  mem = nullptr;
+	if (GetSizeClass(size, sizeClass, blockSize)) {
+		std::unique_lock<std::mutex> ulock(m_lock);
+		if (!m_free[sizeClass].empty()) {
+			mem = m_free[sizeClass].back();
+			m_free[sizeClass].pop_back();
+		}
+	}
+
+	if (!mem) {
+		mem = util::malloc_aligned(16, blockSize);
+		if (!mem)
+			throw std::bad_alloc();
+	}
+	memset(mem, 0, blockSize);
+	return mem;
+}
+
+void GS::VertexPool::Release(void* mem, size_t size)
+{
+	if (!mem)
+		return;
+
+	size_t sizeClass, blockSize;
+	if (GetSizeClass(size, sizeClass, blockSize)) {
+		std::unique_lock<std::mutex> ulock(m_lock);
+		if (m_free[sizeClass].size() < BLOCKS_PER_CLASS) {
+			m_free[sizeClass].push_back(mem);
+			return;
+		}
+	}
+	util::free_aligned(mem);
+}
+
+void GS::VertexPool::Clear()
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+	for (std::vector<void*>& blocks : m_free) {
+		for (void* mem : blocks)
+			util::free_aligned(mem);
+		blocks.clear();
+	}
+}
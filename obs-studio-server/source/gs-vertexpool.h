@@ -0,0 +1,61 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <mutex>
+#include <vector>
+
+namespace GS
+{
+	/*!
+	* \brief Process wide pool of aligned vertex storage.
+	* Blocks are rounded up to power of two size classes and kept on a free list when released,
+	* so displays that come and go reuse the same memory instead of hitting the allocator.
+	*/
+	class VertexPool
+	{
+		public:
+		static VertexPool& Get();
+
+		~VertexPool();
+
+		/*!
+		* \brief Get a zeroed, 16 byte aligned block of at least size bytes.
+		*/
+		void* Acquire(size_t size);
+
+		/*!
+		* \brief Return a block obtained from Acquire with the same size.
+		*/
+		void Release(void* mem, size_t size);
+
+		/*!
+		* \brief Free every cached block.
+		*/
+		void Clear();
+
+		private:
+		VertexPool() = default;
+
+		static bool GetSizeClass(size_t size, size_t& sizeClass, size_t& blockSize);
+
+		std::mutex         m_lock;
+		std::vector<void*> m_free[32];
+	};
+} // namespace GS
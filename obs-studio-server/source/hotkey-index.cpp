@@ -0,0 +1,220 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "hotkey-index.h"
+#include <algorithm>
+#include <obs.hpp>
+#include <util/platform.h>
+
+// Removals remembered for delta queries, clients that fall further behind get a full list.
+static const size_t MAXIMUM_REMOVED = 4096;
+
+void HotkeyIndex::Initialize()
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+	if (m_connected)
+		return;
+
+	signal_handler_t* sh = obs_get_signal_handler();
+	signal_handler_connect(sh, "hotkey_register", HotkeyIndex::OnHotkeyRegister, this);
+	signal_handler_connect(sh, "hotkey_unregister", HotkeyIndex::OnHotkeyUnregister, this);
+	signal_handler_connect(sh, "source_rename", HotkeyIndex::OnSourceRename, this);
+	m_connected = true;
+
+	// Generations of a previous server instance must never look current to a client.
+	m_generation = m_horizon = std::max(m_generation, os_gettime_ns());
+	ulock.unlock();
+
+	// Hotkeys registered before the signals were connected.
+	obs_enum_hotkeys(
+	    [](void* data, obs_hotkey_id id, obs_hotkey_t* key) {
+		    static_cast<HotkeyIndex*>(data)->Add(key);
+		    return true;
+	    },
+	    this);
+}
+
+void HotkeyIndex::Finalize()
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+	if (!m_connected)
+		return;
+
+	signal_handler_t* sh = obs_get_signal_handler();
+	signal_handler_disconnect(sh, "hotkey_register", HotkeyIndex::OnHotkeyRegister, this);
+	signal_handler_disconnect(sh, "hotkey_unregister", HotkeyIndex::OnHotkeyUnregister, this);
+	signal_handler_disconnect(sh, "source_rename", HotkeyIndex::OnSourceRename, this);
+	m_connected = false;
+
+	m_entries.clear();
+	m_removed.clear();
+	m_horizon = ++m_generation;
+}
+
+uint64_t HotkeyIndex::Query(
+    uint64_t                    since,
+    std::vector<Entry>&         changed,
+    std::vector<obs_hotkey_id>& removed,
+    bool&                       full)
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+
+	full = (since == 0) || (since < m_horizon) || (since > m_generation);
+	changed.reserve(full ? m_entries.size() : 0);
+	for (auto& kv : m_entries) {
+		if (full || kv.second.generation > since)
+			changed.push_back(kv.second);
+	}
+	if (!full) {
+		for (auto& kv : m_removed) {
+			if (kv.second > since)
+				removed.push_back(kv.first);
+		}
+	}
+	return m_generation;
+}
+
+void HotkeyIndex::OnHotkeyRegister(void* data, calldata_t* cd)
+{
+	obs_hotkey_t* key = static_cast<obs_hotkey_t*>(calldata_ptr(cd, "key"));
+	if (key)
+		static_cast<HotkeyIndex*>(data)->Add(key);
+}
+
+void HotkeyIndex::OnHotkeyUnregister(void* data, calldata_t* cd)
+{
+	obs_hotkey_t* key = static_cast<obs_hotkey_t*>(calldata_ptr(cd, "key"));
+	if (key)
+		static_cast<HotkeyIndex*>(data)->Remove(obs_hotkey_get_id(key));
+}
+
+void HotkeyIndex::OnSourceRename(void* data, calldata_t* cd)
+{
+	obs_source_t* source = static_cast<obs_source_t*>(calldata_ptr(cd, "source"));
+	const char*   name   = calldata_string(cd, "new_name");
+	if (!source || !name)
+		return;
+
+	obs_weak_source_t* weak = obs_source_get_weak_source(source);
+	static_cast<HotkeyIndex*>(data)->Rename(weak, name);
+	obs_weak_source_release(weak);
+}
+
+bool HotkeyIndex::BuildEntry(obs_hotkey_t* key, Entry& entry)
+{
+	auto  registerer_type = obs_hotkey_get_registerer_type(key);
+	void* registerer      = obs_hotkey_get_registerer(key);
+	if (registerer == nullptr)
+		return false;
+
+	// Discover the type of object registered with this hotkey
+	const char* objectName = nullptr;
+	switch (registerer_type) {
+	case OBS_HOTKEY_REGISTERER_SOURCE: {
+		auto key_source = OBSGetStrongRef(static_cast<obs_weak_source_t*>(registerer));
+		if (key_source == nullptr)
+			return false;
+		objectName = obs_source_get_name(key_source);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_OUTPUT: {
+		auto key_output = OBSGetStrongRef(static_cast<obs_weak_output_t*>(registerer));
+		if (key_output == nullptr)
+			return false;
+		objectName = obs_output_get_name(key_output);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_ENCODER: {
+		auto key_encoder = OBSGetStrongRef(static_cast<obs_weak_encoder_t*>(registerer));
+		if (key_encoder == nullptr)
+			return false;
+		objectName = obs_encoder_get_name(key_encoder);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_SERVICE: {
+		auto key_service = OBSGetStrongRef(static_cast<obs_weak_service_t*>(registerer));
+		if (key_service == nullptr)
+			return false;
+		objectName = obs_service_get_name(key_service);
+		break;
+	}
+	default:
+		// Ignore any frontend hotkey
+		return false;
+	}
+
+	// Key defs
+	const char* _key_name = obs_hotkey_get_name(key);
+	const char* _desc     = obs_hotkey_get_description(key);
+	if (!_key_name)
+		return false;
+
+	entry.objectName = objectName ? objectName : "";
+	entry.objectType = registerer_type;
+	entry.hotkeyName = _key_name;
+	entry.hotkeyDesc = _desc ? _desc : "";
+	entry.hotkeyId   = obs_hotkey_get_id(key);
+	entry.registerer = registerer;
+
+	// Parse the key name and the description
+	std::string& key_name = entry.hotkeyName;
+	key_name              = key_name.substr(key_name.find_first_of(".") + 1);
+	std::replace(key_name.begin(), key_name.end(), '-', '_');
+	std::transform(key_name.begin(), key_name.end(), key_name.begin(), ::toupper);
+	std::replace(entry.hotkeyDesc.begin(), entry.hotkeyDesc.end(), '-', ' ');
+	return true;
+}
+
+void HotkeyIndex::Add(obs_hotkey_t* key)
+{
+	Entry entry;
+	if (!BuildEntry(key, entry))
+		return;
+
+	std::unique_lock<std::mutex> ulock(m_lock);
+	entry.generation = ++m_generation;
+	m_removed.erase(entry.hotkeyId);
+	m_entries[entry.hotkeyId] = std::move(entry);
+}
+
+void HotkeyIndex::Remove(obs_hotkey_id id)
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+	if (m_entries.erase(id) == 0)
+		return;
+
+	m_removed[id] = ++m_generation;
+	if (m_removed.size() > MAXIMUM_REMOVED) {
+		m_removed.clear();
+		m_horizon = m_generation;
+	}
+}
+
+void HotkeyIndex::Rename(void* registerer, const char* name)
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+	uint64_t                     generation = 0;
+	for (auto& kv : m_entries) {
+		if (kv.second.registerer != registerer)
+			continue;
+		if (generation == 0)
+			generation = ++m_generation;
+		kv.second.objectName = name;
+		kv.second.generation = generation;
+	}
+}
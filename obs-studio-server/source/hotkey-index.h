@@ -0,0 +1,92 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <obs.h>
+
+/*!
+* \brief Index of every non frontend hotkey, kept up to date from the libobs
+* hotkey_register/hotkey_unregister and source_rename signals.
+* Display names are computed once per hotkey, every change bumps a generation
+* counter so clients can ask for the changes since the last generation they saw.
+*/
+class HotkeyIndex
+{
+	public:
+	struct Entry
+	{
+		std::string                objectName;
+		obs_hotkey_registerer_type objectType;
+		std::string                hotkeyName;
+		std::string                hotkeyDesc;
+		obs_hotkey_id              hotkeyId;
+		void*                      registerer;
+		uint64_t                   generation;
+	};
+
+	static HotkeyIndex& GetInstance()
+	{
+		static HotkeyIndex instance;
+		return instance;
+	}
+
+	HotkeyIndex(HotkeyIndex const&) = delete;
+	void operator=(HotkeyIndex const&) = delete;
+
+	/*!
+	* \brief Connect to the libobs signals and index the hotkeys that already exist.
+	* Requires obs_startup to have succeeded.
+	*/
+	void Initialize();
+	void Finalize();
+
+	/*!
+	* \brief Collect the changes after generation since.
+	* If since is 0, older than the retained removals or unknown to this index,
+	* changed receives every hotkey, removed stays empty and full is set.
+	*
+	* \return The current generation.
+	*/
+	uint64_t Query(uint64_t since, std::vector<Entry>& changed, std::vector<obs_hotkey_id>& removed, bool& full);
+
+	private:
+	HotkeyIndex() = default;
+
+	static void OnHotkeyRegister(void* data, calldata_t* cd);
+	static void OnHotkeyUnregister(void* data, calldata_t* cd);
+	static void OnSourceRename(void* data, calldata_t* cd);
+
+	static bool BuildEntry(obs_hotkey_t* key, Entry& entry);
+
+	void Add(obs_hotkey_t* key);
+	void Remove(obs_hotkey_id id);
+	void Rename(void* registerer, const char* name);
+
+	private:
+	std::mutex                        m_lock;
+	bool                              m_connected = false;
+	std::map<obs_hotkey_id, Entry>    m_entries;
+	std::map<obs_hotkey_id, uint64_t> m_removed;
+	uint64_t                          m_generation = 0;
+	// Oldest generation that a delta can be built from.
+	uint64_t m_horizon = 0;
+};
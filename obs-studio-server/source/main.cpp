@@ -24,14 +24,18 @@
 #include <ipc-function.hpp>
 #include <ipc-server.hpp>
 #include <memory>
+#include <sstream>
 #include <thread>
 #include <vector>
 #include "error.hpp"
+#include "ipc-registry.hpp"
+#include "server-readiness.hpp"
 #include "nodeobs_api.h"
 #include "nodeobs_autoconfig.h"
 #include "nodeobs_content.h"
 #include "nodeobs_service.h"
 #include "nodeobs_settings.h"
+#include "osn-collection.hpp"
 #include "osn-fader.hpp"
 #include "osn-filter.hpp"
 #include "osn-global.hpp"
@@ -63,9 +67,18 @@ return OSN_VERSION; \
 }()
 
 
-#ifdef __APPLE__
+#ifdef WIN32
+#include <windows.h>
+#else
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif
 
 #if defined(_WIN32)
 #include "Shlobj.h"
@@ -111,6 +124,21 @@ extern "C" __declspec(dllexport) DWORD NvOptimusEnablement = [] {
 
 #define BUFFSIZE 512
 
+// Time without any connected client after which the server shuts itself down.
+static const std::chrono::milliseconds IDLE_SHUTDOWN_TIMEOUT(5000);
+
+#ifdef __linux__
+// eventfd the main loop sleeps on; anything that may end the loop writes to it.
+static int mainLoopWakeFd = -1;
+
+static void WakeMainLoop()
+{
+	uint64_t one = 1;
+	if (mainLoopWakeFd != -1 && write(mainLoopWakeFd, &one, sizeof(one)) != sizeof(one))
+		std::cerr << "Failed to wake the main loop." << std::endl;
+}
+#endif
+
 struct ServerData
 {
 	std::mutex                                     mtx;
@@ -124,6 +152,9 @@ bool ServerConnectHandler(void* data, int64_t)
 	std::unique_lock<std::mutex> ulock(sd->mtx);
 	sd->last_connect = std::chrono::high_resolution_clock::now();
 	sd->count_connected++;
+#ifdef __linux__
+	WakeMainLoop();
+#endif
 	return true;
 }
 
@@ -133,6 +164,9 @@ void ServerDisconnectHandler(void* data, int64_t)
 	std::unique_lock<std::mutex> ulock(sd->mtx);
 	sd->last_disconnect = std::chrono::high_resolution_clock::now();
 	sd->count_connected--;
+#ifdef __linux__
+	WakeMainLoop();
+#endif
 }
 
 namespace System
@@ -145,17 +179,59 @@ namespace System
 #ifdef __APPLE__
 		g_util_osx->stopApplication();
 #endif
+#ifdef __linux__
+		WakeMainLoop();
+#endif
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		return;
+	}
+
+	static void GetRegistryDigest(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval)
+	{
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		rval.push_back(ipc::value(ipc_registry::digest));
 		return;
 	}
 } // namespace System
 
+// Tell the client that spawned us that the socket accepts connections.
+static void SignalReady(const std::string& uri)
+{
+#ifdef WIN32
+	HANDLE event = OpenEventA(EVENT_MODIFY_STATE, FALSE, readiness::EventName(uri).c_str());
+	if (event) {
+		SetEvent(event);
+		CloseHandle(event);
+	}
+#else
+	const char* fd = getenv(readiness::FdEnvironmentVariable);
+	if (fd) {
+		int  readyFd = atoi(fd);
+		char ready   = 1;
+		if (write(readyFd, &ready, 1) != 1)
+			std::cerr << "Failed to signal readiness to the client." << std::endl;
+		close(readyFd);
+
+		// The descriptor is closed, processes we spawn must not inherit its number.
+		unsetenv(readiness::FdEnvironmentVariable);
+	}
+#endif
+}
+
 int main(int argc, char* argv[])
 {
 #ifdef __APPLE__
 	g_util_osx = new UtilInt();
 	g_util_osx->init();
 #endif
+	using startup_clock = std::chrono::steady_clock;
+	std::vector<std::pair<const char*, startup_clock::time_point>> startupPhases;
+	startupPhases.emplace_back("start", startup_clock::now());
+
 	std::string socketPath      = "";
 	std::string receivedVersion = "";
 #ifdef __APPLE__
@@ -184,6 +260,8 @@ int main(int argc, char* argv[])
 		return ipc::ProcessInfo::ExitCode::VERSION_MISMATCH;
 	}
 
+	startupPhases.emplace_back("arguments", startup_clock::now());
+
 	// Usage:
 	// argv[0] = Path to this application. (Usually given by default if run via path-based command!)
 	// argv[1] = Path to a named socket.
@@ -199,9 +277,11 @@ int main(int argc, char* argv[])
 	// Classes
 	/// System
 	{
-		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("System");
+		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>(ipc_registry::System::Name);
 		cls->register_function(
-		    std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
+		    ipc_registry::make_function(ipc_registry::System::Shutdown, System::Shutdown, &doShutdown));
+		cls->register_function(
+		    ipc_registry::make_function(ipc_registry::System::GetRegistryDigest, System::GetRegistryDigest));
 		myServer.register_collection(cls);
 	};
 
@@ -218,6 +298,7 @@ int main(int argc, char* argv[])
 	osn::Properties::Register(myServer);
 	osn::Video::Register(myServer);
 	osn::Module::Register(myServer);
+	osn::Collection::Register(myServer);
 	CallbackManager::Register(myServer);
 	OBS_API::Register(myServer);
 	OBS_content::Register(myServer);
@@ -226,7 +307,15 @@ int main(int argc, char* argv[])
 	OBS_settings::Register(myServer);
 	autoConfig::Register(myServer);
 
+	startupPhases.emplace_back("register", startup_clock::now());
+
 	OBS_API::CreateCrashHandlerExitPipe();
+	startupPhases.emplace_back("crash handler pipe", startup_clock::now());
+
+#ifdef __linux__
+	// Must exist before the server accepts its first connection
+	mainLoopWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#endif
 
 	// Register Connect/Disconnect Handlers
 	myServer.set_connect_handler(ServerConnectHandler, &sd);
@@ -243,6 +332,28 @@ int main(int argc, char* argv[])
 		return ipc::ProcessInfo::ExitCode::OTHER_ERROR;
 	}
 
+	startupPhases.emplace_back("listen", startup_clock::now());
+
+	// Handed over before signalling readiness, OBS_API_initAPI can follow right away.
+	{
+		std::stringstream breakdown;
+		breakdown << "Startup:";
+		for (size_t i = 1; i < startupPhases.size(); i++) {
+			breakdown << " " << startupPhases[i].first << " "
+			          << std::chrono::duration_cast<std::chrono::microseconds>(
+			                 startupPhases[i].second - startupPhases[i - 1].second)
+			                     .count()
+			          << "us,";
+		}
+		breakdown << " total "
+		          << std::chrono::duration_cast<std::chrono::microseconds>(
+		                 startupPhases.back().second - startupPhases.front().second)
+		                 .count()
+		          << "us";
+		OBS_API::SetProcessStartup(breakdown.str());
+	}
+	SignalReady(argv[1]);
+
 	// Reset Connect/Disconnect time.
 	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
 
@@ -257,7 +368,7 @@ int main(int argc, char* argv[])
 		if (sd.count_connected == 0) {
 			auto tp    = std::chrono::high_resolution_clock::now();
 			auto delta = tp - sd.last_disconnect;
-			if (std::chrono::duration_cast<std::chrono::milliseconds>(delta).count() > 5000) {
+			if (std::chrono::duration_cast<std::chrono::milliseconds>(delta) > IDLE_SHUTDOWN_TIMEOUT) {
 				doShutdown = true;
 				waitBeforeClosing = true;
 			}
@@ -269,6 +380,69 @@ int main(int argc, char* argv[])
 	// before going further with shutdown. It needed for usecase where obs64 process stay alive and 
 	// continue streaming till user confirms exit in crash-handler.
 	OBS_API::WaitCrashHandlerClose(waitBeforeClosing);
+#endif
+#ifdef __linux__
+	// Sleeps until System.Shutdown, a client (dis)connecting, or the idle timer
+	// firing. The timer is only armed while no client is connected. If any of the
+	// descriptors can't be set up the loop polls every 50ms instead.
+	int  epollFd = epoll_create1(EPOLL_CLOEXEC);
+	int  timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+	bool evented = epollFd != -1 && timerFd != -1 && mainLoopWakeFd != -1;
+	for (int fd : {mainLoopWakeFd, timerFd}) {
+		if (!evented)
+			break;
+
+		epoll_event ev = {};
+		ev.events      = EPOLLIN;
+		ev.data.fd     = fd;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0)
+			evented = false;
+	}
+	if (!evented)
+		blog(LOG_WARNING, "Failed to set up the main loop descriptors (%s), polling instead.", strerror(errno));
+
+	while (!doShutdown) {
+		std::chrono::nanoseconds idleRemaining(0);
+		bool                     idle = false;
+		{
+			std::unique_lock<std::mutex> ulock(sd.mtx);
+			if (sd.count_connected == 0) {
+				idle          = true;
+				idleRemaining = IDLE_SHUTDOWN_TIMEOUT
+				                - (std::chrono::high_resolution_clock::now() - sd.last_disconnect);
+			}
+		}
+
+		if (idle && idleRemaining.count() <= 0) {
+			doShutdown = true;
+			break;
+		}
+
+		if (!evented) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			continue;
+		}
+
+		itimerspec timer = {};
+		if (idle) {
+			timer.it_value.tv_sec  = time_t(idleRemaining.count() / 1000000000);
+			timer.it_value.tv_nsec = long(idleRemaining.count() % 1000000000);
+		}
+		timerfd_settime(timerFd, 0, &timer, nullptr);
+
+		epoll_event events[2];
+		int         count = epoll_wait(epollFd, events, 2, -1);
+		for (int i = 0; i < count; i++) {
+			uint64_t value;
+			while (read(events[i].data.fd, &value, sizeof(value)) == sizeof(value)) {
+			}
+		}
+	}
+
+	if (timerFd != -1)
+		close(timerFd);
+	if (epollFd != -1)
+		close(epollFd);
 #endif
 	osn::Source::finalize_global_signals();
 	OBS_API::destroyOBS_API();
@@ -276,5 +450,11 @@ int main(int argc, char* argv[])
 	// Finalize Server
 	myServer.finalize();
 
+#ifdef __linux__
+	if (mainLoopWakeFd != -1)
+		close(mainLoopWakeFd);
+	mainLoopWakeFd = -1;
+#endif
+
 	return 0;
 }
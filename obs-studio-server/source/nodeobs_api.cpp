@@ -25,10 +25,15 @@
 #include "osn-filter.hpp"
 #include "osn-volmeter.hpp"
 #include "osn-fader.hpp"
+#include "osn-module.hpp"
 #include "nodeobs_autoconfig.h"
+#include "nodeobs_content.h"
+#include "callback-manager.h"
+#include "hotkey-index.h"
 #include "util/lexer.h"
 #include "util-crashmanager.h"
 #include "util-metricsprovider.h"
+#include "util-startuptrace.h"
 
 #include <sys/types.h>
 
@@ -102,6 +107,8 @@ std::mutex                                             logMutex;
 std::string                                            currentVersion;
 std::string                                            username("unknown");
 std::chrono::high_resolution_clock::time_point         start_wait_acknowledge;
+std::mutex                                             processStartupMutex;
+std::string                                            processStartup;
 
 ipc::server* g_server = nullptr;
 
@@ -122,6 +129,8 @@ void OBS_API::Register(ipc::server& srv)
 	cls->register_function(
 	    std::make_shared<ipc::function>("StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_QueryHotkeys", std::vector<ipc::type>{}, QueryHotkeys));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_QueryHotkeysDelta", std::vector<ipc::type>{ipc::type::UInt64}, QueryHotkeysDelta));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_API_ProcessHotkeyStatus",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32},
@@ -626,6 +635,27 @@ void OBS_API::OBS_API_initAPI(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	util::StartupTrace& startupTrace = util::StartupTrace::GetInstance();
+	startupTrace.Begin();
+
+	auto                      initScope = std::make_unique<util::StartupTrace::Scope>("init", "OBS_API_initAPI");
+	util::StartupTrace::Phase phase("init");
+
+	// Stops recording and returns the trace, also writing it out when
+	// OSN_STARTUP_TRACE names a file.
+	auto finishStartupTrace = [&]() {
+		phase.End();
+		initScope.reset();
+		startupTrace.End();
+
+		const char* tracePath = getenv("OSN_STARTUP_TRACE");
+		if (tracePath && *tracePath && !startupTrace.WriteChromeTrace(tracePath))
+			blog(LOG_WARNING, "Failed to write startup trace to %s", tracePath);
+
+		return startupTrace.ToChromeTrace();
+	};
+
+	phase.Next("crash handler registration");
 	writeCrashHandler(registerProcess());
 
 	/* Map base DLLs as soon as possible into the current process space.
@@ -642,6 +672,7 @@ void OBS_API::OBS_API_initAPI(
 	util::CrashManager::SetVersionName(currentVersion);
 
 
+	phase.Next("crash manager");
 #ifdef ENABLE_CRASHREPORT
    util::CrashManager crashManager;
 	char* path = g_moduleDirectory.data();
@@ -666,11 +697,19 @@ void OBS_API::OBS_API_initAPI(
 #endif
 #endif
 
+	phase.Next("metrics provider");
 #ifdef WIN32
 	// Connect the metrics provider with our crash handler process, sending our current version tag
 	// and enabling metrics
-	util::CrashManager::GetMetricsProvider()->Initialize("\\\\.\\pipe\\metrics_pipe", currentVersion, false);
+	util::CrashManager::GetMetricsProvider()->Initialize("\\\\.\\pipe\\metrics_pipe", currentVersion, true);
+#else
+	// Nothing listens for metrics here unless a crash handler was started for this process,
+	// so only connect when OSN_METRICS_SOCKET names its socket.
+	const char* metricsSocket = getenv("OSN_METRICS_SOCKET");
+	if (metricsSocket && *metricsSocket)
+		util::CrashManager::GetMetricsProvider()->Initialize(metricsSocket, currentVersion, true);
 #endif
+	phase.Next("obs_startup");
 	obs_add_data_path((g_moduleDirectory + "/data/libobs/").c_str());
 	slobs_plugin = appdata.substr(0, appdata.size() - strlen("/slobs-client"));
 	slobs_plugin.append("/slobs-plugins");
@@ -690,6 +729,7 @@ void OBS_API::OBS_API_initAPI(
 	}
 
 	/* Logging */
+	phase.Next("logging");
 	std::string filename = GenerateTimeDateFilename("txt");
 	std::string log_path = appdata;
 	log_path.append("/node-obs/logs/");
@@ -726,12 +766,22 @@ void OBS_API::OBS_API_initAPI(
 	}, nullptr);
 #endif
 
+	{
+		std::unique_lock<std::mutex> ulock(processStartupMutex);
+		if (!processStartup.empty())
+			blog(LOG_INFO, "%s", processStartup.c_str());
+		processStartup.clear();
+	}
+
 #ifdef _WIN32
 	SetPrivilegeForGPUPriority();
 #endif
 
+	phase.Next("signals and hotkeys");
 	osn::Source::initialize_global_signals();
+	HotkeyIndex::GetInstance().Initialize();
 
+	phase.Next("global config");
 	cpuUsageInfo = os_cpu_usage_info_start();
 	ConfigManager::getInstance().setAppdataPath(appdata);
 
@@ -742,6 +792,7 @@ void OBS_API::OBS_API_initAPI(
 	obs_apply_private_data(private_settings);
 	obs_data_release(private_settings);
 
+	phase.Next("modules");
 	int videoError;
 	if (!openAllModules(videoError)) {
 #ifdef WIN32
@@ -750,11 +801,13 @@ void OBS_API::OBS_API_initAPI(
 		blog(LOG_INFO, "Error returning now");
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
 		rval.push_back(ipc::value(videoError));
+		rval.push_back(ipc::value(finishStartupTrace()));
 		AUTO_DEBUG;
 		return;
 #endif
 	}
 
+	phase.Next("amf fallback");
 	if(!OBS_service::EncoderAvailable(SIMPLE_ENCODER_AMD)) {
 		obs_module_t *module;
 		std::string module_path = g_moduleDirectory + "/enc-amf_old/obs-plugins/64bit/enc-amf";
@@ -765,21 +818,28 @@ void OBS_API::OBS_API_initAPI(
 			obs_init_module(module);
 	}
 
+	phase.Next("service and outputs");
 	OBS_service::createService();
 	OBS_service::createStreamingOutput();
 	OBS_service::createRecordingOutput();
 	OBS_service::createReplayBufferOutput();
 
+	phase.Next("encoders");
 	OBS_service::createVideoStreamingEncoder();
 	OBS_service::createVideoRecordingEncoder();
 
+	phase.Next("audio and video reset");
 	OBS_service::resetAudioContext();
 	OBS_service::resetVideoContext();
 
+	phase.Next("audio encoder");
 	OBS_service::setupAudioEncoder();
 
+	phase.Next("audio monitoring");
 	setAudioDeviceMonitoring();
 
+	phase.Next("replay buffer mode");
+
 	// Enable the hotkey callback rerouting that will be used when manually handling hotkeys on the frontend
 	obs_hotkey_enable_callback_rerouting(true);
 
@@ -804,6 +864,7 @@ void OBS_API::OBS_API_initAPI(
 	// initialized the Dx11 API
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(OBS_VIDEO_SUCCESS));
+	rval.push_back(ipc::value(finishStartupTrace()));
 
 	AUTO_DEBUG;
 }
@@ -850,130 +911,59 @@ void OBS_API::OBS_API_getPerformanceStatistics(
 	rval.push_back(ipc::value(getAverageTimeToRenderFrame()));
 	rval.push_back(ipc::value(getMemoryUsage()));
 	rval.push_back(ipc::value(getDiskSpaceAvailable()));
+	rval.push_back(ipc::value(OBS_service::getRecordingStartLatency()));
+	rval.push_back(ipc::value(uint32_t(OBS_service::getRecordingStartWasArmed())));
 	AUTO_DEBUG;
 }
 
+static void PushHotkeyEntry(std::vector<ipc::value>& rval, const HotkeyIndex::Entry& hotkeyInfo)
+{
+	rval.push_back(ipc::value(hotkeyInfo.objectName));
+	rval.push_back(ipc::value(uint32_t(hotkeyInfo.objectType)));
+	rval.push_back(ipc::value(hotkeyInfo.hotkeyName));
+	rval.push_back(ipc::value(hotkeyInfo.hotkeyDesc));
+	rval.push_back(ipc::value(uint64_t(hotkeyInfo.hotkeyId)));
+}
+
 void OBS_API::QueryHotkeys(
     void*                          data,
     const int64_t                  id,
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	struct HotkeyInfo
-	{
-		std::string                objectName;
-		obs_hotkey_registerer_type objectType;
-		std::string                hotkeyName;
-		std::string                hotkeyDesc;
-		obs_hotkey_id              hotkeyId;
-	};
-
-	// For each registered hotkey
-	std::vector<HotkeyInfo> hotkeyInfos;
-	obs_enum_hotkeys(
-	    [](void* data, obs_hotkey_id id, obs_hotkey_t* key) {
-		    // Make sure every word has an initial capital letter
-		    auto ToTitle = [](std::string s) {
-			    bool last = true;
-			    for (char& c : s) {
-				    int full_c = (uint8_t)c;
-				    full_c     = last ? ::toupper(full_c) : ::tolower(full_c);
-				    last       = ::isspace(full_c);
-			    }
-			    return s;
-		    };
-		    std::vector<HotkeyInfo>& hotkeyInfos     = *static_cast<std::vector<HotkeyInfo>*>(data);
-		    auto                     registerer_type = obs_hotkey_get_registerer_type(key);
-		    void*                    registerer      = obs_hotkey_get_registerer(key);
-		    HotkeyInfo               currentHotkeyInfo;
-		    if (registerer == nullptr)
-			    return true;
-
-		    // Discover the type of object registered with this hotkey
-		    switch (registerer_type) {
-		    case OBS_HOTKEY_REGISTERER_FRONTEND: {
-			    // Ignore any frontend hotkey
-			    return true;
-			    break;
-		    }
-		    case OBS_HOTKEY_REGISTERER_SOURCE: {
-			    auto* weak_source            = static_cast<obs_weak_source_t*>(registerer);
-			    auto  key_source             = OBSGetStrongRef(weak_source);
-			    if (key_source == nullptr)
-				    return true;
-			    currentHotkeyInfo.objectName = obs_source_get_name(key_source);
-			    currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_SOURCE;
-			    break;
-		    }
-		    case OBS_HOTKEY_REGISTERER_OUTPUT: {
-			    auto* weak_output            = static_cast<obs_weak_output_t*>(registerer);
-			    auto  key_output             = OBSGetStrongRef(weak_output);
-			    if (key_output == nullptr)
-				    return true;
-			    currentHotkeyInfo.objectName = obs_output_get_name(key_output);
-			    currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_OUTPUT;
-			    break;
-		    }
-		    case OBS_HOTKEY_REGISTERER_ENCODER: {
-			    auto* weak_encoder           = static_cast<obs_weak_encoder_t*>(registerer);
-			    auto  key_encoder            = OBSGetStrongRef(weak_encoder);
-			    if (key_encoder == nullptr)
-				    return true;
-			    currentHotkeyInfo.objectName = obs_encoder_get_name(key_encoder);
-			    currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_ENCODER;
-			    break;
-		    }
-		    case OBS_HOTKEY_REGISTERER_SERVICE: {
-			    auto* weak_service           = static_cast<obs_weak_service_t*>(registerer);
-			    auto  key_service            = OBSGetStrongRef(weak_service);
-			    if (key_service == nullptr)
-				    return true;
-			    currentHotkeyInfo.objectName = obs_service_get_name(key_service);
-			    currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_SERVICE;
-			    break;
-		    }
-		    }
-
-		    // Key defs
-		    const char* _key_name = obs_hotkey_get_name(key);
-		    const char* _desc     = obs_hotkey_get_description(key);
-
-		    if (!_key_name)
-			    return true;
-
-		    if (!_desc)
-			    _desc = "";
-
-		    auto       key_name = std::string(_key_name);
-		    auto       desc     = std::string(_desc);
-		    const auto hotkeyId = obs_hotkey_get_id(key);
-
-		    // Parse the key name and the description
-		    key_name = key_name.substr(key_name.find_first_of(".") + 1);
-		    std::replace(key_name.begin(), key_name.end(), '-', '_');
-		    std::transform(key_name.begin(), key_name.end(), key_name.begin(), ::toupper);
-		    std::replace(desc.begin(), desc.end(), '-', ' ');
-		    desc = ToTitle(desc);
-
-		    currentHotkeyInfo.hotkeyName = key_name;
-		    currentHotkeyInfo.hotkeyDesc = desc;
-		    currentHotkeyInfo.hotkeyId   = hotkeyId;
-		    hotkeyInfos.push_back(currentHotkeyInfo);
-
-		    return true;
-	    },
-	    &hotkeyInfos);
+	std::vector<HotkeyIndex::Entry> hotkeyInfos;
+	std::vector<obs_hotkey_id>      removed;
+	bool                            full;
+	HotkeyIndex::GetInstance().Query(0, hotkeyInfos, removed, full);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
 	// For each hotkey that we've found
-	for (auto& hotkeyInfo : hotkeyInfos) {
-		rval.push_back(ipc::value(hotkeyInfo.objectName));
-		rval.push_back(ipc::value(uint32_t(hotkeyInfo.objectType)));
-		rval.push_back(ipc::value(hotkeyInfo.hotkeyName));
-		rval.push_back(ipc::value(hotkeyInfo.hotkeyDesc));
-		rval.push_back(ipc::value(uint64_t(hotkeyInfo.hotkeyId)));
-	}
+	for (auto& hotkeyInfo : hotkeyInfos)
+		PushHotkeyEntry(rval, hotkeyInfo);
+
+	AUTO_DEBUG;
+}
+
+void OBS_API::QueryHotkeysDelta(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<HotkeyIndex::Entry> changed;
+	std::vector<obs_hotkey_id>      removed;
+	bool                            full;
+	uint64_t generation = HotkeyIndex::GetInstance().Query(args[0].value_union.ui64, changed, removed, full);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(generation));
+	rval.push_back(ipc::value(uint32_t(full)));
+	rval.push_back(ipc::value(uint32_t(changed.size())));
+	for (auto& hotkeyInfo : changed)
+		PushHotkeyEntry(rval, hotkeyInfo);
+	for (auto& hotkeyId : removed)
+		rval.push_back(ipc::value(uint64_t(hotkeyId)));
 
 	AUTO_DEBUG;
 }
@@ -1277,6 +1267,12 @@ bool prepareTerminationPipe() {
 }
 #endif
 
+void OBS_API::SetProcessStartup(std::string breakdown)
+{
+	std::unique_lock<std::mutex> ulock(processStartupMutex);
+	processStartup = std::move(breakdown);
+}
+
 void OBS_API::CreateCrashHandlerExitPipe() 
 {
 	if (prepareTerminationPipe()) {
@@ -1339,6 +1335,8 @@ void OBS_API::destroyOBS_API(void)
 {
 	blog(LOG_DEBUG, "OBS_API::destroyOBS_API started, objects allocated %d", bnum_allocs());
 
+	HotkeyIndex::GetInstance().Finalize();
+
 	os_cpu_usage_info_destroy(cpuUsageInfo);
 
 #ifdef _WIN32
@@ -1395,9 +1393,12 @@ void OBS_API::destroyOBS_API(void)
 		obs_service_release(service);
 
     OBS_service::waitReleaseWorker();
+    OBS_service::stopSegmentWorker();
+    OBS_service::waitSegmentFinalizer();
     OBS_service::clearAudioEncoder();
     osn::Volmeter::ClearVolmeters();
     osn::Fader::ClearFaders();
+    OBS_content::DestroyFrameTaps();
 
 	// Check if the frontend was able to shutdown correctly:
 	// If there are some sources here it's because it ended unexpectedly, this represents a 
@@ -1485,6 +1486,9 @@ void OBS_API::destroyOBS_API(void)
 		obs_shutdown();
 	}
 
+	// libobs freed every module in obs_shutdown, drop the ids handed out for them
+	osn::Module::Manager::GetInstance().clear();
+
 	// Release each obs module (dlls for windows)
 	// TODO: We should release these modules (dlls) manually and not let the garbage
 	// collector do this for us on shutdown
@@ -1592,6 +1596,8 @@ bool OBS_API::openAllModules(int& video_err)
 			}
 #endif
 
+			util::StartupTrace::Scope moduleScope("module", basename);
+
 			obs_module_t* module = nullptr;
 			int           result = MODULE_ERROR;
 
@@ -112,6 +112,11 @@ class OBS_API
 	static void InformCrashHandler(const int crash_id);
 	static void
 	            QueryHotkeys(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+	static void QueryHotkeysDelta(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 	static void ProcessHotkeyStatus(
 	    void*                          data,
 	    const int64_t                  id,
@@ -171,6 +176,10 @@ class OBS_API
 
 	static void CreateCrashHandlerExitPipe();
 	static void WaitCrashHandlerClose(bool waitBeforeClosing);
+
+	// main() times process startup before the log file exists, the breakdown is
+	// logged once OBS_API_initAPI installed the log handler.
+	static void SetProcessStartup(std::string breakdown);
 };
 
 class outdated_driver_error 
@@ -18,9 +18,15 @@
 
 #include "nodeobs_autoconfig.h"
 #include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
 #include <future>
 #include "error.hpp"
 #include "shared.hpp"
+#include "util-bandwidthprobe.h"
+#include "util-encoderbenchmark.h"
 
 enum class Type
 {
@@ -390,13 +396,11 @@ void GetServers(std::vector<ServerInfo>& servers)
 	obs_properties_destroy(ppts);
 }
 
-void start_next_step(void (*task)(), std::string event, std::string description, int percentage)
+// Queues a progress record for the client, which drains them all at once through Query.
+void start_next_step(const std::string& event, const std::string& description, double percentage)
 {
-	/*eventCallbackQueue.work_queue.push_back({cb, event, description, percentage});
-    eventCallbackQueue.Signal();
-
-    if(task)
-    	std::thread(*task).detach();*/
+	std::unique_lock<std::mutex> ulock(eventsMutex);
+	events.push(AutoConfigInfo(event, description, percentage));
 }
 
 void autoConfig::TerminateAutoConfig(
@@ -412,19 +416,15 @@ void autoConfig::TerminateAutoConfig(
 void autoConfig::Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
 {
 	std::unique_lock<std::mutex> ulock(eventsMutex);
-	if (events.empty()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-		AUTO_DEBUG;
-		return;
-	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)events.size()));
 
-	rval.push_back(ipc::value(events.front().event));
-	rval.push_back(ipc::value(events.front().description));
-	rval.push_back(ipc::value(events.front().percentage));
-
-	events.pop();
+	for (; !events.empty(); events.pop()) {
+		rval.push_back(ipc::value(events.front().event));
+		rval.push_back(ipc::value(events.front().description));
+		rval.push_back(ipc::value(events.front().percentage));
+	}
 
 	AUTO_DEBUG;
 }
@@ -451,6 +451,12 @@ void autoConfig::InitializeAutoConfig(
 
 	cancel = false;
 
+	// Records left over from a previous run would be delivered to the new one.
+	{
+		std::unique_lock<std::mutex> ulock(eventsMutex);
+		events = std::queue<AutoConfigInfo>();
+	}
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 }
 
@@ -534,109 +540,283 @@ void autoConfig::StartSetDefaultSettings(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 }
 
-int EvaluateBandwidth(
-    ServerInfo& server,
-    bool&       connected,
-    bool&       stopped,
-    bool&       success,
-    bool&       errorOnStop,
-    OBSData&    service_settings,
-    OBSService& service,
-    OBSOutput&  output,
-    OBSData&    vencoder_settings)
+static bool IsCancelled()
+{
+	std::unique_lock<std::mutex> ul(m);
+	return cancel;
+}
+
+// Everything a probe needs to build its own service, encoders and output.
+struct ProbeConfig
+{
+	std::string serviceType = "rtmp_common";
+	std::string serviceName;
+	std::string key;
+	std::string bindIP;
+	int         bitrate     = 2500; // Bitrate a single stream would use
+	size_t      concurrency = 1;
+};
+
+// Streams to one ingest server at a time and measures the achieved throughput.
+//
+// Probes running side by side share the uplink, so each one only sends its share
+// of the bitrate and the result is scaled back up by the number of probes.
+class BandwidthProbe
 {
-	// auto &server = servers[i];
+	public:
+	BandwidthProbe(const ProbeConfig& config, size_t index);
+	~BandwidthProbe();
 
-	connected = false;
-	stopped   = false;
-	errorOnStop = false;
+	// Fills in bitrate and ms of the server, returns false if no stream could be made.
+	bool Evaluate(ServerInfo& server);
 
-	// int per = int((i + 1) * 100 / servers.size());
+	private:
+	static void OnStarted(void* data, calldata_t*);
+	static void OnStopped(void* data, calldata_t*);
 
-	obs_data_set_string(service_settings, "server", server.address.c_str());
-	obs_service_update(service, service_settings);
+	template<typename Predicate>
+	bool Wait(std::chrono::milliseconds timeout, Predicate predicate);
 
-	if (!obs_output_start(output))
-		return -1;
+	const ProbeConfig& config;
+	int                probeBitrate;
 
-	std::unique_lock<std::mutex> ul(m);
-	if (cancel) {
-		ul.unlock();
-		obs_output_force_stop(output);
-		return -1;
-	}
-	if (!stopped && !connected)
-		cv.wait(ul);
-	if (cancel) {
-		ul.unlock();
-		obs_output_force_stop(output);
-		return -1;
+	OBSEncoder vencoder;
+	OBSEncoder aencoder;
+	OBSService service;
+	OBSOutput  output;
+	OBSData    serviceSettings;
+
+	std::mutex              mtx;
+	std::condition_variable cond;
+	bool                    connected   = false;
+	bool                    stopped     = false;
+	bool                    errorOnStop = false;
+};
+
+// Sampling of the output byte counter, util::ThroughputSampler decides when to stop
+static const std::chrono::milliseconds PROBE_SAMPLE_INTERVAL(500);
+static const std::chrono::milliseconds PROBE_CONNECT_TIMEOUT(15000);
+static const std::chrono::milliseconds PROBE_STOP_TIMEOUT(5000);
+
+BandwidthProbe::BandwidthProbe(const ProbeConfig& config, size_t index) : config(config)
+{
+	std::string suffix = std::to_string(index);
+
+	probeBitrate = std::max(config.bitrate / int(config.concurrency), 100);
+
+	vencoder = obs_video_encoder_create("obs_x264", ("test_x264_" + suffix).c_str(), nullptr, nullptr);
+	aencoder = obs_audio_encoder_create("ffmpeg_aac", ("test_aac_" + suffix).c_str(), nullptr, 0, nullptr);
+	service  = obs_service_create(config.serviceType.c_str(), ("test_service_" + suffix).c_str(), nullptr, nullptr);
+	output   = obs_output_create("rtmp_output", ("test_stream_" + suffix).c_str(), nullptr, nullptr);
+	obs_encoder_release(vencoder);
+	obs_encoder_release(aencoder);
+	obs_service_release(service);
+	obs_output_release(output);
+
+	serviceSettings = obs_data_create();
+	OBSData vencoderSettings = obs_data_create();
+	OBSData aencoderSettings = obs_data_create();
+	OBSData outputSettings   = obs_data_create();
+	obs_data_release(serviceSettings);
+	obs_data_release(vencoderSettings);
+	obs_data_release(aencoderSettings);
+	obs_data_release(outputSettings);
+
+	obs_data_set_string(serviceSettings, "service", config.serviceName.c_str());
+	obs_data_set_string(serviceSettings, "key", config.key.c_str());
+
+	obs_data_set_int(vencoderSettings, "bitrate", probeBitrate);
+	obs_data_set_string(vencoderSettings, "rate_control", "CBR");
+	obs_data_set_string(vencoderSettings, "preset", "veryfast");
+	obs_data_set_int(vencoderSettings, "keyint_sec", 2);
+
+	obs_data_set_int(aencoderSettings, "bitrate", 32);
+
+	obs_data_set_string(outputSettings, "bind_ip", config.bindIP.c_str());
+
+	obs_service_update(service, serviceSettings);
+	obs_service_apply_encoder_settings(service, vencoderSettings, aencoderSettings);
+	probeBitrate = (int)obs_data_get_int(vencoderSettings, "bitrate");
+
+	obs_encoder_update(vencoder, vencoderSettings);
+	obs_encoder_update(aencoder, aencoderSettings);
+	obs_output_update(output, outputSettings);
+
+	obs_encoder_set_video(vencoder, obs_get_video());
+	obs_encoder_set_audio(aencoder, obs_get_audio());
+
+	obs_output_set_video_encoder(output, vencoder);
+	obs_output_set_audio_encoder(output, aencoder, 0);
+	obs_output_set_service(output, service);
+
+	signal_handler* sh = obs_output_get_signal_handler(output);
+	signal_handler_connect(sh, "start", OnStarted, this);
+	signal_handler_connect(sh, "stop", OnStopped, this);
+}
+
+BandwidthProbe::~BandwidthProbe()
+{
+	signal_handler* sh = obs_output_get_signal_handler(output);
+	signal_handler_disconnect(sh, "start", OnStarted, this);
+	signal_handler_disconnect(sh, "stop", OnStopped, this);
+}
+
+void BandwidthProbe::OnStarted(void* data, calldata_t*)
+{
+	BandwidthProbe* probe = reinterpret_cast<BandwidthProbe*>(data);
+
+	std::unique_lock<std::mutex> lock(probe->mtx);
+	probe->connected = true;
+	probe->stopped   = false;
+	probe->cond.notify_one();
+}
+
+void BandwidthProbe::OnStopped(void* data, calldata_t*)
+{
+	BandwidthProbe* probe = reinterpret_cast<BandwidthProbe*>(data);
+
+	std::unique_lock<std::mutex> lock(probe->mtx);
+	if (obs_output_get_last_error(probe->output) != nullptr)
+		probe->errorOnStop = true;
+	probe->connected = false;
+	probe->stopped   = true;
+	probe->cond.notify_one();
+}
+
+// Waits until predicate holds, the timeout expired or the test got cancelled.
+template<typename Predicate>
+bool BandwidthProbe::Wait(std::chrono::milliseconds timeout, Predicate predicate)
+{
+	auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	std::unique_lock<std::mutex> ul(mtx);
+	while (!predicate()) {
+		if (IsCancelled() || std::chrono::steady_clock::now() >= deadline)
+			return false;
+		cond.wait_for(ul, std::chrono::milliseconds(250));
 	}
-	if (!connected) {
-		return -1;
+	return true;
+}
+
+bool BandwidthProbe::Evaluate(ServerInfo& server)
+{
+	{
+		std::unique_lock<std::mutex> ul(mtx);
+		connected   = false;
+		stopped     = false;
+		errorOnStop = false;
 	}
 
-	uint64_t t_start = os_gettime_ns();
+	obs_data_set_string(serviceSettings, "server", server.address.c_str());
+	obs_service_update(service, serviceSettings);
 
-	cv.wait_for(ul, std::chrono::seconds(10));
-	if (stopped)
-		return -1;
-	if (cancel) {
-		ul.unlock();
+	if (!obs_output_start(output))
+		return false;
+
+	if (!Wait(PROBE_CONNECT_TIMEOUT, [this]() { return connected || stopped; }) || !connected) {
 		obs_output_force_stop(output);
-		return -1;
+		return false;
 	}
 
+	// Sample the throughput until the mean settles or the time is up.
+	util::ThroughputSampler sampler;
+	do {
+		if (Wait(PROBE_SAMPLE_INTERVAL, [this]() { return stopped; }) || IsCancelled()) {
+			obs_output_force_stop(output);
+			return false;
+		}
+	} while (!sampler.Add(obs_output_get_total_bytes(output), os_gettime_ns()));
+
+	uint64_t bitrate = sampler.Kbps() * config.concurrency;
+
+	bool dropped   = obs_output_get_frames_dropped(output) > 0;
+	int  connectMs = obs_output_get_connect_time_ms(output);
+
 	obs_output_stop(output);
+	if (!Wait(PROBE_STOP_TIMEOUT, [this]() { return stopped; }))
+		obs_output_force_stop(output);
 
-	while (!obs_output_active(output)) {
-		if (errorOnStop) {
-			ul.unlock();
-			obs_output_force_stop(output);
-			return -1;
+	if (errorOnStop)
+		return false;
+
+	server.bitrate = util::ProbeBitrate(bitrate, dropped, config.bitrate);
+	server.ms      = connectMs;
+
+	return true;
+}
+
+// Tests servers with up to config.concurrency probes at once, returns the number of servers that could be tested.
+static size_t RunBandwidthProbes(std::vector<ServerInfo>& servers, const ProbeConfig& config)
+{
+	std::atomic<size_t> next(0), done(0), succeeded(0);
+
+	auto worker = [&](size_t index) {
+		BandwidthProbe probe(config, index);
+
+		for (size_t i = next++; i < servers.size() && !IsCancelled(); i = next++) {
+			if (probe.Evaluate(servers[i]))
+				succeeded++;
+
+			start_next_step("progress", "bandwidth_test", (double)(++done) * 100 / servers.size());
 		}
+	};
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(500));
-	}
+	std::vector<std::thread> workers;
+	size_t                   count = std::min(config.concurrency, servers.size());
+	for (size_t i = 1; i < count; i++)
+		workers.emplace_back(worker, i);
+	worker(0);
 
-	cv.wait(ul);
+	for (auto& thread : workers)
+		thread.join();
 
-	uint64_t total_time  = os_gettime_ns() - t_start;
-	int      total_bytes = (int)obs_output_get_total_bytes(output);
-	uint64_t bitrate     = 0;
+	return succeeded;
+}
 
-	if (total_time > 0) {
-		bitrate = (uint64_t)total_bytes * 8 * 1000000000 / total_time / 1000;
+static const ServerInfo* PickBestServer(const std::vector<ServerInfo>& servers)
+{
+	std::vector<util::ProbeResult> results(servers.size());
+	for (size_t idx = 0; idx < servers.size(); idx++) {
+		results[idx].bitrate = servers[idx].bitrate;
+		results[idx].ms      = servers[idx].ms;
 	}
 
-	startingBitrate      = (int)obs_data_get_int(vencoder_settings, "bitrate");
-	if (obs_output_get_frames_dropped(output) || (int)bitrate < (startingBitrate * 75 / 100)) {
-		server.bitrate = (int)bitrate * 70 / 100;
-	} else {
-		server.bitrate = startingBitrate;
-	}
+	size_t best = util::PickBestProbe(results);
+	return best < servers.size() ? &servers[best] : nullptr;
+}
 
-	server.ms = obs_output_get_connect_time_ms(output);
-	success   = true;
-	return 0;
+// Integration runs point the probes at local RTMP stand-ins instead of the
+// service's ingest servers, e.g. OSN_BANDWIDTH_TEST_SERVERS=rtmp://127.0.0.1/live.
+// A comma separated list probes several of them.
+static bool GetLocalTestServers(std::vector<ServerInfo>& servers)
+{
+	const char* list = getenv("OSN_BANDWIDTH_TEST_SERVERS");
+	if (!list || !*list)
+		return false;
+
+	std::string entries(list);
+	for (size_t start = 0; start <= entries.size();) {
+		size_t end = entries.find(',', start);
+		if (end == std::string::npos)
+			end = entries.size();
+
+		std::string address = entries.substr(start, end - start);
+		if (!address.empty())
+			servers.emplace_back(address.c_str(), address.c_str());
+		start = end + 1;
+	}
+	return !servers.empty();
 }
 
 void sendErrorMessage(std::string message) {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("error", message.c_str(), 0));
-	eventsMutex.unlock();
+	start_next_step("error", message, 0);
 }
 
 void autoConfig::TestBandwidthThread(void)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "bandwidth_test", 0));
-	eventsMutex.unlock();
+	start_next_step("starting_step", "bandwidth_test", 0);
 
-	bool connected   = false;
-	bool stopped     = false;
-	bool errorOnStop = false;
-	bool gotError    = false;
+	bool gotError = false;
 
 	obs_video_info ovi;
 	obs_get_video_info(&ovi);
@@ -650,32 +830,14 @@ void autoConfig::TestBandwidthThread(void)
 
 	const char* serverType = "rtmp_common";
 
-	OBSEncoder vencoder = obs_video_encoder_create("obs_x264", "test_x264", nullptr, nullptr);
-	OBSEncoder aencoder = obs_audio_encoder_create("ffmpeg_aac", "test_aac", nullptr, 0, nullptr);
-	OBSService service  = obs_service_create(serverType, "test_service", nullptr, nullptr);
-	OBSOutput  output   = obs_output_create("rtmp_output", "test_stream", nullptr, nullptr);
-
-	/* -----------------------------------*/
-	/* configure settings                 */
-
-	// service: "service", "server", "key"
-	// vencoder: "bitrate", "rate_control",
-	//           obs_service_apply_encoder_settings
-	// aencoder: "bitrate"
-	// output: "bind_ip" via main config -> "Output", "BindIP"
-	//         obs_output_set_service
-
-	OBSData service_settings  = obs_data_create();
-	OBSData vencoder_settings = obs_data_create();
-	OBSData aencoder_settings = obs_data_create();
-	OBSData output_settings   = obs_data_create();
-	obs_data_release(service_settings);
-	obs_data_release(vencoder_settings);
-	obs_data_release(aencoder_settings);
-	obs_data_release(output_settings);
+	// A local stand-in takes any key, the configured service is not needed.
+	std::vector<ServerInfo> localServers;
+	bool                    local = GetLocalTestServers(localServers);
 
 	obs_service_t* currentService = OBS_service::getService();
-	if (currentService) {
+	if (local) {
+		key = "bandwidthtest";
+	} else if (currentService) {
 		obs_data_t* currentServiceSettings = obs_service_get_settings(currentService);
 		if (currentServiceSettings) {
 			if (serviceName.compare("") == 0)
@@ -695,13 +857,8 @@ void autoConfig::TestBandwidthThread(void)
 		gotError = true;
 	}
 
-	if (gotError) { 
-		obs_output_release(output);
-		obs_encoder_release(vencoder);
-		obs_encoder_release(aencoder);
-		obs_service_release(service);
+	if (gotError)
 		return;
-	}
 	
 	if (!customServer) {
 		if (serviceName == "Twitch")
@@ -723,9 +880,6 @@ void autoConfig::TestBandwidthThread(void)
 		keyToEvaluate += "?bandwidthtest";
 	}
 
-	obs_data_set_string(service_settings, "service", serviceName.c_str());
-	obs_data_set_string(service_settings, "key", keyToEvaluate.c_str());
-
 	//Setting starting bitrate
 	OBSData service_settingsawd = obs_data_create();
 	obs_data_release(service_settingsawd);
@@ -742,17 +896,16 @@ void autoConfig::TestBandwidthThread(void)
 	obs_data_set_int(settings, "bitrate", bitrate);
 	obs_service_apply_encoder_settings(servicewad, settings, nullptr);
 
-	int awstartingBitrate = (int)obs_data_get_int(settings, "bitrate");
-	obs_data_set_int(vencoder_settings, "bitrate", awstartingBitrate);
-	obs_data_set_string(vencoder_settings, "rate_control", "CBR");
-	obs_data_set_string(vencoder_settings, "preset", "veryfast");
-	obs_data_set_int(vencoder_settings, "keyint_sec", 2);
+	startingBitrate = (int)obs_data_get_int(settings, "bitrate");
 
-	obs_data_set_int(aencoder_settings, "bitrate", 32);
+	ProbeConfig config;
+	config.serviceName = serviceName;
+	config.key         = keyToEvaluate;
+	config.bitrate     = startingBitrate;
 
 	const char *bind_ip = config_get_string(ConfigManager::getInstance().getBasic(), "Output",
 			"BindIP");
-	obs_data_set_string(output_settings, "bind_ip", bind_ip);
+	config.bindIP = bind_ip ? bind_ip : "";
 
 	/* -----------------------------------*/
 	/* determine which servers to test    */
@@ -767,135 +920,37 @@ void autoConfig::TestBandwidthThread(void)
 	if (servers.size() < 3)
 		servers.resize(1);
 
-	/* -----------------------------------*/
-	/* apply settings                     */
-
-	obs_service_update(service, service_settings);
-	obs_service_apply_encoder_settings(service, vencoder_settings, aencoder_settings);
-
-	obs_encoder_update(vencoder, vencoder_settings);
-	obs_encoder_update(aencoder, aencoder_settings);
-	obs_output_update(output, output_settings);
-
-	/* -----------------------------------*/
-	/* connect encoders/services/outputs  */
-
-	obs_encoder_set_video(vencoder, obs_get_video());
-	obs_encoder_set_audio(aencoder, obs_get_audio());
-
-	obs_output_set_video_encoder(output, vencoder);
-	obs_output_set_audio_encoder(output, aencoder, 0);
-
-	obs_output_set_service(output, service);
-
-	/* -----------------------------------*/
-	/* connect signals                    */
-
-	auto on_started = [&]() {
-		std::unique_lock<std::mutex> lock(m);
-		connected = true;
-		stopped   = false;
-		cv.notify_one();
-	};
-
-	auto on_stopped = [&]() {
-		const char* output_error = obs_output_get_last_error(output);
-
-		if (output_error == nullptr) {
-			std::unique_lock<std::mutex> lock(m);
-			connected = false;
-			stopped   = true;
-			cv.notify_one();
-		} else {
-			errorOnStop = true;
-		}
-	};
-
-	using on_started_t = decltype(on_started);
-	using on_stopped_t = decltype(on_stopped);
-
-	auto pre_on_started = [](void* data, calldata_t*) {
-		on_started_t& on_started = *reinterpret_cast<on_started_t*>(data);
-		on_started();
-	};
-
-	auto pre_on_stopped = [](void* data, calldata_t*) {
-		on_stopped_t& on_stopped = *reinterpret_cast<on_stopped_t*>(data);
-		on_stopped();
-	};
-
-	signal_handler* sh = obs_output_get_signal_handler(output);
-	signal_handler_connect(sh, "start", pre_on_started, &on_started);
-	signal_handler_connect(sh, "stop", pre_on_stopped, &on_stopped);
-
 	/* -----------------------------------*/
 	/* test servers                       */
 
-	int         bestBitrate = 0;
-	int         bestMS      = 0x7FFFFFFF;
-	std::string bestServer;
-	std::string bestServerName;
-	bool        success = false;
-
+	// A single explicit server is tested on its own.
 	if (serverName.compare("") != 0) {
-		ServerInfo info(serverName.c_str(), server.c_str());
-
-		if (EvaluateBandwidth(info, connected, stopped, success, errorOnStop, service_settings, service, output, vencoder_settings) < 0) {
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-			eventsMutex.unlock();
-			gotError = true;
-		} else {
-			bestServer     = info.address;
-			bestServerName = info.name;
-			bestBitrate    = info.bitrate;
-
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", 100));
-			eventsMutex.unlock();
-		}
-	} else {
-		for (size_t i = 0; i < servers.size(); i++) {
-			EvaluateBandwidth(servers[i], connected, stopped, success, errorOnStop, service_settings, service, output, vencoder_settings);
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size()));
-			eventsMutex.unlock();
-		}
+		servers.clear();
+		servers.emplace_back(serverName.c_str(), server.c_str());
 	}
 
-	if (!success && !gotError) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-		eventsMutex.unlock();
-		gotError = true;
+	if (local) {
+		servers            = localServers;
+		config.serviceType = "rtmp_custom";
 	}
 
-	if (!gotError) {
-		for (auto& server : servers) {
-			bool close = abs(server.bitrate - bestBitrate) < 400;
+	uint64_t concurrency =
+	    config_get_uint(ConfigManager::getInstance().getBasic(), "Output", "BandwidthTestConcurrency");
+	config.concurrency = util::ProbeConcurrency(concurrency, servers.size());
 
-			if ((!close && server.bitrate > bestBitrate) || (close && server.ms < bestMS)) {
-				bestServer     = server.address;
-				bestServerName = server.name;
-				bestBitrate    = server.bitrate;
-				bestMS         = server.ms;
-			}
-		}
-		server       = bestServer;
-		serverName   = bestServerName;
-		idealBitrate = bestBitrate;
+	RunBandwidthProbes(servers, config);
+
+	const ServerInfo* best = PickBestServer(servers);
+	if (!best) {
+		start_next_step("error", "invalid_stream_settings", 0);
+		return;
 	}
 
-	obs_output_release(output);
-	obs_encoder_release(vencoder);
-	obs_encoder_release(aencoder);
-	obs_service_release(service);
+	server       = best->address;
+	serverName   = best->name;
+	idealBitrate = best->bitrate;
 
-	if(!gotError) { 
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("stopping_step", "bandwidth_test", 100));
-		eventsMutex.unlock();
-	}
+	start_next_step("stopping_step", "bandwidth_test", 100);
 }
 
 /* this is used to estimate the lower bitrate limit for a given
@@ -1065,22 +1120,14 @@ bool autoConfig::TestSoftwareEncoding()
 	obs_output_set_audio_encoder(output, aencoder, 0);
 
 	/* -----------------------------------*/
-	/* connect signals                    */
-
-	auto on_stopped = [&]() {
-		std::unique_lock<std::mutex> lock(m);
-		cv.notify_one();
-	};
-
-	using on_stopped_t = decltype(on_stopped);
+	/* prepare the benchmark              */
 
-	auto pre_on_stopped = [](void* data, calldata_t*) {
-		on_stopped_t& on_stopped = *reinterpret_cast<on_stopped_t*>(data);
-		on_stopped();
-	};
-
-	signal_handler* sh = obs_output_get_signal_handler(output);
-	signal_handler_connect(sh, "deactivate", pre_on_stopped, &on_stopped);
+	/* The same encoder chain is reused for every candidate and fed from a
+	 * private video output, so the global video doesn't have to be reset per
+	 * test. Results are cached per CPU model, which makes repeat runs of the
+	 * wizard skip encoding entirely. */
+	util::EncoderBenchmark benchmark(
+	    vencoder, aencoder, output, ConfigManager::getInstance().getEncoderBenchmark());
 
 	/* -----------------------------------*/
 	/* calculate starting resolution      */
@@ -1145,40 +1192,31 @@ bool autoConfig::TestSoftwareEncoding()
 		if (!force && rate > maxDataRate)
 			return true;
 
-		obs_video_info ovi;
-		obs_get_video_info(&ovi);
-
-		ovi.output_width  = (uint32_t)cx;
-		ovi.output_height = (uint32_t)cy;
-		ovi.fps_num       = fps_num;
-		ovi.fps_den       = fps_den;
-
-		obs_reset_video(&ovi);
-
-		obs_encoder_set_video(vencoder, obs_get_video());
-		obs_encoder_set_audio(aencoder, obs_get_audio());
-		obs_encoder_update(vencoder, vencoder_settings);
-
-		obs_output_set_media(output, obs_get_video(), obs_get_audio());
-
-		std::unique_lock<std::mutex> ul(m);
-		if (cancel)
+		if (IsCancelled())
 			return false;
 
-		if (!obs_output_start(output)) {
+		util::EncoderBenchmark::Config config = {uint32_t(cx), uint32_t(cy), uint32_t(fps_num), uint32_t(fps_den)};
+		util::EncoderBenchmark::Result result;
+		if (!benchmark.Run(config, std::chrono::seconds(5), IsCancelled, result))
 			return false;
-		}
-
-		cv.wait_for(ul, std::chrono::seconds(5));
-
-		obs_output_stop(output);
-		cv.wait(ul);
 
-		int skipped = (int)video_output_get_skipped_frames(obs_get_video());
-		if (force || skipped <= 10)
+		blog(
+		    LOG_INFO,
+		    "Encoder benchmark %dx%d@%d/%d: %.1f fps, %.1f%% cpu, %llu/%llu frames skipped%s",
+		    cx,
+		    cy,
+		    fps_num,
+		    fps_den,
+		    result.encodeFps,
+		    result.cpu,
+		    (unsigned long long)result.skipped,
+		    (unsigned long long)result.total,
+		    result.cached ? " (cached)" : "");
+
+		if (force || result.skipped <= 10)
 			results.emplace_back(cx, cy, fps_num, fps_den);
 
-		return !cancel;
+		return !IsCancelled();
 	};
 
 	if (specificFPSNum && specificFPSDen) {
@@ -1217,6 +1255,8 @@ bool autoConfig::TestSoftwareEncoding()
 			return false;
 	}
 
+	benchmark.Save();
+
 	/* -----------------------------------*/
 	/* find preferred settings            */
 
@@ -1267,9 +1307,7 @@ bool autoConfig::TestSoftwareEncoding()
 
 void autoConfig::TestStreamEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "streamingEncoder_test", 0));
-	eventsMutex.unlock();
+	start_next_step("starting_step", "streamingEncoder_test", 0);
 
 	baseResolutionCX = config_get_int(ConfigManager::getInstance().getBasic(), "Video", "BaseCX");
 	baseResolutionCY = config_get_int(ConfigManager::getInstance().getBasic(), "Video", "BaseCY");
@@ -1301,16 +1339,12 @@ void autoConfig::TestStreamEncoderThread()
 		streamingEncoder = Encoder::x264;
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "streamingEncoder_test", 100));
-	eventsMutex.unlock();
+	start_next_step("stopping_step", "streamingEncoder_test", 100);
 }
 
 void autoConfig::TestRecordingEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "recordingEncoder_test", 0));
-	eventsMutex.unlock();
+	start_next_step("starting_step", "recordingEncoder_test", 0);
 
 	TestHardwareEncoding();
 
@@ -1348,9 +1382,7 @@ void autoConfig::TestRecordingEncoderThread()
 		}
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "recordingEncoder_test", 100));
-	eventsMutex.unlock();
+	start_next_step("stopping_step", "recordingEncoder_test", 100);
 }
 
 inline const char* GetEncoderId(Encoder enc)
@@ -1405,9 +1437,7 @@ bool autoConfig::CheckSettings(void)
 	OBSService service = obs_service_create("rtmp_common", "serviceTest", settings, NULL);
 
 	if (!service) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_service", 100));
-		eventsMutex.unlock();
+		start_next_step("error", "invalid_service", 100);
 		return false;
 	}
 
@@ -1519,9 +1549,7 @@ bool autoConfig::CheckSettings(void)
 
 void autoConfig::SetDefaultSettings(void)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "setting_default_settings", 0));
-	eventsMutex.unlock();
+	start_next_step("starting_step", "setting_default_settings", 0);
 
 	idealResolutionCX = 1280;
 	idealResolutionCY = 720;
@@ -1531,9 +1559,7 @@ void autoConfig::SetDefaultSettings(void)
 	streamingEncoder = Encoder::x264;
 	recordingEncoder = Encoder::Stream;
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "setting_default_settings", 100));
-	eventsMutex.unlock();
+	start_next_step("stopping_step", "setting_default_settings", 100);
 }
 
 void autoConfig::SaveStreamSettings()
@@ -1541,9 +1567,7 @@ void autoConfig::SaveStreamSettings()
 	/* ---------------------------------- */
 	/* save service                       */
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_service", 0));
-	eventsMutex.unlock();
+	start_next_step("starting_step", "saving_service", 0);
 
 	const char* service_id = "rtmp_common";
 
@@ -1575,17 +1599,16 @@ void autoConfig::SaveStreamSettings()
 	config_remove_value(ConfigManager::getInstance().getBasic(), "SimpleOutput", "UseAdvanced");
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+
+	// A recording armed before the wizard would keep the old encoder.
+	OBS_service::invalidateRecordingArm();
 	
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_service", 100));
-	eventsMutex.unlock();
+	start_next_step("stopping_step", "saving_service", 100);
 }
 
 void autoConfig::SaveSettings()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_settings", 0));
-	eventsMutex.unlock();
+	start_next_step("starting_step", "saving_settings", 0);
 	
 	if (recordingEncoder != Encoder::Stream)
 		config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecEncoder",
@@ -1610,8 +1633,9 @@ void autoConfig::SaveSettings()
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_settings", 100));
-	events.push(AutoConfigInfo("done", "", 0));
-	eventsMutex.unlock();
+	// The armed recording output was built for the previous encoder and resolution.
+	OBS_service::invalidateRecordingArm();
+
+	start_next_step("stopping_step", "saving_settings", 100);
+	start_next_step("done", "", 0);
 }
@@ -26,12 +26,14 @@
 
 #include "error.hpp"
 #include "shared.hpp"
+#include "util-frametap.h"
 
 #include <thread>
 
-std::map<std::string, OBS::Display*> displays;
-std::string                          sourceSelected;
-bool                                 firstDisplayCreation = true;
+std::map<std::string, OBS::Display*>   displays;
+std::map<std::string, util::FrameTap*> frameTaps;
+std::string                            sourceSelected;
+bool                                   firstDisplayCreation = true;
 
 std::thread* windowMessage = NULL;
 ipc::server* g_srv;
@@ -223,6 +225,30 @@ void OBS_content::Register(ipc::server& srv)
 	    std::vector<ipc::type>{ipc::type::String},
 	    OBS_content_createIOSurface));
 
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_setDisplayMaxFPS",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32},
+	    OBS_content_setDisplayMaxFPS));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_setDisplayHidden",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
+	    OBS_content_setDisplayHidden));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_getDisplayRenderStats",
+	    std::vector<ipc::type>{ipc::type::String},
+	    OBS_content_getDisplayRenderStats));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_createFrameTap",
+	    std::vector<ipc::type>{
+	        ipc::type::String, ipc::type::Int32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
+	    OBS_content_createFrameTap));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_destroyFrameTap", std::vector<ipc::type>{ipc::type::String}, OBS_content_destroyFrameTap));
+
 	srv.register_collection(cls);
 	g_srv = &srv;
 }
@@ -384,9 +410,7 @@ void OBS_content::OBS_content_resizeDisplay(
     // Store new size.
     display->UpdatePreviewArea();
 
-#ifdef WIN32
 	display->SetSize(display->m_gsInitData.cx, display->m_gsInitData.cy);
-#endif
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
@@ -659,3 +683,144 @@ void OBS_content::OBS_content_createIOSurface(
 #endif
 	AUTO_DEBUG;
 }
+
+void OBS_content::OBS_content_setDisplayMaxFPS(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	it->second->SetMaxFPS(args[1].value_union.ui32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_setDisplayHidden(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	it->second->SetHidden((bool)args[1].value_union.i32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_getDisplayRenderStats(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	std::pair<uint64_t, uint64_t> stats = it->second->GetRenderStats();
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(stats.first));
+	rval.push_back(ipc::value(stats.second));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_createFrameTap(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	const std::string& key    = args[0].value_str;
+	uint32_t           width  = args[2].value_union.ui32;
+	uint32_t           height = args[3].value_union.ui32;
+	uint32_t           fps    = args[4].value_union.ui32;
+
+	if (frameTaps.find(key) != frameTaps.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Duplicate key provided to createFrameTap: " + key));
+		return;
+	}
+
+	if (width == 0 || height == 0 || width > 4096 || height > 4096) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Invalid frame tap size."));
+		return;
+	}
+
+	enum obs_video_rendering_mode mode = OBS_MAIN_VIDEO_RENDERING;
+	switch (args[1].value_union.i32) {
+	case 0:
+		mode = OBS_MAIN_VIDEO_RENDERING;
+		break;
+	case 1:
+		mode = OBS_STREAMING_VIDEO_RENDERING;
+		break;
+	case 2:
+		mode = OBS_RECORDING_VIDEO_RENDERING;
+		break;
+	default:
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Invalid frame tap rendering mode: " + std::to_string(args[1].value_union.i32)));
+		return;
+	}
+
+	util::FrameTap* tap = new util::FrameTap(mode, width, height, fps);
+	if (tap->GetSharedMemoryName().empty()) {
+		delete tap;
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Failed to create the frame tap shared memory."));
+		return;
+	}
+	frameTaps.insert_or_assign(key, tap);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(tap->GetSharedMemoryName()));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_destroyFrameTap(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto found = frameTaps.find(args[0].value_str);
+	if (found == frameTaps.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Failed to find frame tap key for destruction: " + args[0].value_str));
+		return;
+	}
+
+	delete found->second;
+	frameTaps.erase(found);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::DestroyFrameTaps(void)
+{
+	// Each tap owns GPU resources and a named shared memory segment, neither goes away with the process
+	for (auto& tap : frameTaps)
+		delete tap.second;
+	frameTaps.clear();
+}
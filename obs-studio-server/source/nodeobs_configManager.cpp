@@ -25,6 +25,7 @@
 
 #include <util/platform.h>
 #include "shared.hpp"
+#include "util-startuptrace.h"
 
 void ConfigManager::setAppdataPath(std::string path)
 {
@@ -33,6 +34,8 @@ void ConfigManager::setAppdataPath(std::string path)
 
 config_t* ConfigManager::getConfig(std::string name)
 {
+	util::StartupTrace::Scope scope("config", name);
+
 	config_t*   config = nullptr;
 	std::string file = appdata + name;
 
@@ -140,6 +143,11 @@ void initBasicDefault(config_t* config)
 	config_set_default_bool(config, "SimpleOutput", "replayBufferUseStreamOutput", true);
 	config_set_default_string(config, "SimpleOutput", "Profile", "main");
 
+	config_set_default_bool(config, "SimpleOutput", "RecSplitFile", false);
+	config_set_default_string(config, "SimpleOutput", "RecSplitFileType", "Time");
+	config_set_default_uint(config, "SimpleOutput", "RecSplitFileTime", 15);
+	config_set_default_uint(config, "SimpleOutput", "RecSplitFileSize", 2048);
+
 	config_set_default_bool(config, "AdvOut", "ApplyServiceSettings", true);
 	config_set_default_bool(config, "AdvOut", "UseRescale", false);
 	config_set_default_uint(config, "AdvOut", "TrackIndex", 1);
@@ -175,6 +183,11 @@ void initBasicDefault(config_t* config)
 	config_set_default_int(config, "AdvOut", "RecRBSize", 512);
 	config_set_default_bool(config, "AdvOut", "replayBufferUseStreamOutput", true);
 
+	config_set_default_bool(config, "AdvOut", "RecSplitFile", false);
+	config_set_default_string(config, "AdvOut", "RecSplitFileType", "Time");
+	config_set_default_uint(config, "AdvOut", "RecSplitFileTime", 15);
+	config_set_default_uint(config, "AdvOut", "RecSplitFileSize", 2048);
+
 	config_set_default_uint(config, "Video", "BaseCX", cx);
 	config_set_default_uint(config, "Video", "BaseCY", cy);
 
@@ -313,3 +326,11 @@ std::string ConfigManager::getRecord()
 	return appdata + "/recordEncoder.json";
 #endif
 };
+std::string ConfigManager::getEncoderBenchmark()
+{
+#ifdef WIN32
+	return appdata + "\\encoderBenchmark.json";
+#else
+	return appdata + "/encoderBenchmark.json";
+#endif
+};
@@ -32,6 +32,13 @@ extern std::string currentScene; /* defined in OBS_content.cpp */
 
 static const uint32_t grayPaddingArea = 10ul;
 
+// Vertices uploaded per overlay draw, a multiple of both the line and the triangle vertex count.
+static const uint32_t overlayVertexCapacity = 8190ul;
+// Overlays are drawn with SolidColored, which only reads positions and colors.
+static const uint32_t overlayStreams = GS::STREAM_POSITIONS | GS::STREAM_COLORS;
+// Vertices available for distance labels, labels that do not fit are dropped.
+static const uint32_t textVertexCapacity = 65535ul;
+
 static void RecalculateApectRatioConstrainedSize(
     uint32_t  origW,
     uint32_t  origH,
@@ -258,54 +265,22 @@ OBS::Display::Display()
 
 	obs_enter_graphics();
 	m_gsSolidEffect = obs_get_base_effect(OBS_EFFECT_SOLID);
-	GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-
-	m_boxLine = std::make_unique<GS::VertexBuffer>(6);
-	m_boxLine->Resize(6);
-	v = m_boxLine->At(0);
-	vec3_set(v.position, 0, 0, 0);
-	vec4_set(v.uv[0], 0, 0, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	v        = m_boxLine->At(1);
-	vec3_set(v.position, 1, 0, 0);
-	vec4_set(v.uv[0], 1, 0, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	v        = m_boxLine->At(2);
-	vec3_set(v.position, 1, 1, 0);
-	vec4_set(v.uv[0], 1, 1, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	v        = m_boxLine->At(3);
-	vec3_set(v.position, 0, 1, 0);
-	vec4_set(v.uv[0], 0, 1, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	v        = m_boxLine->At(4);
-	vec3_set(v.position, 0, 0, 0);
-	vec4_set(v.uv[0], 0, 0, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	m_boxLine->Update();
-
-	m_boxTris = std::make_unique<GS::VertexBuffer>(4);
+	m_boxTris = std::make_unique<GS::StreamVertexBuffer>(4, GS::STREAM_POSITIONS);
 	m_boxTris->Resize(4);
-	v = m_boxTris->At(0);
-	vec3_set(v.position, 0, 0, 0);
-	vec4_set(v.uv[0], 0, 0, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	v        = m_boxTris->At(1);
-	vec3_set(v.position, 1, 0, 0);
-	vec4_set(v.uv[0], 1, 0, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	v        = m_boxTris->At(2);
-	vec3_set(v.position, 0, 1, 0);
-	vec4_set(v.uv[0], 0, 1, 0, 0);
-	*v.color = 0xFFFFFFFF;
-	v        = m_boxTris->At(3);
-	vec3_set(v.position, 1, 1, 0);
-	vec4_set(v.uv[0], 1, 1, 0, 0);
-	*v.color = 0xFFFFFFFF;
+	vec3* box = m_boxTris->GetPositions();
+	vec3_set(&box[0], 0, 0, 0);
+	vec3_set(&box[1], 1, 0, 0);
+	vec3_set(&box[2], 0, 1, 0);
+	vec3_set(&box[3], 1, 1, 0);
 	m_boxTris->Update();
 
+	// Selection overlay
+	m_overlayTriangles  = std::make_unique<GS::StreamVertexBuffer>(overlayVertexCapacity, overlayStreams);
+	m_overlayLines      = std::make_unique<GS::StreamVertexBuffer>(overlayVertexCapacity, overlayStreams);
+	m_overlayGuidelines = std::make_unique<GS::StreamVertexBuffer>(overlayVertexCapacity, overlayStreams);
+
 	// Text
-	m_textVertices = new GS::VertexBuffer(65535);
+	m_textVertices = std::make_unique<GS::StreamVertexBuffer>(textVertexCapacity, GS::STREAM_POSITIONS | GS::STREAM_UVS);
 	m_textEffect   = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 	m_textTexture  = gs_texture_create_from_file((g_moduleDirectory + "/resources/roboto.png").c_str());
 	if (!m_textTexture) {
@@ -364,6 +339,7 @@ OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode)
 	m_renderingMode = mode;
 
 	obs_display_add_draw_callback(m_display, DisplayCallback, this);
+	obs_add_tick_callback(DisplayTick, this);
 }
 
 OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode, std::string sourceName)
@@ -375,6 +351,7 @@ OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode,
 
 OBS::Display::~Display()
 {
+	obs_remove_tick_callback(DisplayTick, this);
 	obs_display_remove_draw_callback(m_display, DisplayCallback, this);
 
 	if (m_source) {
@@ -386,16 +363,15 @@ OBS::Display::~Display()
 
 	obs_enter_graphics();
 
-	if (m_textVertices) {
-		delete m_textVertices;
-	}
-
 	if (m_textTexture) {
 		gs_texture_destroy(m_textTexture);
 	}
 
-	m_boxLine = nullptr;
-	m_boxTris = nullptr;
+	m_textVertices      = nullptr;
+	m_overlayTriangles  = nullptr;
+	m_overlayLines      = nullptr;
+	m_overlayGuidelines = nullptr;
+	m_boxTris           = nullptr;
 	obs_leave_graphics();
 
 #ifdef _WIN32
@@ -537,6 +513,8 @@ void OBS::Display::setSizeCall(int step)
 
 void OBS::Display::SetSize(uint32_t width, uint32_t height)
 {
+	m_throttle.SetSize(width, height);
+
 #ifdef WIN32
 	if (m_source != NULL) {
        std::string msg = "<" + std::string(__FUNCTION__) + "> Adjusting display size for source %s to %ldx%ld. hwnd %d";
@@ -628,102 +606,21 @@ void OBS::Display::SetResizeBoxInnerColor(uint8_t r, uint8_t g, uint8_t b, uint8
 	m_resizeInnerColor = a << 24 | b << 16 | g << 8 | r;
 }
 
-static void
-    DrawGlyph(GS::VertexBuffer* vb, float_t x, float_t y, float_t scale, float_t depth, char glyph, uint32_t color)
+static void AppendTextRun(GS::StreamVertexBuffer* vb, const GS::TextRun& run, float_t x, float_t y)
 {
-	float uvX = 0, uvY = 0, uvO = 1.0 / 4.0;
-	switch (glyph) {
-	default:
+	uint32_t bs    = vb->Size();
+	uint32_t count = uint32_t(run.positions.size());
+	if (bs + count > textVertexCapacity)
 		return;
-		break;
-	case '1':
-		uvX = 0;
-		uvY = 0;
-		break;
-	case '2':
-		uvX = uvO;
-		uvY = 0;
-		break;
-	case '3':
-		uvX = uvO * 2;
-		uvY = 0;
-		break;
-	case '4':
-		uvX = uvO * 3;
-		uvY = 0;
-		break;
-	case '5':
-		uvX = 0;
-		uvY = uvO * 1;
-		break;
-	case '6':
-		uvX = uvO;
-		uvY = uvO * 1;
-		break;
-	case '7':
-		uvX = uvO * 2;
-		uvY = uvO * 1;
-		break;
-	case '8':
-		uvX = uvO * 3;
-		uvY = uvO * 1;
-		break;
-	case '9':
-		uvX = 0;
-		uvY = uvO * 2;
-		break;
-	case '0':
-		uvX = uvO;
-		uvY = uvO * 2;
-		break;
-	case 'p':
-		uvX = uvO * 2;
-		uvY = uvO * 2;
-		break;
-	case 'x':
-		uvX = uvO * 3;
-		uvY = uvO * 2;
-		break;
-	}
+	vb->Resize(bs + count);
 
-	GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-	size_t     bs = vb->Size();
-	vb->Resize(uint32_t(bs + 6));
-
-	// Top Left
-	v = vb->At(uint32_t(bs + 0));
-	vec3_set(v.position, x, y, depth);
-	vec4_set(v.uv[0], uvX, uvY, 0, 0);
-	*v.color = color;
-	// Top Right
-	v = vb->At(uint32_t(bs + 1));
-	vec3_set(v.position, x + scale, y, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY, 0, 0);
-	*v.color = color;
-	// Bottom Left
-	v = vb->At(uint32_t(bs + 2));
-	vec3_set(v.position, x, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX, uvY + uvO, 0, 0);
-	*v.color = color;
-
-	// Top Right
-	v = vb->At(uint32_t(bs + 3));
-	vec3_set(v.position, x + scale, y, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY, 0, 0);
-	*v.color = color;
-	// Bottom Left
-	v = vb->At(uint32_t(bs + 4));
-	vec3_set(v.position, x, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX, uvY + uvO, 0, 0);
-	*v.color = color;
-	// Bottom Right
-	v = vb->At(uint32_t(bs + 5));
-	vec3_set(v.position, x + scale, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY + uvO, 0, 0);
-	*v.color = color;
+	vec3* positions = vb->GetPositions() + bs;
+	for (uint32_t n = 0; n < count; n++) {
+		vec3_set(&positions[n], run.positions[n].x + x, run.positions[n].y + y, run.positions[n].z);
+	}
+	memcpy(vb->GetUVLayer(0) + bs, run.uvs.data(), count * sizeof(vec4));
 }
 
-#define HANDLE_RADIUS 5.0f
 #define HANDLE_DIAMETER 10.0f
 
 inline bool CloseFloat(float a, float b, float epsilon = 0.01)
@@ -731,108 +628,6 @@ inline bool CloseFloat(float a, float b, float epsilon = 0.01)
 	return abs(a - b) <= epsilon;
 }
 
-inline void DrawOutline(OBS::Display* dp, matrix4& mtx, obs_transform_info& info)
-{
-	gs_matrix_push();
-	gs_matrix_set(&mtx);
-	gs_draw(GS_LINESTRIP, 0, 0);
-	gs_matrix_pop();
-}
-
-inline void DrawBoxAt(OBS::Display* dp, float_t x, float_t y, matrix4& mtx)
-{
-	gs_matrix_push();
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
-
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(
-	    HANDLE_DIAMETER * dp->m_previewToWorldScale.x,
-		HANDLE_DIAMETER * dp->m_previewToWorldScale.y,
-		1.0f);
-
-	gs_draw(GS_LINESTRIP, 0, 0);
-	gs_matrix_pop();
-}
-
-inline void DrawSquareAt(OBS::Display* dp, float_t x, float_t y, matrix4& mtx)
-{
-	gs_matrix_push();
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
-
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(
-	    HANDLE_DIAMETER * dp->m_previewToWorldScale.x,
-		HANDLE_DIAMETER * dp->m_previewToWorldScale.y,
-		1.0f);
-
-	gs_draw(GS_TRISTRIP, 0, 0);
-	gs_matrix_pop();
-}
-
-inline void DrawGuideline(OBS::Display* dp, float_t x, float_t y, matrix4& mtx)
-{
-	gs_rect rect;
-	rect.x  = dp->GetPreviewOffset().first;
-	rect.y  = dp->GetPreviewOffset().second;
-	rect.cx = dp->GetPreviewSize().first;
-	rect.cy = dp->GetPreviewSize().second;
-
-	gs_set_scissor_rect(&rect);
-	gs_matrix_push();
-
-	vec3 center = {0.5, 0.5, 0.0f};
-	vec3_transform(&center, &center, &mtx);
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 normal;
-	vec3_sub(&normal, &center, &pos);
-	vec3_norm(&normal, &normal);
-
-	gs_matrix_translate(&pos);
-
-	vec3 up = {0, 1.0, 0};
-	vec3 dn = {0, -1.0, 0};
-	vec3 lt = {-1.0, 0, 0};
-	vec3 rt = {1.0, 0, 0};
-
-	if (vec3_dot(&up, &normal) > 0.5f) {
-		// Dominantly looking up.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(-90.0f));
-	} else if (vec3_dot(&dn, &normal) > 0.5f) {
-		// Dominantly looking down.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(90.0f));
-	} else if (vec3_dot(&lt, &normal) > 0.5f) {
-		// Dominantly looking left.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(0.0f));
-	} else if (vec3_dot(&rt, &normal) > 0.5f) {
-		// Dominantly looking right.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(180.0f));
-	}
-
-	gs_matrix_scale3f(65535, 65535, 65535);
-
-	gs_draw(GS_LINES, 0, 2);
-
-	gs_matrix_pop();
-	gs_set_scissor_rect(nullptr);
-}
-
 bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item, void* param)
 {
 	// This is partially code from OBS Studio. See window-basic-preview.cpp in obs-studio for copyright/license.
@@ -878,80 +673,28 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item,
 
 	OBS::Display* dp = reinterpret_cast<OBS::Display*>(param);
 
-	vec4         color;
-	gs_effect_t* solid       = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t* solid_color = gs_effect_get_param_by_name(solid, "color");
-
-	obs_transform_info info;
-	obs_sceneitem_get_info(item, &info);
-
-	gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-	vec4_set(
-	    &color,
-	    (dp->m_outlineColor & 0xFF) / 255.0f,
-	    ((dp->m_outlineColor & 0xFF00) >> 8) / 255.0f,
-	    ((dp->m_outlineColor & 0xFF0000) >> 16) / 255.0f,
-	    ((dp->m_outlineColor & 0xFF000000) >> 24) / 255.0f);
-	gs_effect_set_vec4(solid_color, &color);
-	DrawOutline(dp, boxTransform, info);
-
-	gs_load_vertexbuffer(dp->m_boxTris->Update(false));
-	vec4_set(
-	    &color,
-	    (dp->m_resizeInnerColor & 0xFF) / 255.0f,
-	    ((dp->m_resizeInnerColor & 0xFF00) >> 8) / 255.0f,
-	    ((dp->m_resizeInnerColor & 0xFF0000) >> 16) / 255.0f,
-	    ((dp->m_resizeInnerColor & 0xFF000000) >> 24) / 255.0f);
-	gs_effect_set_vec4(solid_color, &color);
-	DrawSquareAt(dp, 0, 0, boxTransform);
-	DrawSquareAt(dp, 1, 0, boxTransform);
-	DrawSquareAt(dp, 0, 1, boxTransform);
-	DrawSquareAt(dp, 1, 1, boxTransform);
-	DrawSquareAt(dp, 0.5, 0, boxTransform);
-	DrawSquareAt(dp, 0.5, 1, boxTransform);
-	DrawSquareAt(dp, 0, 0.5, boxTransform);
-	DrawSquareAt(dp, 1, 0.5, boxTransform);
-
-	gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-	vec4_set(
-	    &color,
-	    (dp->m_resizeOuterColor & 0xFF) / 255.0f,
-	    ((dp->m_resizeOuterColor & 0xFF00) >> 8) / 255.0f,
-	    ((dp->m_resizeOuterColor & 0xFF0000) >> 16) / 255.0f,
-	    ((dp->m_resizeOuterColor & 0xFF000000) >> 24) / 255.0f);
-	gs_effect_set_vec4(solid_color, &color);
-	DrawBoxAt(dp, 0, 0, boxTransform);
-	DrawBoxAt(dp, 1, 0, boxTransform);
-	DrawBoxAt(dp, 0, 1, boxTransform);
-	DrawBoxAt(dp, 1, 1, boxTransform);
-	DrawBoxAt(dp, 0.5, 0, boxTransform);
-	DrawBoxAt(dp, 0.5, 1, boxTransform);
-	DrawBoxAt(dp, 0, 0.5, boxTransform);
-	DrawBoxAt(dp, 1, 0.5, boxTransform);
+	vec2 handleSize;
+	handleSize.x = HANDLE_DIAMETER * dp->m_previewToWorldScale.x;
+	handleSize.y = HANDLE_DIAMETER * dp->m_previewToWorldScale.y;
 
-	if (dp->m_drawGuideLines) {
-		vec4_set(
-		    &color,
-		    (dp->m_guidelineColor & 0xFF) / 255.0f,
-		    ((dp->m_guidelineColor & 0xFF00) >> 8) / 255.0f,
-		    ((dp->m_guidelineColor & 0xFF0000) >> 16) / 255.0f,
-		    ((dp->m_guidelineColor & 0xFF000000) >> 24) / 255.0f);
-		gs_effect_set_vec4(solid_color, &color);
-		DrawGuideline(dp, 0.5, 0, boxTransform);
-		DrawGuideline(dp, 0.5, 1, boxTransform);
-		DrawGuideline(dp, 0, 0.5, boxTransform);
-		DrawGuideline(dp, 1, 0.5, boxTransform);
+	dp->m_overlay.AddOutline(boxTransform, dp->m_outlineColor);
 
-		// TEXT RENDERING
-		// THIS DESPERATELY NEEDS TO BE REWRITTEN INTO SHADER CODE
-		// DO SO WHENEVER...
-		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
+	const float_t handles[8][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {0.5, 0}, {0.5, 1}, {0, 0.5}, {1, 0.5}};
+	for (size_t n = 0; n < 8; n++) {
+		dp->m_overlay.AddHandle(
+		    handles[n][0], handles[n][1], boxTransform, handleSize, dp->m_resizeInnerColor, dp->m_resizeOuterColor);
+	}
 
-		matrix4 itemMatrix, sceneToView;
+	if (dp->m_drawGuideLines) {
+		dp->m_overlay.AddGuideline(0.5, 0, boxTransform, dp->m_guidelineColor);
+		dp->m_overlay.AddGuideline(0.5, 1, boxTransform, dp->m_guidelineColor);
+		dp->m_overlay.AddGuideline(0, 0.5, boxTransform, dp->m_guidelineColor);
+		dp->m_overlay.AddGuideline(1, 0.5, boxTransform, dp->m_guidelineColor);
+
+		// Distance labels, the glyph runs come from a cache and are only laid out
+		// into the text vertex buffer when the set of labels changes.
+		matrix4 itemMatrix;
 		obs_sceneitem_get_box_transform(item, &itemMatrix);
-		matrix4_identity(&sceneToView);
-		sceneToView.x.x = dp->m_worldToPreviewScale.x;
-		sceneToView.y.y = dp->m_worldToPreviewScale.y;
 
 		// Retrieve actual corner and edge positions.
 		vec3 edge[4], center;
@@ -967,11 +710,9 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item,
 
 			vec3_set(&center, 0.5, 0.5, 0);
 			vec3_transform(&center, &center, &itemMatrix);
-			;
 		}
 
-		std::vector<char> buf(8);
-		float_t           pt = 8 * dp->m_previewToWorldScale.y;
+		float_t pt = 8 * dp->m_previewToWorldScale.y;
 		for (size_t n = 0; n < 4; n++) {
 			bool isIn = (edge[n].x >= 0) && (edge[n].x < sceneWidth) && (edge[n].y >= 0) && (edge[n].y < sceneHeight);
 
@@ -985,93 +726,119 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item,
 			vec3_sub(&temp, &edge[n], &center);
 			vec3_norm(&temp, &temp);
 			float left = vec3_dot(&temp, &alignLeft), top = vec3_dot(&temp, &alignTop);
+
+			GS::TextLabel label;
+			label.size  = pt;
 			if (left > 0.5) { // LEFT
 				float_t dist = edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    (edge[n].x / 2) - offset + (p * pt),
-						    edge[n].y - pt * 2,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
+				if (dist <= (pt * 4))
+					continue;
+				label.pixels = (uint32_t)dist;
+				size_t len   = dp->m_textRuns.GetDistanceLabel(label.pixels, pt).length;
+				label.x      = (edge[n].x / 2) - float((pt * len) / 2.0);
+				label.y      = edge[n].y - pt * 2;
 			} else if (left < -0.5) { // RIGHT
 				float_t dist = sceneWidth - edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    edge[n].x + (dist / 2) - offset + (p * pt),
-						    edge[n].y - pt * 2,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
+				if (dist <= (pt * 4))
+					continue;
+				label.pixels = (uint32_t)dist;
+				size_t len   = dp->m_textRuns.GetDistanceLabel(label.pixels, pt).length;
+				label.x      = edge[n].x + (dist / 2) - float((pt * len) / 2.0);
+				label.y      = edge[n].y - pt * 2;
 			} else if (top > 0.5) { // UP
 				float_t dist = edge[n].y;
-				if (dist > pt) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    edge[n].x + (p * pt),
-						    edge[n].y - (dist / 2) - pt,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
+				if (dist <= pt)
+					continue;
+				label.pixels = (uint32_t)dist;
+				label.x      = edge[n].x;
+				label.y      = edge[n].y - (dist / 2) - pt;
 			} else if (top < -0.5) { // DOWN
 				float_t dist = sceneHeight - edge[n].y;
-				if (dist > (pt * 4)) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    edge[n].x + (p * pt),
-						    edge[n].y + (dist / 2) - pt,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
+				if (dist <= (pt * 4))
+					continue;
+				label.pixels = (uint32_t)dist;
+				label.x      = edge[n].x;
+				label.y      = edge[n].y + (dist / 2) - pt;
+			} else {
+				continue;
 			}
+			dp->m_textLabels.push_back(label);
 		}
 	}
 
 	return true;
 }
 
+static void DrawOverlayVertices(GS::StreamVertexBuffer* vb, const GS::OverlayVertices& vertices, gs_draw_mode mode)
+{
+	size_t total = vertices.Size();
+	size_t draws = vertices.Draws(overlayVertexCapacity);
+	for (size_t draw = 0; draw < draws; draw++) {
+		size_t   offset = draw * overlayVertexCapacity;
+		uint32_t count  = uint32_t(std::min<size_t>(overlayVertexCapacity, total - offset));
+
+		// Unchanged overlays, e.g. a static selection, end up without any upload.
+		vb->Resize(count);
+		vb->WritePositions(0, vertices.positions.data() + offset, count);
+		vb->WriteColors(0, vertices.colors.data() + offset, count);
+
+		gs_load_vertexbuffer(vb->Update());
+		gs_load_indexbuffer(nullptr);
+		gs_draw(mode, 0, count);
+	}
+}
+
+void OBS::Display::SetMaxFPS(uint32_t fps)
+{
+	m_throttle.SetMaxFPS(fps);
+}
+
+uint32_t OBS::Display::GetMaxFPS()
+{
+	return m_throttle.GetMaxFPS();
+}
+
+void OBS::Display::SetHidden(bool hidden)
+{
+	m_throttle.SetHidden(hidden);
+}
+
+bool OBS::Display::GetHidden()
+{
+	return m_throttle.GetHidden();
+}
+
+std::pair<uint64_t, uint64_t> OBS::Display::GetRenderStats()
+{
+	return m_throttle.GetStats();
+}
+
+void OBS::Display::DisplayTick(void* displayPtr, float seconds)
+{
+	Display* dp = static_cast<Display*>(displayPtr);
+
+	bool render = dp->m_throttle.Tick(os_gettime_ns(), seconds);
+	if (render != dp->m_renderEnabled) {
+		obs_display_set_enabled(dp->m_display, render);
+		dp->m_renderEnabled = render;
+	}
+}
+
 void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 {
 	Display*        dp          = static_cast<Display*>(displayPtr);
 	gs_effect_t*    solid       = obs_get_base_effect(OBS_EFFECT_SOLID);
 	gs_eparam_t*    solid_color = gs_effect_get_param_by_name(solid, "color");
 	gs_technique_t* solid_tech  = gs_effect_get_technique(solid, "Solid");
+	gs_technique_t* solid_colored_tech = gs_effect_get_technique(solid, "SolidColored");
 	vec4            color;
 
+	if (cx == 0 || cy == 0) {
+		dp->m_throttle.CountSkipped();
+		return;
+	}
+	dp->m_throttle.CountRendered();
+
 	dp->UpdatePreviewArea();
 
 	// Get proper source/base size.
@@ -1127,7 +894,7 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 		gs_matrix_identity();
 		gs_matrix_scale3f(float(sourceW), float(sourceH), 1.0f);
 
-		gs_load_vertexbuffer(dp->m_boxTris->Update(false));
+		gs_load_vertexbuffer(dp->m_boxTris->Get());
 		gs_draw(GS_TRISTRIP, 0, 0);
 
 		gs_matrix_pop();
@@ -1194,17 +961,54 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 		 * that are actually scenes and our main transition scene */
 
 		if (scene) {
-			dp->m_textVertices->Resize(0);
-
-			gs_technique_begin(solid_tech);
-			gs_technique_begin_pass(solid_tech, 0);
+			dp->m_textRuns.Trim();
+			dp->m_textLabels.clear();
+			dp->m_overlay.Clear();
 
 			obs_scene_enum_items(scene, DrawSelectedSource, dp);
 
-			gs_technique_end_pass(solid_tech);
-			gs_technique_end(solid_tech);
+			if (!dp->m_overlay.Empty()) {
+				// Colors come from the vertices, so the uniform only has to be neutral.
+				vec4_set(&color, 1.0f, 1.0f, 1.0f, 1.0f);
+				gs_effect_set_vec4(solid_color, &color);
+
+				gs_technique_begin(solid_colored_tech);
+				gs_technique_begin_pass(solid_colored_tech, 0);
+
+				gs_matrix_push();
+				gs_matrix_identity();
+
+				DrawOverlayVertices(dp->m_overlayTriangles.get(), dp->m_overlay.GetTriangles(), GS_TRIS);
+				DrawOverlayVertices(dp->m_overlayLines.get(), dp->m_overlay.GetLines(), GS_LINES);
+
+				gs_rect rect;
+				rect.x  = dp->m_previewOffset.first;
+				rect.y  = dp->m_previewOffset.second;
+				rect.cx = dp->m_previewSize.first;
+				rect.cy = dp->m_previewSize.second;
+				gs_set_scissor_rect(&rect);
+				DrawOverlayVertices(dp->m_overlayGuidelines.get(), dp->m_overlay.GetGuidelines(), GS_LINES);
+				gs_set_scissor_rect(nullptr);
+
+				gs_matrix_pop();
+
+				gs_technique_end_pass(solid_colored_tech);
+				gs_technique_end(solid_colored_tech);
+			}
 
 			// Text Rendering
+			if (dp->m_textLabels != dp->m_lastTextLabels) {
+				dp->m_textVertices->Resize(0);
+				for (const GS::TextLabel& label : dp->m_textLabels) {
+					AppendTextRun(
+					    dp->m_textVertices.get(),
+					    dp->m_textRuns.GetDistanceLabel(label.pixels, label.size),
+					    label.x,
+					    label.y);
+				}
+				dp->m_lastTextLabels.swap(dp->m_textLabels);
+			}
+
 			if (dp->m_textVertices->Size() > 0) {
 				gs_vertbuffer_t* vb = dp->m_textVertices->Update();
 				while (gs_effect_loop(dp->m_textEffect, "Draw")) {
@@ -19,11 +19,15 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <system_error>
 #include <thread>
 #include <vector>
-#include "gs-vertexbuffer.h"
+#include "gs-overlay.h"
+#include "gs-streamvertexbuffer.h"
+#include "gs-text.h"
+#include "util-displaythrottle.h"
 #include "obs.h"
 #include "ipc-server.hpp"
 
@@ -88,8 +92,18 @@ namespace OBS
 		void SetDrawGuideLines(bool drawGuideLines);
 		void UpdatePreviewArea();
 
+		// Render at most fps frames per second, 0 renders every output frame.
+		void     SetMaxFPS(uint32_t fps);
+		uint32_t GetMaxFPS();
+		// Hidden displays, like zero sized ones, skip rendering entirely.
+		void SetHidden(bool hidden);
+		bool GetHidden();
+		// Frames drawn and frames skipped since the display was created.
+		std::pair<uint64_t, uint64_t> GetRenderStats();
+
 		private:
 		static void DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy);
+		static void DisplayTick(void* displayPtr, float seconds);
 		static bool DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item, void* param);
 		void        setSizeCall(int step);
 
@@ -114,9 +128,22 @@ namespace OBS
 		gs_effect_t * m_gsSolidEffect, *m_textEffect;
 		gs_texture_t* m_textTexture;
 
-		GS::VertexBuffer* m_textVertices;
+		std::unique_ptr<GS::StreamVertexBuffer> m_textVertices;
+
+		// Distance labels of this and the previous frame, the text vertices are
+		// only rebuilt and uploaded when they differ.
+		GS::TextRunCache           m_textRuns;
+		std::vector<GS::TextLabel> m_textLabels;
+		std::vector<GS::TextLabel> m_lastTextLabels;
 
-		std::unique_ptr<GS::VertexBuffer> m_boxLine, m_boxTris;
+		std::unique_ptr<GS::StreamVertexBuffer> m_boxTris;
+
+		// Selection overlay, collected on the CPU and drawn in a few batches.
+		// Every batch keeps its own buffer so unchanged geometry is not uploaded again.
+		GS::OverlayBatch                        m_overlay;
+		std::unique_ptr<GS::StreamVertexBuffer> m_overlayTriangles;
+		std::unique_ptr<GS::StreamVertexBuffer> m_overlayLines;
+		std::unique_ptr<GS::StreamVertexBuffer> m_overlayGuidelines;
 
 		// Theme/Style
 		/// Padding
@@ -132,6 +159,14 @@ namespace OBS
 
 		enum obs_video_rendering_mode m_renderingMode = OBS_MAIN_VIDEO_RENDERING;
 
+		// Render throttling, decided on the video thread's tick before the
+		// displays are drawn. A skipped frame disables the obs_display so it is
+		// neither cleared nor presented and keeps showing the last frame. The
+		// throttle keeps its own copy of the size, m_gsInitData is not touched
+		// from the video thread.
+		util::DisplayThrottle m_throttle{960, 540};
+		bool                  m_renderEnabled = true;
+
 #if defined(_WIN32)
 		HWND              m_ourWindow;
 		HWND              m_parentWindow;
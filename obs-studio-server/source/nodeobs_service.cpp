@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "nodeobs_service.h"
+#include <atomic>
 #ifdef WIN32
 #include <ShlObj.h>
 #include <windows.h>
@@ -25,6 +26,7 @@
 #include "error.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include "util-startuptrace.h"
 
 #ifdef __APPLE__
 #include <sys/types.h>
@@ -32,9 +34,12 @@
 #endif
 
 obs_output_t* streamingOutput    = nullptr;
-obs_output_t* recordingOutput    = nullptr;
 obs_output_t* replayBufferOutput = nullptr;
 
+// The segment worker swaps this for the next segment while other threads read it. The outputs it
+// replaces are released on the thread that stops the worker, see releaseRetiredSegments.
+std::atomic<obs_output_t*> recordingOutput(nullptr);
+
 obs_output_t* virtualWebcamOutput = nullptr;
 
 obs_encoder_t* audioSimpleStreamingEncoder   = nullptr;
@@ -62,10 +67,35 @@ bool        isReplayBufferActive = false;
 bool        rpUsesRec            = false;
 bool        rpUsesStream         = false;
 
-std::mutex             signalMutex;
-std::queue<SignalInfo> outputSignal;
+SignalRing             outputSignal(256);
+bool                   outputSignalsConnected = false;
 std::thread            releaseWorker;
 
+// The recording output stays armed as long as the settings generation and the
+// conditions it was built under are the same as at start time. The generation
+// is also bumped from the autoconfig thread.
+bool                  recordingArmed           = false;
+bool                  recordingArmedSimpleMode = false;
+std::string           recordingArmedConditions;
+std::atomic<uint64_t> recordingSettingsGeneration(0);
+uint64_t              recordingArmedGeneration = 0;
+double                recordingStartLatency    = 0.0;
+bool                  recordingStartWasArmed   = false;
+
+// Segmented recording, configured by updateFfmpegOutput. The worker rolls the recording over to a
+// new file and hands the closed segment to the finalizer thread.
+bool                    recordingSplit          = false;
+uint64_t                recordingSplitTimeNs    = 0;
+uint64_t                recordingSplitSizeBytes = 0;
+uint64_t                segmentStartTime        = 0;
+bool                    segmentWorkerStop       = false;
+std::atomic<bool>       recordingSegmented(false);
+std::mutex              segmentMutex;
+std::condition_variable segmentCondition;
+std::thread             segmentWorker;
+std::thread             segmentFinalizer;
+std::vector<obs_output_t*> retiredSegments;
+
 static constexpr int kSoundtrackArchiveEncoderIdx = 1;
 static constexpr int kSoundtrackArchiveTrackIdx = 5;
 static obs_encoder_t *archiveEncoder = nullptr;
@@ -85,6 +115,8 @@ void OBS_service::Register(ipc::server& srv)
 	    "OBS_service_startStreaming", std::vector<ipc::type>{}, OBS_service_startStreaming));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_service_startRecording", std::vector<ipc::type>{}, OBS_service_startRecording));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_armRecording", std::vector<ipc::type>{}, OBS_service_armRecording));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_service_startReplayBuffer", std::vector<ipc::type>{}, OBS_service_startReplayBuffer));
 	cls->register_function(std::make_shared<ipc::function>(
@@ -185,6 +217,26 @@ void OBS_service::OBS_service_startRecording(
 	AUTO_DEBUG;
 }
 
+void OBS_service::OBS_service_armRecording(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	if (isRecordingOutputActive() || isRecordingArmed()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		AUTO_DEBUG;
+		return;
+	}
+
+	if (!armRecording()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to arm recording!");
+	} else {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	}
+	AUTO_DEBUG;
+}
+
 void OBS_service::OBS_service_startReplayBuffer(
     void*                          data,
     const int64_t                  id,
@@ -242,6 +294,10 @@ void OBS_service::OBS_service_stopReplayBuffer(
 
 bool OBS_service::resetAudioContext(bool reload)
 {
+	util::StartupTrace::Scope scope("reset", "audio");
+
+	invalidateRecordingArm();
+
 	struct obs_audio_info ai;
 
 	if (reload)
@@ -421,6 +477,10 @@ static const size_t numVals = sizeof(vals) / sizeof(double);
 
 int OBS_service::resetVideoContext(bool reload)
 {
+	util::StartupTrace::Scope scope("reset", "video");
+
+	invalidateRecordingArm();
+
 	obs_video_info ovi;
 	std::string    gslib = "";
 #ifdef _WIN32
@@ -936,22 +996,21 @@ bool OBS_service::startStreaming(void)
 
 	isStreaming = obs_output_start(streamingOutput);
 	if (!isStreaming) {
-		SignalInfo  signal = SignalInfo("streaming", "stop");
+		SignalInfo  signal = SignalInfo(OutputType::Streaming, OutputSignal::Stop);
 		std::string outdated_driver_error = outdated_driver_error::instance()->get_error();
 		if (outdated_driver_error.size() != 0) {
-			signal.setErrorMessage(outdated_driver_error);
-			signal.setCode(OBS_OUTPUT_OUTDATED_DRIVER);
+			signal.errorMessage = outdated_driver_error;
+			signal.code         = OBS_OUTPUT_OUTDATED_DRIVER;
 		} else {
 			const char* error = obs_output_get_last_error(streamingOutput);
 			if (error) {
-				signal.setErrorMessage(error);
+				signal.errorMessage = error;
 				blog(LOG_INFO, "Last streaming error: %s", error);
 			}
-			signal.setCode(OBS_OUTPUT_ERROR);
+			signal.code = OBS_OUTPUT_ERROR;
 		}
 
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		outputSignal.push(std::move(signal));
 	}
 	return isStreaming;
 }
@@ -1113,8 +1172,35 @@ bool OBS_service::updateRecordingEncoders(bool isSimpleMode)
 	return useStreamEncoder;
 }
 
-bool OBS_service::startRecording(void)
+static std::string RecordingArmConditions(void)
 {
+	const char* mode    = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "Mode");
+	const char* quality = config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecQuality");
+	const char* encoder = config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecEncoder");
+
+	std::string conditions;
+	conditions += mode ? mode : "";
+	conditions += '|';
+	conditions += quality ? quality : "";
+	conditions += '|';
+	conditions += encoder ? encoder : "";
+	conditions += '|';
+	conditions += obs_get_multiple_rendering() ? '1' : '0';
+	conditions += std::to_string(int(obs_get_replay_buffer_rendering_mode()));
+	conditions += isReplayBufferActive ? '1' : '0';
+	conditions += isStreaming ? '1' : '0';
+	return conditions;
+}
+
+bool OBS_service::armRecording(void)
+{
+	if (isRecordingOutputActive())
+		return false;
+
+	stopSegmentWorker();
+
+	recordingArmed = false;
+
 	if (recordingOutput)
 		obs_output_release(recordingOutput);
 
@@ -1142,7 +1228,6 @@ bool OBS_service::startRecording(void)
 			useStreamEncoder = updateRecordingEncoders(isSimpleMode);
 		}
 	}
-	updateFfmpegOutput(isSimpleMode, recordingOutput);
 
 	obs_output_set_video_encoder(recordingOutput, useStreamEncoder ? videoStreamingEncoder : videoRecordingEncoder);
 	if (isSimpleMode) {
@@ -1161,23 +1246,83 @@ bool OBS_service::startRecording(void)
 		}
 	}
 
+	recordingArmedSimpleMode = isSimpleMode;
+
+	// Encoders are only attached here, not initialized: hardware encoders hold
+	// a session for as long as they are initialized, even while idle.
+	if (!obs_output_can_begin_data_capture(recordingOutput, 0)) {
+		blog(LOG_WARNING, "Recording output could not be armed, it will be rebuilt on start");
+		return false;
+	}
+
+	recordingArmed           = true;
+	recordingArmedConditions = RecordingArmConditions();
+	recordingArmedGeneration = recordingSettingsGeneration;
+	return true;
+}
+
+bool OBS_service::isRecordingArmed(void)
+{
+	return recordingArmed && recordingOutput && recordingArmedGeneration == recordingSettingsGeneration
+	       && recordingArmedConditions == RecordingArmConditions();
+}
+
+void OBS_service::invalidateRecordingArm(void)
+{
+	recordingSettingsGeneration++;
+}
+
+double OBS_service::getRecordingStartLatency(void)
+{
+	return recordingStartLatency;
+}
+
+bool OBS_service::getRecordingStartWasArmed(void)
+{
+	return recordingStartWasArmed;
+}
+
+bool OBS_service::startRecording(void)
+{
+	uint64_t startTime = os_gettime_ns();
+
+	stopSegmentWorker();
+
+	bool wasArmed = isRecordingArmed();
+	if (!wasArmed)
+		armRecording();
+	if (!recordingOutput)
+		return false;
+
+	// The file name carries the start time, so it is the one thing that can't be prepared ahead.
+	updateFfmpegOutput(recordingArmedSimpleMode, recordingOutput);
+
 	isRecording = obs_output_start(recordingOutput);
+
+	recordingStartLatency  = double(os_gettime_ns() - startTime) / 1000000.0;
+	recordingStartWasArmed = wasArmed;
+	blog(LOG_INFO, "Recording start took %.2f ms (%s)", recordingStartLatency, wasArmed ? "armed" : "cold");
+
+	if (isRecording && recordingSplit)
+		startSegmentWorker();
+
 	if (!isRecording) {
-		SignalInfo signal = SignalInfo("recording", "stop");
+		recordingArmed = false;
+
+		SignalInfo signal = SignalInfo(OutputType::Recording, OutputSignal::Stop);
 		std::string outdated_driver_error = outdated_driver_error::instance()->get_error();
 		if (outdated_driver_error.size() != 0) {
-			signal.setErrorMessage(outdated_driver_error);
-			signal.setCode(OBS_OUTPUT_OUTDATED_DRIVER);
+			signal.errorMessage = outdated_driver_error;
+			signal.code         = OBS_OUTPUT_OUTDATED_DRIVER;
 		} else {
 			const char* error = obs_output_get_last_error(recordingOutput);
 			if (error) {
-				signal.setErrorMessage(error);
+				signal.errorMessage = error;
 				blog(LOG_INFO, "Last recording error: %s", error);
 			}
-			signal.setCode(OBS_OUTPUT_ERROR);
+			signal.code = OBS_OUTPUT_ERROR;
 		}
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		outputSignal.push(std::move(signal));
 	}
 	return isRecording;
 }
@@ -1206,6 +1351,7 @@ void OBS_service::stopStreaming(bool forceStop)
 
 void OBS_service::stopRecording(void)
 {
+	stopSegmentWorker();
 	obs_output_stop(recordingOutput);
 	isRecording = false;
 }
@@ -1339,24 +1485,23 @@ bool OBS_service::startReplayBuffer(void)
 
 	bool result = obs_output_start(replayBufferOutput);
 	if (!result) {
-		SignalInfo signal    = SignalInfo("replay-buffer", "stop");
+		SignalInfo signal    = SignalInfo(OutputType::ReplayBuffer, OutputSignal::Stop);
 		isReplayBufferActive = false;
 		rpUsesRec            = false;
 		rpUsesStream         = false;
 		std::string outdated_driver_error = outdated_driver_error::instance()->get_error();
 		if (outdated_driver_error.size() != 0) {
-			signal.setErrorMessage(outdated_driver_error);
-			signal.setCode(OBS_OUTPUT_OUTDATED_DRIVER);
+			signal.errorMessage = outdated_driver_error;
+			signal.code         = OBS_OUTPUT_OUTDATED_DRIVER;
 		} else {
 			const char* error = obs_output_get_last_error(replayBufferOutput);
 			if (error) {
-				signal.setErrorMessage(error);
+				signal.errorMessage = error;
 				blog(LOG_INFO, "Last replay buffer error: %s", error);
 			}
-			signal.setCode(OBS_OUTPUT_ERROR);
+			signal.code = OBS_OUTPUT_ERROR;
 		}
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		outputSignal.push(std::move(signal));
 	} else {
 		isReplayBufferActive = true;
 	}
@@ -1661,6 +1806,23 @@ void OBS_service::updateFfmpegOutput(bool isSimpleMode, obs_output_t* output)
 		obs_output_update(output, settings);
 		obs_data_release(settings);
 	}
+
+	// Only the muxer output can be rolled over to a new file
+	const char* section = isSimpleMode ? "SimpleOutput" : "AdvOut";
+	config_t*   basic   = ConfigManager::getInstance().getBasic();
+
+	recordingSplitTimeNs    = 0;
+	recordingSplitSizeBytes = 0;
+	recordingSplit          = !ffmpegOutput && config_get_bool(basic, section, "RecSplitFile");
+	if (recordingSplit) {
+		const char* splitType = config_get_string(basic, section, "RecSplitFileType");
+		if (splitType && strcmp(splitType, "Size") == 0)
+			recordingSplitSizeBytes = config_get_uint(basic, section, "RecSplitFileSize") * 1024 * 1024;
+		else
+			recordingSplitTimeNs = config_get_uint(basic, section, "RecSplitFileTime") * 60 * 1000000000ULL;
+
+		recordingSplit = recordingSplitTimeNs != 0 || recordingSplitSizeBytes != 0;
+	}
 }
 
 void OBS_service::updateAudioTracks()
@@ -1988,6 +2150,7 @@ void OBS_service::setStreamingEncoder(obs_encoder_t* encoder)
 	if (videoStreamingEncoder)
 		obs_encoder_release(videoStreamingEncoder);
 	videoStreamingEncoder = encoder;
+	invalidateRecordingArm();
 }
 
 obs_encoder_t* OBS_service::getRecordingEncoder(void)
@@ -2000,6 +2163,7 @@ void OBS_service::setRecordingEncoder(obs_encoder_t* encoder)
 	if (videoRecordingEncoder)
 		obs_encoder_release(videoRecordingEncoder);
 	videoRecordingEncoder = encoder;
+	invalidateRecordingArm();
 }
 
 obs_encoder_t* OBS_service::getAudioSimpleStreamingEncoder(void)
@@ -2055,6 +2219,7 @@ void OBS_service::setRecordingOutput(obs_output_t* output)
 {
 	obs_output_release(recordingOutput);
 	recordingOutput = output;
+	invalidateRecordingArm();
 }
 
 obs_output_t* OBS_service::getReplayBufferOutput(void)
@@ -2129,9 +2294,69 @@ void OBS_service::updateStreamingOutput()
 	obs_output_set_reconnect_settings(streamingOutput, maxRetries, retryDelay);
 }
 
-std::vector<SignalInfo> streamingSignals;
-std::vector<SignalInfo> recordingSignals;
-std::vector<SignalInfo> replayBufferSignals;
+SignalRing::SignalRing(size_t capacity) : buffer(capacity) {}
+
+void SignalRing::push(SignalInfo&& signal)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+
+	buffer[(head + count) % buffer.size()] = std::move(signal);
+	if (count < buffer.size()) {
+		count++;
+	} else {
+		head = (head + 1) % buffer.size();
+		blog(LOG_WARNING, "Output signal queue is full, dropping the oldest signal.");
+	}
+	nextSequence++;
+}
+
+uint64_t SignalRing::drain(std::vector<SignalInfo>& signals)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+
+	uint64_t firstSequence = nextSequence - count;
+	signals.reserve(signals.size() + count);
+	for (; count > 0; count--) {
+		signals.push_back(std::move(buffer[head]));
+		head = (head + 1) % buffer.size();
+	}
+
+	return firstSequence;
+}
+
+struct OutputSignalDesc
+{
+	OutputType   outputType;
+	OutputSignal signal;
+	const char*  name;
+};
+
+static const OutputSignalDesc streamingSignals[] = {
+    {OutputType::Streaming, OutputSignal::Start, "start"},
+    {OutputType::Streaming, OutputSignal::Stop, "stop"},
+    {OutputType::Streaming, OutputSignal::Starting, "starting"},
+    {OutputType::Streaming, OutputSignal::Stopping, "stopping"},
+    {OutputType::Streaming, OutputSignal::Activate, "activate"},
+    {OutputType::Streaming, OutputSignal::Deactivate, "deactivate"},
+    {OutputType::Streaming, OutputSignal::Reconnect, "reconnect"},
+    {OutputType::Streaming, OutputSignal::ReconnectSuccess, "reconnect_success"},
+};
+
+static const OutputSignalDesc recordingSignals[] = {
+    {OutputType::Recording, OutputSignal::Start, "start"},
+    {OutputType::Recording, OutputSignal::Stop, "stop"},
+    {OutputType::Recording, OutputSignal::Stopping, "stopping"},
+};
+
+static const OutputSignalDesc replayBufferSignals[] = {
+    {OutputType::ReplayBuffer, OutputSignal::Start, "start"},
+    {OutputType::ReplayBuffer, OutputSignal::Stop, "stop"},
+    {OutputType::ReplayBuffer, OutputSignal::Stopping, "stopping"},
+
+    {OutputType::ReplayBuffer, OutputSignal::Writing, "writing"},
+    {OutputType::ReplayBuffer, OutputSignal::Wrote, "wrote"},
+    {OutputType::ReplayBuffer, OutputSignal::WritingError, "writing_error"},
+};
 
 void OBS_service::OBS_service_connectOutputSignals(
     void*                          data,
@@ -2139,27 +2364,7 @@ void OBS_service::OBS_service_connectOutputSignals(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	streamingSignals.push_back(SignalInfo("streaming", "start"));
-	streamingSignals.push_back(SignalInfo("streaming", "stop"));
-	streamingSignals.push_back(SignalInfo("streaming", "starting"));
-	streamingSignals.push_back(SignalInfo("streaming", "stopping"));
-	streamingSignals.push_back(SignalInfo("streaming", "activate"));
-	streamingSignals.push_back(SignalInfo("streaming", "deactivate"));
-	streamingSignals.push_back(SignalInfo("streaming", "reconnect"));
-	streamingSignals.push_back(SignalInfo("streaming", "reconnect_success"));
-
-	recordingSignals.push_back(SignalInfo("recording", "start"));
-	recordingSignals.push_back(SignalInfo("recording", "stop"));
-	recordingSignals.push_back(SignalInfo("recording", "stopping"));
-
-	replayBufferSignals.push_back(SignalInfo("replay-buffer", "start"));
-	replayBufferSignals.push_back(SignalInfo("replay-buffer", "stop"));
-	replayBufferSignals.push_back(SignalInfo("replay-buffer", "stopping"));
-
-	replayBufferSignals.push_back(SignalInfo("replay-buffer", "writing"));
-	replayBufferSignals.push_back(SignalInfo("replay-buffer", "wrote"));
-	replayBufferSignals.push_back(SignalInfo("replay-buffer", "writing_error"));
-
+	outputSignalsConnected = true;
 	connectOutputSignals();
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -2171,99 +2376,293 @@ void OBS_service::Query(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	if (outputSignal.empty()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-		AUTO_DEBUG;
-		return;
-	}
+	std::vector<SignalInfo> signals;
+	uint64_t                firstSequence = outputSignal.drain(signals);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(firstSequence));
+	rval.push_back(ipc::value((uint32_t)signals.size()));
 
-	rval.push_back(ipc::value(outputSignal.front().getOutputType()));
-	rval.push_back(ipc::value(outputSignal.front().getSignal()));
-	rval.push_back(ipc::value(outputSignal.front().getCode()));
-	rval.push_back(ipc::value(outputSignal.front().getErrorMessage()));
-
-	outputSignal.pop();
+	for (auto& signal : signals) {
+		rval.push_back(ipc::value((uint32_t)signal.outputType));
+		rval.push_back(ipc::value((uint32_t)signal.signal));
+		rval.push_back(ipc::value(signal.code));
+		rval.push_back(ipc::value(signal.errorMessage));
+		rval.push_back(ipc::value(signal.path));
+	}
 
 	AUTO_DEBUG;
 }
 
 void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 {
-	SignalInfo& signal = *reinterpret_cast<SignalInfo*>(data);
+	const OutputSignalDesc& desc = *reinterpret_cast<const OutputSignalDesc*>(data);
 
-	std::string signalReceived = signal.getSignal();
+	SignalInfo signal(desc.outputType, desc.signal);
 
-	if (signalReceived.compare("stop") == 0) {
-		signal.setCode((int)calldata_int(params, "code"));
+	if (desc.signal == OutputSignal::Stop) {
+		signal.code = (int)calldata_int(params, "code");
 
-		obs_output_t* output;
+		// The output that stopped, the recording one may already have been replaced by a new segment
+		obs_output_t* output = reinterpret_cast<obs_output_t*>(calldata_ptr(params, "output"));
 
-		if (signal.getOutputType().compare("streaming") == 0) {
-			output = streamingOutput;
+		if (desc.outputType == OutputType::Streaming) {
+			output = output ? output : streamingOutput;
 			isStreaming = false;
-		} else if (signal.getOutputType().compare("recording") == 0) {
-			output = recordingOutput;
+		} else if (desc.outputType == OutputType::Recording) {
+			output = output ? output : recordingOutput.load();
 			isRecording = false;
 		} else {
-			output = replayBufferOutput;
+			output = output ? output : replayBufferOutput;
 			isReplayBufferActive = false;
 		}
 
 		const char* error = obs_output_get_last_error(output);
 		if (error) {
-			if (signal.getOutputType().compare("recording") == 0 && signal.getCode() == 0)
-				signal.setCode(OBS_OUTPUT_ERROR);
-			signal.setErrorMessage(error);
+			if (desc.outputType == OutputType::Recording && signal.code == 0)
+				signal.code = OBS_OUTPUT_ERROR;
+			signal.errorMessage = error;
+		}
+
+		// The last file of a segmented recording is closed by the recording itself stopping
+		if (desc.outputType == OutputType::Recording && recordingSegmented.exchange(false)) {
+			SignalInfo segment(OutputType::Recording, OutputSignal::SegmentClosed);
+			segment.code = signal.code;
+
+			obs_data_t* settings = obs_output_get_settings(output);
+			segment.path         = obs_data_get_string(settings, "path");
+			obs_data_release(settings);
+
+			outputSignal.push(std::move(segment));
 		}
 	}
 
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	outputSignal.push(signal);
+	outputSignal.push(std::move(signal));
+}
+
+static void ConnectSignals(obs_output_t* output, const OutputSignalDesc* signals, size_t count)
+{
+	signal_handler* handler = obs_output_get_signal_handler(output);
+
+	for (size_t i = 0; i < count; i++) {
+		signal_handler_connect(
+		    handler, signals[i].name, OBS_service::JSCallbackOutputSignal, const_cast<OutputSignalDesc*>(&signals[i]));
+	}
+}
+
+static void DisconnectSignals(obs_output_t* output, const OutputSignalDesc* signals, size_t count)
+{
+	signal_handler* handler = obs_output_get_signal_handler(output);
+
+	for (size_t i = 0; i < count; i++) {
+		signal_handler_disconnect(
+		    handler, signals[i].name, OBS_service::JSCallbackOutputSignal, const_cast<OutputSignalDesc*>(&signals[i]));
+	}
 }
 
 void OBS_service::connectOutputSignals(void)
 {
-	if (streamingOutput) {
-		signal_handler* streamingOutputSignalHandler = obs_output_get_signal_handler(streamingOutput);
+	// Outputs only report to the client once it asked for it.
+	if (!outputSignalsConnected)
+		return;
+
+	// Connect streaming output
+	if (streamingOutput)
+		ConnectSignals(streamingOutput, streamingSignals, sizeof(streamingSignals) / sizeof(streamingSignals[0]));
+
+	// Connect recording output
+	if (recordingOutput)
+		ConnectSignals(recordingOutput, recordingSignals, sizeof(recordingSignals) / sizeof(recordingSignals[0]));
+
+	// Connect replay buffer output
+	if (replayBufferOutput)
+		ConnectSignals(
+		    replayBufferOutput, replayBufferSignals, sizeof(replayBufferSignals) / sizeof(replayBufferSignals[0]));
+}
+
+void OBS_service::startSegmentWorker(void)
+{
+	segmentStartTime   = os_gettime_ns();
+	segmentWorkerStop  = false;
+	recordingSegmented = true;
+	segmentWorker      = std::thread(segmentWorkerLoop);
+}
+
+void OBS_service::stopSegmentWorker(void)
+{
+	{
+		std::unique_lock<std::mutex> lock(segmentMutex);
+		segmentWorkerStop = true;
+	}
+	segmentCondition.notify_all();
+
+	if (segmentWorker.joinable())
+		segmentWorker.join();
+
+	releaseRetiredSegments();
+}
+
+void OBS_service::waitSegmentFinalizer(void)
+{
+	if (segmentFinalizer.joinable())
+		segmentFinalizer.join();
+
+	releaseRetiredSegments();
+}
+
+void OBS_service::releaseRetiredSegments(void)
+{
+	// Only called with the worker stopped, by the thread that owns the recording output. Nothing else
+	// can still be using a pointer it read before the worker replaced it.
+	std::vector<obs_output_t*> segments;
+	{
+		std::unique_lock<std::mutex> lock(segmentMutex);
+		segments.swap(retiredSegments);
+	}
+
+	for (obs_output_t* segment : segments)
+		obs_output_release(segment);
+}
+
+void OBS_service::segmentWorkerLoop(void)
+{
+	std::unique_lock<std::mutex> lock(segmentMutex);
+	while (!segmentWorkerStop) {
+		segmentCondition.wait_for(lock, std::chrono::milliseconds(250));
+		if (segmentWorkerStop || !obs_output_active(recordingOutput))
+			continue;
+
+		bool rollOver = (recordingSplitTimeNs && os_gettime_ns() - segmentStartTime >= recordingSplitTimeNs)
+		                || (recordingSplitSizeBytes
+		                    && obs_output_get_total_bytes(recordingOutput) >= recordingSplitSizeBytes);
+		if (!rollOver)
+			continue;
+
+		lock.unlock();
+		bool split = splitRecording();
+		lock.lock();
 
-		// Connect streaming output
-		for (int i = 0; i < streamingSignals.size(); i++) {
-			signal_handler_connect(
-			    streamingOutputSignalHandler,
-			    streamingSignals.at(i).getSignal().c_str(),
-			    JSCallbackOutputSignal,
-			    &(streamingSignals.at(i)));
+		if (!split) {
+			if (!segmentWorkerStop)
+				blog(LOG_WARNING, "Failed to start the next recording segment, recording continues in the current file");
+			break;
 		}
 	}
+}
+
+bool OBS_service::splitRecording(void)
+{
+	obs_output_t* current = recordingOutput;
+	obs_output_t* next    = obs_output_create("ffmpeg_muxer", "simple_file_output", nullptr, nullptr);
+	if (!next)
+		return false;
 
-	if (recordingOutput) {
-		signal_handler* recordingOutputSignalHandler = obs_output_get_signal_handler(recordingOutput);
+	// Same muxer settings and encoders as the current segment, only the file name changes
+	obs_data_t* settings = obs_output_get_settings(current);
+	obs_output_update(next, settings);
+	obs_data_release(settings);
+	updateFfmpegOutput(recordingArmedSimpleMode, next);
 
-		// Connect recording output
-		for (int i = 0; i < recordingSignals.size(); i++) {
-			signal_handler_connect(
-			    recordingOutputSignalHandler,
-			    recordingSignals.at(i).getSignal().c_str(),
-			    JSCallbackOutputSignal,
-			    &(recordingSignals.at(i)));
+	obs_output_set_video_encoder(next, obs_output_get_video_encoder(current));
+	for (size_t i = 0; i < MAX_AUDIO_MIXES; i++) {
+		obs_encoder_t* audioEncoder = obs_output_get_audio_encoder(current, i);
+		if (audioEncoder)
+			obs_output_set_audio_encoder(next, audioEncoder, i);
+	}
+
+	// The next segment joins the running encoders at their next keyframe. The current one keeps
+	// writing until the next has data, so the two files overlap instead of leaving a gap. Stopping
+	// the recording cancels the wait, so stopSegmentWorker never waits for the deadline.
+	bool     started  = obs_output_start(next);
+	uint64_t deadline = os_gettime_ns() + 10000000000ULL;
+	{
+		std::unique_lock<std::mutex> lock(segmentMutex);
+		while (started && obs_output_get_total_bytes(next) == 0) {
+			if (segmentWorkerStop || !obs_output_active(next) || os_gettime_ns() > deadline)
+				started = false;
+			else
+				segmentCondition.wait_for(lock, std::chrono::milliseconds(10));
 		}
 	}
 
-	if (replayBufferOutput) {
-		signal_handler* replayBufferOutputSignalHandler = obs_output_get_signal_handler(replayBufferOutput);
+	if (!started) {
+		if (obs_output_active(next))
+			obs_output_force_stop(next);
+		obs_output_release(next);
+		return false;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(segmentMutex);
+		recordingOutput  = next;
+		segmentStartTime = os_gettime_ns();
+	}
+
+	// The client keeps seeing a single recording, its signals move over to the new segment
+	DisconnectSignals(current, recordingSignals, sizeof(recordingSignals) / sizeof(recordingSignals[0]));
+	if (outputSignalsConnected)
+		ConnectSignals(next, recordingSignals, sizeof(recordingSignals) / sizeof(recordingSignals[0]));
+
+	if (segmentFinalizer.joinable())
+		segmentFinalizer.join();
+	segmentFinalizer = std::thread(finalizeSegment, current);
+	return true;
+}
+
+struct SegmentStop
+{
+	std::mutex              mtx;
+	std::condition_variable cv;
+	bool                    stopped = false;
+	int                     code    = 0;
+};
+
+static void SegmentStopped(void* data, calldata_t* params)
+{
+	SegmentStop* stop = reinterpret_cast<SegmentStop*>(data);
 
-		// Connect replay buffer output
-		for (int i = 0; i < replayBufferSignals.size(); i++) {
-			signal_handler_connect(
-			    replayBufferOutputSignalHandler,
-			    replayBufferSignals.at(i).getSignal().c_str(),
-			    JSCallbackOutputSignal,
-			    &(replayBufferSignals.at(i)));
+	std::unique_lock<std::mutex> lock(stop->mtx);
+	stop->stopped = true;
+	stop->code    = (int)calldata_int(params, "code");
+	stop->cv.notify_all();
+}
+
+void OBS_service::finalizeSegment(obs_output_t* segment)
+{
+	SegmentStop     stop;
+	signal_handler* handler = obs_output_get_signal_handler(segment);
+	signal_handler_connect(handler, "stop", SegmentStopped, &stop);
+
+	// The muxer writes the trailer while stopping, the file is complete once "stop" fired
+	obs_output_stop(segment);
+	{
+		std::unique_lock<std::mutex> lock(stop.mtx);
+		if (!stop.cv.wait_for(lock, std::chrono::seconds(30), [&stop] { return stop.stopped; })) {
+			blog(LOG_WARNING, "Recording segment did not stop in time, forcing it");
+			lock.unlock();
+			obs_output_force_stop(segment);
+			lock.lock();
+			if (!stop.stopped)
+				stop.code = OBS_OUTPUT_ERROR;
 		}
 	}
+	signal_handler_disconnect(handler, "stop", SegmentStopped, &stop);
+
+	SignalInfo signal(OutputType::Recording, OutputSignal::SegmentClosed);
+	signal.code = stop.code;
+
+	obs_data_t* settings = obs_output_get_settings(segment);
+	signal.path          = obs_data_get_string(settings, "path");
+	obs_data_release(settings);
+
+	const char* error = obs_output_get_last_error(segment);
+	if (stop.code != 0 && error)
+		signal.errorMessage = error;
+
+	outputSignal.push(std::move(signal));
+
+	std::unique_lock<std::mutex> lock(segmentMutex);
+	retiredSegments.push_back(segment);
 }
 
 struct HotkeyInfo
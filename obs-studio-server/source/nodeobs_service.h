@@ -19,6 +19,7 @@
 #pragma once
 
 #include <algorithm>
+#include <condition_variable>
 #include <iostream>
 #include <ipc-server.hpp>
 #include <map>
@@ -27,6 +28,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 #include <util/config-file.h>
 #include <util/dstr.h>
 #include <util/platform.h>
@@ -66,48 +68,60 @@
 
 #define MAX_AUDIO_MIXES 6
 
-class SignalInfo
+// Values are shared with the client, only append to these.
+enum class OutputType : uint32_t
 {
-	private:
-	std::string m_outputType;
-	std::string m_signal;
-	int         m_code;
-	std::string m_errorMessage;
+	Streaming    = 0,
+	Recording    = 1,
+	ReplayBuffer = 2,
+};
+
+enum class OutputSignal : uint32_t
+{
+	Start            = 0,
+	Stop             = 1,
+	Starting         = 2,
+	Stopping         = 3,
+	Activate         = 4,
+	Deactivate       = 5,
+	Reconnect        = 6,
+	ReconnectSuccess = 7,
+	Writing          = 8,
+	Wrote            = 9,
+	WritingError     = 10,
+	SegmentClosed    = 11,
+};
 
+struct SignalInfo
+{
+	OutputType   outputType;
+	OutputSignal signal;
+	int          code = 0;
+	std::string  errorMessage;
+	std::string  path;
+
+	SignalInfo() {}
+	SignalInfo(OutputType type, OutputSignal sig) : outputType(type), signal(sig) {}
+};
+
+// Bounded queue of output signals. Every pushed signal gets the next sequence number,
+// when the ring is full the oldest one is dropped so readers can tell from the gap.
+class SignalRing
+{
 	public:
-	SignalInfo(){};
-	SignalInfo(std::string outputType, std::string signal)
-	{
-		m_outputType   = outputType;
-		m_signal       = signal;
-		m_code         = 0;
-		m_errorMessage = "";
-	}
-	std::string getOutputType(void)
-	{
-		return m_outputType;
-	};
-	std::string getSignal(void)
-	{
-		return m_signal;
-	};
-
-	int getCode(void)
-	{
-		return m_code;
-	};
-	void setCode(int code)
-	{
-		m_code = code;
-	};
-	std::string getErrorMessage(void)
-	{
-		return m_errorMessage;
-	};
-	void setErrorMessage(std::string errorMessage)
-	{
-		m_errorMessage = errorMessage;
-	};
+	SignalRing(size_t capacity);
+
+	void push(SignalInfo&& signal);
+
+	// Moves every pending signal into signals and returns the sequence number of the first one.
+	uint64_t drain(std::vector<SignalInfo>& signals);
+
+	private:
+	std::mutex              mtx;
+	std::vector<SignalInfo> buffer;
+	size_t                  head  = 0;
+	size_t                  count = 0;
+	uint64_t                nextSequence = 1;
 };
 
 class OBS_service
@@ -138,6 +152,11 @@ class OBS_service
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void OBS_service_armRecording(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 	static void OBS_service_startReplayBuffer(
 	    void*                          data,
 	    const int64_t                  id,
@@ -200,6 +219,13 @@ class OBS_service
 	static bool startStreaming(void);
 	static void stopStreaming(bool forceStop);
 	static bool startRecording(void);
+	static bool armRecording(void);
+	static bool isRecordingArmed(void);
+	static void startSegmentWorker(void);
+	static void segmentWorkerLoop(void);
+	static bool splitRecording(void);
+	static void finalizeSegment(obs_output_t* segment);
+	static void releaseRetiredSegments(void);
 	static bool startReplayBuffer(void);
 	static void stopReplayBuffer(bool forceStop);
 	static void stopRecording(void);
@@ -256,6 +282,8 @@ class OBS_service
 	static obs_output_t* getVirtualWebcamOutput(void);
 	static void          setVirtualWebcamOutput(obs_output_t* output);
 	static void          waitReleaseWorker(void);
+	static void          stopSegmentWorker(void);
+	static void          waitSegmentFinalizer(void);
 
 	// Update settings
 	static void updateStreamingOutput();
@@ -282,6 +310,11 @@ class OBS_service
 	static bool isRecordingOutputActive(void);
 	static bool isReplayBufferOutputActive(void);
 
+	// Pre-armed recording
+	static void   invalidateRecordingArm(void);
+	static double getRecordingStartLatency(void);
+	static bool   getRecordingStartWasArmed(void);
+
 	// Reset contexts
 	static bool resetAudioContext(bool reload = false);
 	static int  resetVideoContext(bool reload = false);
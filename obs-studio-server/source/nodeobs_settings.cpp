@@ -1414,6 +1414,7 @@ void OBS_settings::getSimpleOutputSettings(
 	    serializeSettingsData("Recording", entries, config, "SimpleOutput", true, isCategoryEnabled));
 
 	getReplayBufferSettings(outputSettings, config, false, isCategoryEnabled);
+	getSplitRecordingSettings(outputSettings, config, false, isCategoryEnabled);
 }
 
 void OBS_settings::getEncoderSettings(
@@ -2539,6 +2540,65 @@ void OBS_settings::getReplayBufferSettings(
 	entries.clear();
 }
 
+void OBS_settings::getSplitRecordingSettings(
+    std::vector<SubCategory>* outputSettings,
+    config_t*                 config,
+    bool                      advanced,
+    bool                      isCategoryEnabled)
+{
+	std::vector<std::vector<std::pair<std::string, ipc::value>>> entries;
+
+	std::vector<std::pair<std::string, ipc::value>> recSplitFile;
+	recSplitFile.push_back(std::make_pair("name", ipc::value("RecSplitFile")));
+	recSplitFile.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_BOOL")));
+	recSplitFile.push_back(std::make_pair("description", ipc::value("Automatic File Splitting")));
+	recSplitFile.push_back(std::make_pair("subType", ipc::value("")));
+	recSplitFile.push_back(std::make_pair("minVal", ipc::value((double)0)));
+	recSplitFile.push_back(std::make_pair("maxVal", ipc::value((double)0)));
+	recSplitFile.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+	entries.push_back(recSplitFile);
+
+	bool currentRecSplitFile = config_get_bool(config, advanced ? "AdvOut" : "SimpleOutput", "RecSplitFile");
+
+	if (currentRecSplitFile) {
+		std::vector<std::pair<std::string, ipc::value>> recSplitFileType;
+		recSplitFileType.push_back(std::make_pair("name", ipc::value("RecSplitFileType")));
+		recSplitFileType.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_LIST")));
+		recSplitFileType.push_back(std::make_pair("description", ipc::value("Split By")));
+		recSplitFileType.push_back(std::make_pair("subType", ipc::value("OBS_COMBO_FORMAT_STRING")));
+		recSplitFileType.push_back(std::make_pair("minVal", ipc::value((double)0)));
+		recSplitFileType.push_back(std::make_pair("maxVal", ipc::value((double)0)));
+		recSplitFileType.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+		recSplitFileType.push_back(std::make_pair("Split by Time", ipc::value("Time")));
+		recSplitFileType.push_back(std::make_pair("Split by Size", ipc::value("Size")));
+		entries.push_back(recSplitFileType);
+
+		std::vector<std::pair<std::string, ipc::value>> recSplitFileTime;
+		recSplitFileTime.push_back(std::make_pair("name", ipc::value("RecSplitFileTime")));
+		recSplitFileTime.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+		recSplitFileTime.push_back(std::make_pair("description", ipc::value("Split Time (Minutes)")));
+		recSplitFileTime.push_back(std::make_pair("subType", ipc::value("")));
+		recSplitFileTime.push_back(std::make_pair("minVal", ipc::value((double)1)));
+		recSplitFileTime.push_back(std::make_pair("maxVal", ipc::value((double)525600)));
+		recSplitFileTime.push_back(std::make_pair("stepVal", ipc::value((double)1)));
+		entries.push_back(recSplitFileTime);
+
+		std::vector<std::pair<std::string, ipc::value>> recSplitFileSize;
+		recSplitFileSize.push_back(std::make_pair("name", ipc::value("RecSplitFileSize")));
+		recSplitFileSize.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+		recSplitFileSize.push_back(std::make_pair("description", ipc::value("Split Size (MB)")));
+		recSplitFileSize.push_back(std::make_pair("subType", ipc::value("")));
+		recSplitFileSize.push_back(std::make_pair("minVal", ipc::value((double)20)));
+		recSplitFileSize.push_back(std::make_pair("maxVal", ipc::value((double)1073741824)));
+		recSplitFileSize.push_back(std::make_pair("stepVal", ipc::value((double)1)));
+		entries.push_back(recSplitFileSize);
+	}
+
+	outputSettings->push_back(serializeSettingsData(
+	    "Split Recording", entries, config, advanced ? "AdvOut" : "SimpleOutput", true, isCategoryEnabled));
+	entries.clear();
+}
+
 void OBS_settings::getAdvancedOutputSettings(
     std::vector<SubCategory>* outputSettings,
     config_t*                 config,
@@ -2557,6 +2617,9 @@ void OBS_settings::getAdvancedOutputSettings(
 
 	// Replay buffer
 	getReplayBufferSettings(outputSettings, config, true, isCategoryEnabled);
+
+	// Split recording
+	getSplitRecordingSettings(outputSettings, config, true, isCategoryEnabled);
 }
 
 std::vector<SubCategory> OBS_settings::getOutputSettings(CategoryTypes& type)
@@ -2894,6 +2957,13 @@ void OBS_settings::saveAdvancedOutputSettings(std::vector<SubCategory> settings)
 	std::vector<SubCategory> replaySettings;
 	replaySettings.push_back(settings.at(9));
 	saveGenericSettings(replaySettings, "AdvOut", ConfigManager::getInstance().getBasic());
+
+	// Split recording
+	if (settings.size() > 10) {
+		std::vector<SubCategory> splitSettings;
+		splitSettings.push_back(settings.at(10));
+		saveGenericSettings(splitSettings, "AdvOut", ConfigManager::getInstance().getBasic());
+	}
 }
 
 void OBS_settings::saveOutputSettings(std::vector<SubCategory> settings)
@@ -3890,6 +3960,11 @@ bool OBS_settings::saveSettings(std::string nameCategory, std::vector<SubCategor
 
 		OBS_API::setAudioDeviceMonitoring();
 	}
+
+	// Anything but the general settings can change what the recording output is built from
+	if (nameCategory.compare("General") != 0)
+		OBS_service::invalidateRecordingArm();
+
 	return ret;
 }
 
@@ -241,6 +241,12 @@ class OBS_settings
 	    bool                      advanced,
 	    bool                      isCategoryEnabled);
 
+	static void getSplitRecordingSettings(
+	    std::vector<SubCategory>* outputSettings,
+	    config_t*                 config,
+	    bool                      advanced,
+	    bool                      isCategoryEnabled);
+
 	/****** Save Output Settings ******/
 
 	// Simple Output mode
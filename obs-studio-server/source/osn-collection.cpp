@@ -0,0 +1,699 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-collection.hpp"
+#include <error.hpp>
+#include <functional>
+#include <ipc-registry.hpp>
+#include <memory>
+#include <obs.h>
+#include <set>
+#include <util/platform.h>
+#include "osn-source.hpp"
+#include "shared.hpp"
+#include "util-snapshot.h"
+
+/* Snapshot layout, all values little-endian:
+ *   u32 magic, u32 version, u32 flags (0)
+ *   records: u8 type, u32 payload size, payload
+ *   an End record
+ * Records are ordered so that loading is a single pass: inputs and
+ * transitions, then empty scenes, then the items of every scene, so every
+ * source an item or output channel names exists by the time it is read. */
+static constexpr uint32_t SnapshotMagic   = 0x434e534f; // "OSNC"
+static constexpr uint32_t SnapshotVersion = 1;
+
+enum RecordType : uint8_t
+{
+	RecordEnd        = 0,
+	RecordInput      = 1,
+	RecordScene      = 2,
+	RecordSceneItems = 3,
+	RecordTransition = 4,
+	RecordOutput     = 5,
+};
+
+struct DataRelease
+{
+	void operator()(obs_data_t* data) const
+	{
+		obs_data_release(data);
+	}
+};
+using DataPtr = std::unique_ptr<obs_data_t, DataRelease>;
+
+struct FilterRecord
+{
+	std::string id;
+	std::string name;
+	bool        enabled;
+	DataPtr     settings;
+};
+
+// Inputs, scenes and transitions share one payload layout.
+struct SourceRecord
+{
+	std::string               id;
+	std::string               name;
+	DataPtr                   settings;
+	uint32_t                  flags;
+	float                     volume;
+	float                     balance;
+	bool                      muted;
+	int64_t                   syncOffset;
+	uint32_t                  mixers;
+	int32_t                   monitoringType;
+	bool                      enabled;
+	int32_t                   deinterlaceMode;
+	int32_t                   deinterlaceFieldOrder;
+	std::vector<FilterRecord> filters;
+};
+
+struct ItemRecord
+{
+	std::string source;
+	bool        visible;
+	bool        streamVisible;
+	bool        recordingVisible;
+	bool        locked;
+	vec2        position;
+	float       rotation;
+	vec2        scale;
+	uint32_t    alignment;
+	int32_t     boundsType;
+	uint32_t    boundsAlignment;
+	vec2        bounds;
+	int32_t     crop[4];
+	int32_t     scaleFilter;
+};
+
+struct SnapshotVisitor
+{
+	using SourceFn = std::function<void(uint8_t type, SourceRecord& record)>;
+	using ItemsFn  = std::function<void(const std::string& scene, std::vector<ItemRecord>& items)>;
+	using OutputFn = std::function<void(uint32_t channel, const std::string& source, const std::string& active)>;
+
+	SourceFn source;
+	ItemsFn  items;
+	OutputFn output;
+};
+
+static void WriteSource(util::SnapshotWriter& writer, obs_source_t* source, bool isScene)
+{
+	writer.WriteString(obs_source_get_id(source));
+	writer.WriteString(obs_source_get_name(source));
+
+	// A saved scene keeps its items in its settings, they get their own record.
+	if (isScene) {
+		writer.WriteData(nullptr);
+	} else {
+		obs_source_save(source);
+		obs_data_t* settings = obs_source_get_settings(source);
+		writer.WriteData(settings);
+		obs_data_release(settings);
+	}
+
+	writer.WriteU32(obs_source_get_flags(source));
+	writer.WriteF32(obs_source_get_volume(source));
+	writer.WriteF32(obs_source_get_balance_value(source));
+	writer.WriteU8(obs_source_muted(source) ? 1 : 0);
+	writer.WriteI64(obs_source_get_sync_offset(source));
+	writer.WriteU32(obs_source_get_audio_mixers(source));
+	writer.WriteI32(obs_source_get_monitoring_type(source));
+	writer.WriteU8(obs_source_enabled(source) ? 1 : 0);
+	writer.WriteI32(obs_source_get_deinterlace_mode(source));
+	writer.WriteI32(obs_source_get_deinterlace_field_order(source));
+
+	std::vector<obs_source_t*> filters;
+	obs_source_enum_filters(
+	    source,
+	    [](obs_source_t*, obs_source_t* filter, void* data) {
+		    static_cast<std::vector<obs_source_t*>*>(data)->push_back(filter);
+		    obs_source_addref(filter);
+	    },
+	    &filters);
+
+	writer.WriteU32(uint32_t(filters.size()));
+	for (obs_source_t* filter : filters) {
+		obs_source_save(filter);
+		obs_data_t* settings = obs_source_get_settings(filter);
+		writer.WriteString(obs_source_get_id(filter));
+		writer.WriteString(obs_source_get_name(filter));
+		writer.WriteU8(obs_source_enabled(filter) ? 1 : 0);
+		writer.WriteData(settings);
+		obs_data_release(settings);
+		obs_source_release(filter);
+	}
+}
+
+static void WriteItems(util::SnapshotWriter& writer, obs_source_t* source)
+{
+	std::vector<obs_sceneitem_t*> items;
+	obs_scene_enum_items(
+	    obs_scene_from_source(source),
+	    [](obs_scene_t*, obs_sceneitem_t* item, void* data) {
+		    obs_sceneitem_addref(item);
+		    static_cast<std::vector<obs_sceneitem_t*>*>(data)->push_back(item);
+		    return true;
+	    },
+	    &items);
+
+	// Bottom to top, adding them back in this order restores the stacking.
+	writer.WriteString(obs_source_get_name(source));
+	writer.WriteU32(uint32_t(items.size()));
+	for (obs_sceneitem_t* item : items) {
+		vec2 position, scale, bounds;
+		obs_sceneitem_get_pos(item, &position);
+		obs_sceneitem_get_scale(item, &scale);
+		obs_sceneitem_get_bounds(item, &bounds);
+		obs_sceneitem_crop crop;
+		obs_sceneitem_get_crop(item, &crop);
+
+		writer.WriteString(obs_source_get_name(obs_sceneitem_get_source(item)));
+		writer.WriteU8(obs_sceneitem_visible(item) ? 1 : 0);
+		writer.WriteU8(obs_sceneitem_stream_visible(item) ? 1 : 0);
+		writer.WriteU8(obs_sceneitem_recording_visible(item) ? 1 : 0);
+		writer.WriteU8(obs_sceneitem_locked(item) ? 1 : 0);
+		writer.WriteF32(position.x);
+		writer.WriteF32(position.y);
+		writer.WriteF32(obs_sceneitem_get_rot(item));
+		writer.WriteF32(scale.x);
+		writer.WriteF32(scale.y);
+		writer.WriteU32(obs_sceneitem_get_alignment(item));
+		writer.WriteI32(obs_sceneitem_get_bounds_type(item));
+		writer.WriteU32(obs_sceneitem_get_bounds_alignment(item));
+		writer.WriteF32(bounds.x);
+		writer.WriteF32(bounds.y);
+		writer.WriteI32(crop.left);
+		writer.WriteI32(crop.top);
+		writer.WriteI32(crop.right);
+		writer.WriteI32(crop.bottom);
+		writer.WriteI32(obs_sceneitem_get_scale_filter(item));
+		obs_sceneitem_release(item);
+	}
+}
+
+static bool ReadSource(util::SnapshotReader& reader, SourceRecord& record)
+{
+	record.id                    = reader.ReadString();
+	record.name                  = reader.ReadString();
+	record.settings              = DataPtr(reader.ReadData());
+	record.flags                 = reader.ReadU32();
+	record.volume                = reader.ReadF32();
+	record.balance               = reader.ReadF32();
+	record.muted                 = reader.ReadU8() != 0;
+	record.syncOffset            = reader.ReadI64();
+	record.mixers                = reader.ReadU32();
+	record.monitoringType        = reader.ReadI32();
+	record.enabled               = reader.ReadU8() != 0;
+	record.deinterlaceMode       = reader.ReadI32();
+	record.deinterlaceFieldOrder = reader.ReadI32();
+
+	uint32_t count = reader.ReadU32();
+	for (uint32_t idx = 0; reader.Ok() && idx < count; idx++) {
+		FilterRecord filter;
+		filter.id       = reader.ReadString();
+		filter.name     = reader.ReadString();
+		filter.enabled  = reader.ReadU8() != 0;
+		filter.settings = DataPtr(reader.ReadData());
+		record.filters.push_back(std::move(filter));
+	}
+	return reader.Ok();
+}
+
+static bool ReadItem(util::SnapshotReader& reader, ItemRecord& item)
+{
+	item.source           = reader.ReadString();
+	item.visible          = reader.ReadU8() != 0;
+	item.streamVisible    = reader.ReadU8() != 0;
+	item.recordingVisible = reader.ReadU8() != 0;
+	item.locked           = reader.ReadU8() != 0;
+	item.position.x       = reader.ReadF32();
+	item.position.y       = reader.ReadF32();
+	item.rotation         = reader.ReadF32();
+	item.scale.x          = reader.ReadF32();
+	item.scale.y          = reader.ReadF32();
+	item.alignment        = reader.ReadU32();
+	item.boundsType       = reader.ReadI32();
+	item.boundsAlignment  = reader.ReadU32();
+	item.bounds.x         = reader.ReadF32();
+	item.bounds.y         = reader.ReadF32();
+	for (int32_t& side : item.crop)
+		side = reader.ReadI32();
+	item.scaleFilter = reader.ReadI32();
+	return reader.Ok();
+}
+
+// Reads the snapshot straight from the mapped file and hands each record to
+// the visitor as soon as it is decoded.
+static bool ReadSnapshot(const std::string& path, const SnapshotVisitor& visitor, std::string& error)
+{
+	util::MappedFile file;
+	if (!file.Open(path)) {
+		error = "Failed to open the collection snapshot.";
+		return false;
+	}
+
+	util::SnapshotReader reader(file.Data(), file.Size());
+	uint32_t             magic   = reader.ReadU32();
+	uint32_t             version = reader.ReadU32();
+	reader.ReadU32();
+	if (!reader.Ok() || magic != SnapshotMagic) {
+		error = "File is not a collection snapshot.";
+		return false;
+	}
+	if (version > SnapshotVersion) {
+		error = "Collection snapshot was written by a newer version.";
+		return false;
+	}
+
+	uint8_t              type = RecordEnd;
+	util::SnapshotReader payload(nullptr, 0);
+	while (reader.NextRecord(type, payload) && type != RecordEnd) {
+		switch (type) {
+		case RecordInput:
+		case RecordScene:
+		case RecordTransition: {
+			SourceRecord record;
+			if (ReadSource(payload, record))
+				visitor.source(type, record);
+			break;
+		}
+		case RecordSceneItems: {
+			std::string             scene = payload.ReadString();
+			uint32_t                count = payload.ReadU32();
+			std::vector<ItemRecord> items;
+			for (uint32_t idx = 0; payload.Ok() && idx < count; idx++) {
+				ItemRecord item;
+				if (ReadItem(payload, item))
+					items.push_back(std::move(item));
+			}
+			if (payload.Ok())
+				visitor.items(scene, items);
+			break;
+		}
+		case RecordOutput: {
+			uint32_t    channel = payload.ReadU32();
+			std::string source  = payload.ReadString();
+			std::string active  = payload.ReadString();
+			if (payload.Ok())
+				visitor.output(channel, source, active);
+			break;
+		}
+		default:
+			// Written by a newer version, skipped as a whole.
+			continue;
+		}
+
+		if (!payload.Ok()) {
+			error = "Collection snapshot is corrupt.";
+			return false;
+		}
+	}
+
+	if (!reader.Ok() || type != RecordEnd) {
+		error = "Collection snapshot is truncated.";
+		return false;
+	}
+	return true;
+}
+
+static nlohmann::json DataToJSON(obs_data_t* data)
+{
+	const char*    json  = data ? obs_data_get_json(data) : nullptr;
+	nlohmann::json value = nlohmann::json::parse(json ? json : "{}", nullptr, false);
+	return value.is_discarded() ? nlohmann::json::object() : value;
+}
+
+static obs_source_t* CreateSource(uint8_t type, const SourceRecord& record)
+{
+	obs_source_t* source = nullptr;
+	if (type == RecordScene) {
+		obs_scene_t* scene = obs_scene_create(record.name.c_str());
+		source             = scene ? obs_scene_get_source(scene) : nullptr;
+	} else {
+		source = obs_source_create(record.id.c_str(), record.name.c_str(), record.settings.get(), nullptr);
+	}
+	if (!source)
+		return nullptr;
+
+	obs_source_set_flags(source, record.flags);
+	obs_source_set_volume(source, record.volume);
+	obs_source_set_balance_value(source, record.balance);
+	obs_source_set_muted(source, record.muted);
+	obs_source_set_sync_offset(source, record.syncOffset);
+	obs_source_set_audio_mixers(source, record.mixers);
+	obs_source_set_monitoring_type(source, obs_monitoring_type(record.monitoringType));
+	obs_source_set_enabled(source, record.enabled);
+	obs_source_set_deinterlace_mode(source, obs_deinterlace_mode(record.deinterlaceMode));
+	obs_source_set_deinterlace_field_order(source, obs_deinterlace_field_order(record.deinterlaceFieldOrder));
+
+	for (const FilterRecord& entry : record.filters) {
+		obs_source_t* filter = obs_source_create_private(entry.id.c_str(), entry.name.c_str(), entry.settings.get());
+		if (!filter) {
+			blog(LOG_WARNING, "Collection snapshot: failed to create filter '%s'.", entry.name.c_str());
+			continue;
+		}
+
+		// Registered like filters created through Filter.Create, which keeps the
+		// creation reference for the client.
+		if (osn::Source::Manager::GetInstance().allocate(filter) == UINT64_MAX) {
+			blog(LOG_WARNING, "Collection snapshot: index list is full, dropping filter '%s'.", entry.name.c_str());
+			obs_source_release(filter);
+			continue;
+		}
+		osn::Source::attach_source_signals(filter);
+
+		obs_source_set_enabled(filter, entry.enabled);
+		obs_source_filter_add(source, filter);
+	}
+
+	if (type != RecordScene)
+		obs_source_load(source);
+	return source;
+}
+
+static void AddItems(const std::string& sceneName, const std::vector<ItemRecord>& items)
+{
+	obs_source_t* source = obs_get_source_by_name(sceneName.c_str());
+	obs_scene_t*  scene  = source ? obs_scene_from_source(source) : nullptr;
+	if (!scene) {
+		blog(LOG_WARNING, "Collection snapshot: scene '%s' does not exist.", sceneName.c_str());
+		obs_source_release(source);
+		return;
+	}
+
+	for (const ItemRecord& record : items) {
+		obs_source_t*    added = obs_get_source_by_name(record.source.c_str());
+		obs_sceneitem_t* item  = added ? obs_scene_add(scene, added) : nullptr;
+		obs_source_release(added);
+		if (!item) {
+			blog(LOG_WARNING, "Collection snapshot: failed to add '%s' to scene '%s'.", record.source.c_str(),
+			     sceneName.c_str());
+			continue;
+		}
+
+		obs_sceneitem_crop crop;
+		crop.left   = record.crop[0];
+		crop.top    = record.crop[1];
+		crop.right  = record.crop[2];
+		crop.bottom = record.crop[3];
+
+		obs_sceneitem_defer_update_begin(item);
+		obs_sceneitem_set_pos(item, &record.position);
+		obs_sceneitem_set_rot(item, record.rotation);
+		obs_sceneitem_set_scale(item, &record.scale);
+		obs_sceneitem_set_alignment(item, record.alignment);
+		obs_sceneitem_set_bounds_type(item, obs_bounds_type(record.boundsType));
+		obs_sceneitem_set_bounds_alignment(item, record.boundsAlignment);
+		obs_sceneitem_set_bounds(item, &record.bounds);
+		obs_sceneitem_set_crop(item, &crop);
+		obs_sceneitem_set_scale_filter(item, obs_scale_type(record.scaleFilter));
+		obs_sceneitem_set_visible(item, record.visible);
+		obs_sceneitem_set_stream_visible(item, record.streamVisible);
+		obs_sceneitem_set_recording_visible(item, record.recordingVisible);
+		obs_sceneitem_set_locked(item, record.locked);
+		obs_sceneitem_defer_update_end(item);
+	}
+
+	obs_source_release(source);
+}
+
+void osn::Collection::Register(ipc::server& srv)
+{
+	namespace reg = ipc_registry::Collection;
+
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>(reg::Name);
+	cls->register_function(ipc_registry::make_function(reg::Save, Save));
+	cls->register_function(ipc_registry::make_function(reg::Load, Load));
+	cls->register_function(ipc_registry::make_function(reg::ExportJSON, ExportJSON));
+	srv.register_collection(cls);
+}
+
+void osn::Collection::Save(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	uint64_t start = os_gettime_ns();
+
+	std::vector<obs_source_t*> inputs, scenes, transitions;
+	osn::Source::Manager::GetInstance().for_each([&](obs_source_t* source) {
+		if (!source || obs_obj_is_private(source))
+			return;
+
+		// Groups have no creation path through the API yet.
+		if (obs_source_is_group(source)) {
+			blog(LOG_WARNING, "Collection snapshot: skipping group '%s'.", obs_source_get_name(source));
+			return;
+		}
+
+		switch (obs_source_get_type(source)) {
+		case OBS_SOURCE_TYPE_INPUT:
+			inputs.push_back(source);
+			break;
+		case OBS_SOURCE_TYPE_SCENE:
+			scenes.push_back(source);
+			break;
+		case OBS_SOURCE_TYPE_TRANSITION:
+			transitions.push_back(source);
+			break;
+		default:
+			return;
+		}
+		obs_source_addref(source);
+	});
+
+	util::SnapshotWriter writer;
+	writer.WriteU32(SnapshotMagic);
+	writer.WriteU32(SnapshotVersion);
+	writer.WriteU32(0);
+
+	auto writeSources = [&writer](std::vector<obs_source_t*>& sources, RecordType type) {
+		for (obs_source_t* source : sources) {
+			size_t record = writer.BeginRecord(type);
+			WriteSource(writer, source, type == RecordScene);
+			writer.EndRecord(record);
+		}
+	};
+	writeSources(inputs, RecordInput);
+	writeSources(transitions, RecordTransition);
+	writeSources(scenes, RecordScene);
+
+	for (obs_source_t* scene : scenes) {
+		size_t record = writer.BeginRecord(RecordSceneItems);
+		WriteItems(writer, scene);
+		writer.EndRecord(record);
+	}
+
+	for (uint32_t channel = 0; channel < MAX_CHANNELS; channel++) {
+		obs_source_t* source = obs_get_output_source(channel);
+		if (!source)
+			continue;
+
+		obs_source_t* active = nullptr;
+		if (obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION)
+			active = obs_transition_get_active_source(source);
+
+		size_t record = writer.BeginRecord(RecordOutput);
+		writer.WriteU32(channel);
+		writer.WriteString(obs_source_get_name(source));
+		writer.WriteString(active ? obs_source_get_name(active) : "");
+		writer.EndRecord(record);
+
+		obs_source_release(active);
+		obs_source_release(source);
+	}
+	writer.EndRecord(writer.BeginRecord(RecordEnd));
+
+	size_t count = inputs.size() + scenes.size() + transitions.size();
+	for (auto* list : {&inputs, &scenes, &transitions}) {
+		for (obs_source_t* source : *list)
+			obs_source_release(source);
+	}
+
+	if (!writer.WriteFile(args[0].value_str)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to write the collection snapshot.");
+	}
+
+	blog(
+	    LOG_INFO,
+	    "Saved collection snapshot with %zu sources (%zu bytes) in %.1f ms.",
+	    count,
+	    writer.GetBuffer().size(),
+	    double(os_gettime_ns() - start) / 1000000.0);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Collection::Load(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	uint64_t start     = os_gettime_ns();
+	uint32_t counts[3] = {0, 0, 0}; // inputs, scenes, transitions
+
+	// Scenes that already existed keep their own items, the snapshot's are not
+	// added on top of them.
+	std::set<std::string> skipped;
+
+	SnapshotVisitor visitor;
+	visitor.source = [&counts, &skipped](uint8_t type, SourceRecord& record) {
+		obs_source_t* existing = obs_get_source_by_name(record.name.c_str());
+		if (existing) {
+			blog(LOG_WARNING, "Collection snapshot: '%s' already exists, keeping it.", record.name.c_str());
+			obs_source_release(existing);
+			if (type == RecordScene)
+				skipped.insert(record.name);
+			return;
+		}
+
+		// The creation reference is kept for the client, as with Input.Create.
+		if (!CreateSource(type, record)) {
+			blog(LOG_WARNING, "Collection snapshot: failed to create '%s'.", record.name.c_str());
+			return;
+		}
+		counts[type == RecordInput ? 0 : type == RecordScene ? 1 : 2]++;
+	};
+	visitor.items = [&skipped](const std::string& scene, std::vector<ItemRecord>& items) {
+		if (skipped.count(scene))
+			return;
+		AddItems(scene, items);
+	};
+	visitor.output = [](uint32_t channel, const std::string& name, const std::string& activeName) {
+		obs_source_t* source = obs_get_source_by_name(name.c_str());
+		if (!source || channel >= MAX_CHANNELS) {
+			obs_source_release(source);
+			return;
+		}
+
+		if (!activeName.empty() && obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION) {
+			obs_source_t* active = obs_get_source_by_name(activeName.c_str());
+			if (active)
+				obs_transition_set(source, active);
+			obs_source_release(active);
+		}
+		obs_set_output_source(channel, source);
+		obs_source_release(source);
+	};
+
+	std::string error;
+	if (!ReadSnapshot(args[0].value_str, visitor, error)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, error);
+	}
+
+	blog(
+	    LOG_INFO,
+	    "Loaded collection snapshot with %u sources in %.1f ms.",
+	    counts[0] + counts[1] + counts[2],
+	    double(os_gettime_ns() - start) / 1000000.0);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(counts[0]));
+	rval.push_back(ipc::value(counts[1]));
+	rval.push_back(ipc::value(counts[2]));
+	AUTO_DEBUG;
+}
+
+void osn::Collection::ExportJSON(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	nlohmann::json snapshot;
+	snapshot["version"]     = SnapshotVersion;
+	snapshot["inputs"]      = nlohmann::json::array();
+	snapshot["scenes"]      = nlohmann::json::array();
+	snapshot["transitions"] = nlohmann::json::array();
+	snapshot["outputs"]     = nlohmann::json::array();
+
+	SnapshotVisitor visitor;
+	visitor.source = [&snapshot](uint8_t type, SourceRecord& record) {
+		nlohmann::json source;
+		source["id"]                    = record.id;
+		source["name"]                  = record.name;
+		source["settings"]              = DataToJSON(record.settings.get());
+		source["flags"]                 = record.flags;
+		source["volume"]                = record.volume;
+		source["balance"]               = record.balance;
+		source["muted"]                 = record.muted;
+		source["syncOffset"]            = record.syncOffset;
+		source["mixers"]                = record.mixers;
+		source["monitoringType"]        = record.monitoringType;
+		source["enabled"]               = record.enabled;
+		source["deinterlaceMode"]       = record.deinterlaceMode;
+		source["deinterlaceFieldOrder"] = record.deinterlaceFieldOrder;
+		source["filters"]               = nlohmann::json::array();
+		for (const FilterRecord& filter : record.filters) {
+			source["filters"].push_back(
+			    {{"id", filter.id},
+			     {"name", filter.name},
+			     {"enabled", filter.enabled},
+			     {"settings", DataToJSON(filter.settings.get())}});
+		}
+
+		if (type == RecordScene) {
+			source["items"] = nlohmann::json::array();
+			snapshot["scenes"].push_back(source);
+		} else {
+			snapshot[type == RecordInput ? "inputs" : "transitions"].push_back(source);
+		}
+	};
+	visitor.items = [&snapshot](const std::string& scene, std::vector<ItemRecord>& items) {
+		for (nlohmann::json& entry : snapshot["scenes"]) {
+			if (entry["name"] != scene)
+				continue;
+
+			for (const ItemRecord& item : items) {
+				entry["items"].push_back(
+				    {{"source", item.source},
+				     {"visible", item.visible},
+				     {"streamVisible", item.streamVisible},
+				     {"recordingVisible", item.recordingVisible},
+				     {"locked", item.locked},
+				     {"position", {item.position.x, item.position.y}},
+				     {"rotation", item.rotation},
+				     {"scale", {item.scale.x, item.scale.y}},
+				     {"alignment", item.alignment},
+				     {"boundsType", item.boundsType},
+				     {"boundsAlignment", item.boundsAlignment},
+				     {"bounds", {item.bounds.x, item.bounds.y}},
+				     {"crop", {item.crop[0], item.crop[1], item.crop[2], item.crop[3]}},
+				     {"scaleFilter", item.scaleFilter}});
+			}
+			break;
+		}
+	};
+	visitor.output = [&snapshot](uint32_t channel, const std::string& source, const std::string& active) {
+		snapshot["outputs"].push_back({{"channel", channel}, {"source", source}, {"active", active}});
+	};
+
+	std::string error;
+	if (!ReadSnapshot(args[0].value_str, visitor, error)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, error);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(snapshot.dump(4)));
+	AUTO_DEBUG;
+}
@@ -18,28 +18,26 @@
 
 #include "osn-global.hpp"
 #include <error.hpp>
+#include <ipc-registry.hpp>
 #include <obs.h>
 #include "osn-source.hpp"
 #include "shared.hpp"
 
 void osn::Global::Register(ipc::server& srv)
 {
-	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Global");
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetOutputSource", std::vector<ipc::type>{ipc::type::UInt32}, GetOutputSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetOutputSource", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt64}, SetOutputSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetOutputFlagsFromId", std::vector<ipc::type>{ipc::type::String}, GetOutputFlagsFromId));
-	cls->register_function(std::make_shared<ipc::function>("LaggedFrames", std::vector<ipc::type>{}, LaggedFrames));
-	cls->register_function(std::make_shared<ipc::function>("TotalFrames", std::vector<ipc::type>{}, TotalFrames));
-	cls->register_function(std::make_shared<ipc::function>("GetLocale", std::vector<ipc::type>{}, GetLocale));
-	cls->register_function(
-	    std::make_shared<ipc::function>("SetLocale", std::vector<ipc::type>{ipc::type::String}, SetLocale));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetMultipleRendering", std::vector<ipc::type>{}, GetMultipleRendering));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetMultipleRendering", std::vector<ipc::type>{ipc::type::Int32}, SetMultipleRendering));
+	namespace reg = ipc_registry::Global;
+
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>(reg::Name);
+	cls->register_function(ipc_registry::make_function(reg::GetOutputSource, GetOutputSource));
+	cls->register_function(ipc_registry::make_function(reg::SetOutputSource, SetOutputSource));
+	cls->register_function(ipc_registry::make_function(reg::GetOutputFlagsFromId, GetOutputFlagsFromId));
+	cls->register_function(ipc_registry::make_function(reg::GetTypeCatalog, GetTypeCatalog));
+	cls->register_function(ipc_registry::make_function(reg::LaggedFrames, LaggedFrames));
+	cls->register_function(ipc_registry::make_function(reg::TotalFrames, TotalFrames));
+	cls->register_function(ipc_registry::make_function(reg::GetLocale, GetLocale));
+	cls->register_function(ipc_registry::make_function(reg::SetLocale, SetLocale));
+	cls->register_function(ipc_registry::make_function(reg::GetMultipleRendering, GetMultipleRendering));
+	cls->register_function(ipc_registry::make_function(reg::SetMultipleRendering, SetMultipleRendering));
 	srv.register_collection(cls);
 }
 
@@ -115,6 +113,41 @@ void osn::Global::GetOutputFlagsFromId(
 	AUTO_DEBUG;
 }
 
+static void PushTypeInfo(std::vector<ipc::value>& rval, obs_source_type type, const char* typeId)
+{
+	const char* displayName  = obs_source_get_display_name(typeId);
+	uint32_t    capabilities = 0;
+
+	if (obs_is_source_configurable(typeId))
+		capabilities |= osn::Global::TYPE_CONFIGURABLE;
+
+	rval.push_back(ipc::value((uint32_t)type));
+	rval.push_back(ipc::value(typeId));
+	rval.push_back(ipc::value(displayName ? displayName : ""));
+	rval.push_back(ipc::value(obs_get_source_output_flags(typeId)));
+	rval.push_back(ipc::value(capabilities));
+}
+
+void osn::Global::GetTypeCatalog(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+
+	// Same order as Input.Types, Filter.Types and Transition.Types.
+	const char* typeId = nullptr;
+	for (size_t idx = 0; obs_enum_input_types(idx, &typeId); idx++)
+		PushTypeInfo(rval, OBS_SOURCE_TYPE_INPUT, typeId ? typeId : "");
+	for (size_t idx = 0; obs_enum_filter_types(idx, &typeId); idx++)
+		PushTypeInfo(rval, OBS_SOURCE_TYPE_FILTER, typeId ? typeId : "");
+	for (size_t idx = 0; obs_enum_transition_types(idx, &typeId); idx++)
+		PushTypeInfo(rval, OBS_SOURCE_TYPE_TRANSITION, typeId ? typeId : "");
+
+	AUTO_DEBUG;
+}
+
 void osn::Global::LaggedFrames(
     void*                          data,
     const int64_t                  id,
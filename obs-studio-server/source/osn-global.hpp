@@ -24,6 +24,11 @@ namespace osn
 	class Global
 	{
 		public:
+		enum TypeCapabilities : uint32_t
+		{
+			TYPE_CONFIGURABLE = 1 << 0,
+		};
+
 		static void Register(ipc::server&);
 
 		static void GetOutputSource(
@@ -41,6 +46,11 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+		static void GetTypeCatalog(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 		static void LaggedFrames(
 		    void*                          data,
 		    const int64_t                  id,
@@ -22,9 +22,15 @@
 #include <memory>
 #include <obs.h>
 #include "error.hpp"
+#include "ipc-registry.hpp"
 #include "osn-source.hpp"
+#include "settings-store.hpp"
 #include "shared.hpp"
 
+// Settings blobs received through CreateInterned, so later creates can refer
+// to them by hash instead of sending them again.
+static settings_store::Lru<settings_store::blob_t> settingsBlobs;
+
 void osn::Input::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Input");
@@ -37,6 +43,7 @@ void osn::Input::Register(ipc::server& srv)
 	    "Create",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String, ipc::type::String},
 	    Create));
+	cls->register_function(ipc_registry::make_function(ipc_registry::Input::CreateInterned, CreateInterned));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
 	cls->register_function(std::make_shared<ipc::function>(
@@ -173,6 +180,59 @@ void osn::Input::Create(
 	AUTO_DEBUG;
 }
 
+void osn::Input::CreateInterned(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	const std::string& sourceId   = args[0].value_str;
+	const std::string& name       = args[1].value_str;
+	uint64_t           settingsId   = args[2].value_union.ui64;
+	uint64_t           settingsSize = args[3].value_union.ui64;
+	uint64_t           knownId      = args[5].value_union.ui64;
+
+	// A reference is resolved by hash and length only. Blobs of different
+	// lengths that share a hash fall back to a full resend. A same-length
+	// collision of the 64-bit hash within the last 256 blobs is accepted,
+	// its odds are below 2^-48.
+	settings_store::blob_t blob;
+	if (args[4].value_str.size() != 0) {
+		blob = std::make_shared<const std::string>(args[4].value_str);
+		settingsBlobs.insert(settings_store::hash(*blob), blob);
+	} else if (settingsId != 0 && (!settingsBlobs.find(settingsId, blob) || blob->size() != settingsSize)) {
+		// The client resends the full blob on this error.
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Settings blob is not held by the server.");
+	}
+
+	obs_data_t* settings = blob ? obs_data_create_from_json(blob->c_str()) : nullptr;
+	obs_data_t* hotkeys  = args[6].value_str.size() != 0 ? obs_data_create_from_json(args[6].value_str.c_str()) : nullptr;
+
+	obs_source_t* source = obs_source_create(sourceId.c_str(), name.c_str(), settings, hotkeys);
+	obs_data_release(hotkeys);
+	obs_data_release(settings);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to create input.");
+	}
+
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	if (uid == UINT64_MAX) {
+		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+	}
+	obs_data_t* settingsSource = obs_source_get_settings(source);
+	std::string json           = obs_data_get_full_json(settingsSource);
+	uint64_t    jsonId         = settings_store::hash(json);
+	obs_data_release(settingsSource);
+
+	// Skip the settings when the client already holds the same blob.
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uid));
+	rval.push_back(ipc::value(jsonId));
+	rval.push_back(ipc::value(jsonId == knownId ? std::string() : json));
+	rval.push_back(ipc::value(obs_source_get_audio_mixers(source)));
+	AUTO_DEBUG;
+}
+
 void osn::Input::CreatePrivate(
     void*                          data,
     const int64_t                  id,
@@ -30,6 +30,8 @@ void osn::Module::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("Modules", std::vector<ipc::type>{}, Modules));
 	cls->register_function(
 	    std::make_shared<ipc::function>("Initialize", std::vector<ipc::type>{ipc::type::UInt64}, Initialize));
+	cls->register_function(
+	    std::make_shared<ipc::function>("DescribeAll", std::vector<ipc::type>{}, DescribeAll));
 	cls->register_function(
 	    std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
 	cls->register_function(
@@ -106,6 +108,42 @@ void osn::Module::Initialize(
 	AUTO_DEBUG;
 }
 
+void osn::Module::DescribeAll(
+	void*                          data,
+	const int64_t                  id,
+	const std::vector<ipc::value>& args,
+	std::vector<ipc::value>&       rval)
+{
+	std::vector<obs_module_t*> modules;
+
+	obs_enum_modules([](void* param, obs_module_t* module) {
+		    static_cast<std::vector<obs_module_t*>*>(param)->push_back(module);
+	},&modules);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)modules.size()));
+
+	auto str = [](const char* value) { return ipc::value(value ? value : ""); };
+
+	// Modules loaded by libobs itself get an id here, so they can be used like opened ones.
+	// Ids are reused across calls and dropped on shutdown, the table never grows per call.
+	for (obs_module_t* module : modules) {
+		uint64_t uid = osn::Module::Manager::GetInstance().find(module);
+		if (uid == UINT64_MAX)
+			uid = osn::Module::Manager::GetInstance().allocate(module);
+
+		rval.push_back(ipc::value(uid));
+		rval.push_back(str(obs_get_module_file_name(module)));
+		rval.push_back(str(obs_get_module_name(module)));
+		rval.push_back(str(obs_get_module_author(module)));
+		rval.push_back(str(obs_get_module_description(module)));
+		rval.push_back(str(obs_get_module_binary_path(module)));
+		rval.push_back(str(obs_get_module_data_path(module)));
+	}
+
+	AUTO_DEBUG;
+}
+
 void osn::Module::GetName(
 	void*                          data,
 	const int64_t                  id,
@@ -0,0 +1,71 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-volmeter-snapshot.hpp"
+#include <cmath>
+#include <thread>
+
+void osn::VolmeterSnapshot::Store(
+    std::chrono::milliseconds time,
+    int32_t                   channels,
+    const float               magnitude_in[MAX_AUDIO_CHANNELS],
+    const float               peak_in[MAX_AUDIO_CHANNELS],
+    const float               input_peak_in[MAX_AUDIO_CHANNELS])
+{
+#define MAKE_FLOAT_SANE(db) (std::isfinite(db) ? db : (db > 0 ? 0.0f : -65535.0f))
+
+	// An odd sequence marks a write in progress.
+	uint32_t seq = sequence.load(std::memory_order_relaxed);
+	sequence.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	lastUpdateTime.store(time.count(), std::memory_order_relaxed);
+	ch.store(channels, std::memory_order_relaxed);
+	for (size_t idx = 0; idx < MAX_AUDIO_CHANNELS; idx++) {
+		magnitude[idx].store(MAKE_FLOAT_SANE(magnitude_in[idx]), std::memory_order_relaxed);
+		peak[idx].store(MAKE_FLOAT_SANE(peak_in[idx]), std::memory_order_relaxed);
+		input_peak[idx].store(MAKE_FLOAT_SANE(input_peak_in[idx]), std::memory_order_relaxed);
+	}
+
+	sequence.store(seq + 2, std::memory_order_release);
+
+#undef MAKE_FLOAT_SANE
+}
+
+void osn::VolmeterSnapshot::Load(VolmeterLevels& data) const
+{
+	for (;;) {
+		uint32_t seq = sequence.load(std::memory_order_acquire);
+		if (seq & 1) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		data.lastUpdateTime = std::chrono::milliseconds(lastUpdateTime.load(std::memory_order_relaxed));
+		data.ch             = ch.load(std::memory_order_relaxed);
+		for (size_t idx = 0; idx < MAX_AUDIO_CHANNELS; idx++) {
+			data.magnitude[idx]  = magnitude[idx].load(std::memory_order_relaxed);
+			data.peak[idx]       = peak[idx].load(std::memory_order_relaxed);
+			data.input_peak[idx] = input_peak[idx].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequence.load(std::memory_order_relaxed) == seq)
+			return;
+	}
+}
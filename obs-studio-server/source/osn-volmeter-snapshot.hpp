@@ -0,0 +1,73 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <media-io/audio-io.h>
+
+namespace osn
+{
+	/*!
+	* Levels of one volmeter as handed to the IPC handlers.
+	*/
+	struct VolmeterLevels
+	{
+		std::array<float, MAX_AUDIO_CHANNELS> magnitude{0};
+		std::array<float, MAX_AUDIO_CHANNELS> peak{0};
+		std::array<float, MAX_AUDIO_CHANNELS> input_peak{0};
+		std::chrono::milliseconds             lastUpdateTime = std::chrono::milliseconds(0);
+		int32_t                               ch             = 0;
+
+		void resetData()
+		{
+			std::fill(magnitude.begin(), magnitude.end(), -65535.0f);
+			std::fill(peak.begin(), peak.end(), -65535.0f);
+			std::fill(input_peak.begin(), input_peak.end(), -65535.0f);
+			lastUpdateTime = std::chrono::milliseconds(0);
+		}
+	};
+
+	/*!
+	* Latest levels, published by the audio thread through a sequence lock.
+	* The audio thread is the only writer and never waits, readers retry
+	* while a write is in progress.
+	*/
+	class VolmeterSnapshot
+	{
+		public:
+		void Store(
+		    std::chrono::milliseconds time,
+		    int32_t                   channels,
+		    const float               magnitude_in[MAX_AUDIO_CHANNELS],
+		    const float               peak_in[MAX_AUDIO_CHANNELS],
+		    const float               input_peak_in[MAX_AUDIO_CHANNELS]);
+		void Load(VolmeterLevels& data) const;
+
+		private:
+		std::atomic<uint32_t>                              sequence{0};
+		std::atomic<int32_t>                               ch{0};
+		std::atomic<int64_t>                               lastUpdateTime{0};
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> magnitude{};
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> peak{};
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> input_peak{};
+	};
+} // namespace osn
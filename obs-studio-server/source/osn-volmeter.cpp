@@ -23,6 +23,7 @@
 #include "shared.hpp"
 #include "utility.hpp"
 #include <cmath>
+#include <thread>
 
 std::mutex mtx;
 
@@ -66,10 +67,9 @@ void osn::Volmeter::ClearVolmeters()
 {
     Manager::GetInstance().for_each([](const std::shared_ptr<osn::Volmeter>& volmeter)
     {
-        if (volmeter->id2) {
-            obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter->id2);
-            delete volmeter->id2;
-            volmeter->id2 = nullptr;
+        if (volmeter->callback_added) {
+            obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter.get());
+            volmeter->callback_added = false;
         }
     });
 
@@ -119,10 +119,9 @@ void osn::Volmeter::Destroy(
 	}
 
 	Manager::GetInstance().free(uid);
-	if (meter->id2) { // Ensure there are no more callbacks
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
+	if (meter->callback_added) { // Ensure there are no more callbacks
+		obs_volmeter_remove_callback(meter->self, OBSCallback, meter.get());
+		meter->callback_added = false;
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -195,9 +194,10 @@ void osn::Volmeter::AddCallback(
 
 	meter->callback_count++;
 	if (meter->callback_count == 1) {
-		meter->id2  = new uint64_t;
-		*meter->id2 = meter->id;
-		obs_volmeter_add_callback(meter->self, OBSCallback, meter->id2);
+		// libobs does not call into a callback once it has been removed, so the meter
+		// itself can be handed to the audio thread without any id lookup.
+		obs_volmeter_add_callback(meter->self, OBSCallback, meter.get());
+		meter->callback_added = true;
 	}
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
@@ -219,10 +219,9 @@ void osn::Volmeter::RemoveCallback(
 	}
 
 	meter->callback_count--;
-	if (meter->callback_count == 0) {
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
+	if (meter->callback_count == 0 && meter->callback_added) {
+		obs_volmeter_remove_callback(meter->self, OBSCallback, meter.get());
+		meter->callback_added = false;
 	}
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
@@ -245,26 +244,17 @@ void osn::Volmeter::Query(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
+	AudioData audio_data;
+	meter->LoadAudioData(audio_data);
 
-	// Reset audio data if OBSCallBack is idle
-	if (meter->current_data.lastUpdateTime != std::chrono::milliseconds(0)) {
-		if (CheckIdle(GetTime(), meter->current_data.lastUpdateTime)) {
-			meter->current_data.resetData();
-		}
-	}
-	
-
-	rval.push_back(ipc::value(meter->current_data.ch));
+	rval.push_back(ipc::value(audio_data.ch));
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+	for (size_t ch = 0; ch < audio_data.ch; ch++) {
+		rval.push_back(ipc::value(audio_data.magnitude[ch]));
+		rval.push_back(ipc::value(audio_data.peak[ch]));
+		rval.push_back(ipc::value(audio_data.input_peak[ch]));
 	}
 
-	ulock.unlock();
-
 	AUTO_DEBUG;
 }
 
@@ -274,26 +264,21 @@ void osn::Volmeter::OBSCallback(
     const float peak[MAX_AUDIO_CHANNELS],
     const float input_peak[MAX_AUDIO_CHANNELS])
 {
-	std::unique_lock<std::mutex> ulockMutex(mtx);
-	auto meter = Manager::GetInstance().find(*reinterpret_cast<uint64_t*>(param));
-	if (!meter) {
-		return;
-	}
-
-#define MAKE_FLOAT_SANE(db) (std::isfinite(db) ? db : (db > 0 ? 0.0f : -65535.0f))
-#define PREVIOUS_FRAME_WEIGHT
+	// Runs on the audio thread, must not take any lock shared with the IPC handlers.
+	auto meter = static_cast<osn::Volmeter*>(param);
+	meter->current_data.Store(GetTime(), obs_volmeter_get_nr_channels(meter->self), magnitude, peak, input_peak);
+}
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
+void osn::Volmeter::LoadAudioData(AudioData& data)
+{
+	current_data.Load(data);
 
-	meter->current_data.lastUpdateTime = GetTime();
-	meter->current_data.ch = obs_volmeter_get_nr_channels(meter->self);
-	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
-		meter->current_data.magnitude[ch]  = MAKE_FLOAT_SANE(magnitude[ch]);
-		meter->current_data.peak[ch]       = MAKE_FLOAT_SANE(peak[ch]);
-		meter->current_data.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
+	// Report silence if OBSCallBack went idle
+	if (data.lastUpdateTime != std::chrono::milliseconds(0)) {
+		if (CheckIdle(GetTime(), data.lastUpdateTime)) {
+			data.resetData();
+		}
 	}
-
-#undef MAKE_FLOAT_SANE
 }
 
 std::chrono::milliseconds osn::Volmeter::GetTime()
@@ -321,9 +306,10 @@ void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value>& rval)
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Meter reference.");
 	}
 	
-	std::unique_lock<std::mutex> ulockMutex(meter->current_data_mtx);
+	AudioData audio_data;
+	meter->current_data.Load(audio_data);
 
-	rval.push_back(ipc::value(meter->current_data.ch));
+	rval.push_back(ipc::value(audio_data.ch));
 
 	auto source = osn::Source::Manager::GetInstance().find(meter->uid_source);
 	bool isMuted = source ? obs_source_muted(source) : true;
@@ -332,9 +318,9 @@ void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value>& rval)
 	if (isMuted)
 		return;
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+	for (size_t ch = 0; ch < audio_data.ch; ch++) {
+		rval.push_back(ipc::value(audio_data.magnitude[ch]));
+		rval.push_back(ipc::value(audio_data.peak[ch]));
+		rval.push_back(ipc::value(audio_data.input_peak[ch]));
 	}
 }
\ No newline at end of file
@@ -21,7 +21,10 @@
 #include <memory>
 #include <queue>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include "obs.h"
+#include "osn-volmeter-snapshot.hpp"
 #include "utility.hpp"
 
 extern std::mutex mtx;
@@ -51,28 +54,15 @@ namespace osn
 		obs_volmeter_t* self;
 		uint64_t        id;
 		size_t          callback_count = 0;
-		uint64_t*       id2            = nullptr;
+		bool            callback_added = false;
 		uint64_t        uid_source     = 0;
 
-		struct AudioData
-		{
-			std::array<float, MAX_AUDIO_CHANNELS> magnitude{0};
-			std::array<float, MAX_AUDIO_CHANNELS> peak{0};
-			std::array<float, MAX_AUDIO_CHANNELS> input_peak{0};
-			std::chrono::milliseconds             lastUpdateTime = std::chrono::milliseconds(0);
-			int32_t ch                             = 0;
-
-			void resetData()
-			{
-				std::fill(magnitude.begin(), magnitude.end(), -65535.0f);
-				std::fill(peak.begin(), peak.end(), -65535.0f);
-				std::fill(input_peak.begin(), input_peak.end(), -65535.0f);
-				lastUpdateTime = std::chrono::milliseconds(0);
-			}
-		};
+		using AudioData     = VolmeterLevels;
+		using AudioSnapshot = VolmeterSnapshot;
+
+		AudioSnapshot current_data;
 
-		AudioData current_data;
-		std::mutex current_data_mtx;
+		void LoadAudioData(AudioData& data);
 
 		public:
 		Volmeter(obs_fader_type type);
@@ -0,0 +1,103 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-bandwidthprobe.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+static const double CONFIDENCE_Z    = 1.96;
+static const double CONFIDENCE_SPAN = 0.05;
+
+bool util::ThroughputSampler::Add(uint64_t bytes, uint64_t timeNs)
+{
+	if (readings++ < WarmupReadings) {
+		firstBytes = lastBytes = bytes;
+		firstTime = lastTime = timeNs;
+		return false;
+	}
+
+	if (timeNs <= lastTime)
+		return false;
+
+	samples.push_back(double(bytes - lastBytes) * 8 * 1000000 / double(timeNs - lastTime));
+	lastBytes = bytes;
+	lastTime  = timeNs;
+
+	if (lastTime - firstTime >= MaxDuration)
+		return true;
+	return samples.size() >= MinSamples && Converged(samples);
+}
+
+uint64_t util::ThroughputSampler::Kbps() const
+{
+	if (lastTime <= firstTime)
+		return 0;
+	return (lastBytes - firstBytes) * 8 * 1000000000 / (lastTime - firstTime) / 1000;
+}
+
+bool util::ThroughputSampler::Converged(const std::vector<double>& samples)
+{
+	if (samples.size() < 2)
+		return false;
+
+	double mean = 0, variance = 0;
+	for (double kbps : samples)
+		mean += kbps;
+	mean /= samples.size();
+	for (double kbps : samples)
+		variance += (kbps - mean) * (kbps - mean);
+	variance /= samples.size() - 1;
+
+	double span = CONFIDENCE_Z * std::sqrt(variance / samples.size());
+	return span <= mean * CONFIDENCE_SPAN;
+}
+
+size_t util::ProbeConcurrency(uint64_t configured, size_t servers)
+{
+	size_t concurrency = (size_t)std::min<uint64_t>(std::max<uint64_t>(configured ? configured : 3, 1), 4);
+	return std::min(concurrency, servers);
+}
+
+int util::ProbeBitrate(uint64_t measuredKbps, bool dropped, int target)
+{
+	if (dropped || (int)measuredKbps < (target * 75 / 100))
+		return (int)measuredKbps * 70 / 100;
+	return target;
+}
+
+size_t util::PickBestProbe(const std::vector<ProbeResult>& results)
+{
+	size_t best = results.size();
+
+	for (size_t idx = 0; idx < results.size(); idx++) {
+		const ProbeResult& result = results[idx];
+		if (result.ms < 0)
+			continue;
+		if (best == results.size()) {
+			best = idx;
+			continue;
+		}
+
+		bool close = std::abs(result.bitrate - results[best].bitrate) < 400;
+		if ((!close && result.bitrate > results[best].bitrate) || (close && result.ms < results[best].ms))
+			best = idx;
+	}
+
+	return best;
+}
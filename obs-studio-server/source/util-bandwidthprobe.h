@@ -0,0 +1,80 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util
+{
+	// Decides when a bandwidth probe has watched the output byte counter long
+	// enough. The first readings cover the connection ramp-up and only open the
+	// window. After that sampling stops once the 95% confidence interval of the
+	// mean throughput is within 5% of it, or after 10 seconds of measurement.
+	// Takes plain readings, so the rule is tested on synthetic series.
+	class ThroughputSampler
+	{
+		public:
+		static const size_t   WarmupReadings = 2;
+		static const size_t   MinSamples     = 6;
+		static const uint64_t MaxDuration    = 10000000000ULL; // ns
+
+		// 'timeNs' is os_gettime_ns(). Returns true once sampling is done.
+		bool Add(uint64_t bytes, uint64_t timeNs);
+
+		// Mean throughput over the measured window in kbps, 0 before there is one.
+		uint64_t Kbps() const;
+
+		// Throughput in kbps between consecutive readings after the warmup.
+		const std::vector<double>& Samples() const
+		{
+			return samples;
+		}
+
+		// Whether the confidence interval of the mean is within 5% of it.
+		static bool Converged(const std::vector<double>& samples);
+
+		private:
+		std::vector<double> samples;
+		size_t              readings   = 0;
+		uint64_t            firstBytes = 0;
+		uint64_t            firstTime  = 0;
+		uint64_t            lastBytes  = 0;
+		uint64_t            lastTime   = 0;
+	};
+
+	// Probes to run side by side: the configured count, 3 when unset, clamped
+	// to 1..4 and to the number of servers.
+	size_t ProbeConcurrency(uint64_t configured, size_t servers);
+
+	// Bitrate to recommend from a probe's measured throughput: the target when
+	// the probe kept up, 70% of the measurement when it dropped frames or got
+	// below 75% of the target.
+	int ProbeBitrate(uint64_t measuredKbps, bool dropped, int target);
+
+	struct ProbeResult
+	{
+		int bitrate = 0;
+		int ms      = -1; // Connect time, negative when the server was not tested
+	};
+
+	// Highest throughput wins, results within 400 kbps of each other are ranked
+	// by connect time. Returns results.size() when no server was tested.
+	size_t PickBestProbe(const std::vector<ProbeResult>& results);
+} // namespace util
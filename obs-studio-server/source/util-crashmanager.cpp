@@ -69,10 +69,10 @@ std::vector<nlohmann::json>                breadcrumbs;
 std::queue<std::pair<int, nlohmann::json>> lastActions;
 std::vector<std::string>                   warnings;
 std::mutex                                 messageMutex;
-util::MetricsProvider                      metricsClient;
 LPTOP_LEVEL_EXCEPTION_FILTER               crashpadInternalExceptionFilterMethod = nullptr;
 #endif
 
+util::MetricsProvider                      metricsClient;
 std::string                                appState = "starting"; // "starting","idle","encoding","shutdown"
 // Crashpad variables
 #ifdef ENABLE_CRASHREPORT
@@ -554,6 +554,7 @@ bool util::CrashManager::TryHandleCrash(std::string _format, std::string _crashM
 
 		// Directly blame the user for this error since it was caused by the user side
 		util::CrashManager::GetMetricsProvider()->SendStatus("Handled Crash");
+		util::CrashManager::GetMetricsProvider()->Flush();
 
 		TerminateProcess(hnd, 0);
 	}
@@ -1027,9 +1028,7 @@ void util::CrashManager::DisableReports()
 
 util::MetricsProvider* const util::CrashManager::GetMetricsProvider()
 {
-#ifdef WIN32
 	return &metricsClient;
-#endif
 }
 
 void util::CrashManager::SaveToAppStateFile()
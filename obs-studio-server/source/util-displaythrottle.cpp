@@ -0,0 +1,81 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-displaythrottle.h"
+
+void util::DisplayThrottle::SetMaxFPS(uint32_t fps)
+{
+	maxFPS = fps;
+}
+
+uint32_t util::DisplayThrottle::GetMaxFPS() const
+{
+	return maxFPS;
+}
+
+void util::DisplayThrottle::SetHidden(bool value)
+{
+	hidden = value;
+}
+
+bool util::DisplayThrottle::GetHidden() const
+{
+	return hidden;
+}
+
+void util::DisplayThrottle::SetSize(uint32_t cx, uint32_t cy)
+{
+	width  = cx;
+	height = cy;
+}
+
+bool util::DisplayThrottle::Tick(uint64_t now, float seconds)
+{
+	bool render = !hidden && width > 0 && height > 0;
+
+	uint32_t fps = maxFPS;
+	if (render && fps > 0) {
+		// Half an output frame of slack, otherwise jitter in the tick makes a
+		// cap of half the output rate land on a third of it.
+		uint64_t interval = 1000000000ULL / fps;
+		uint64_t slack    = uint64_t(double(seconds) * 500000000.0);
+		if (lastRender && now - lastRender + slack < interval)
+			render = false;
+		else
+			lastRender = now;
+	}
+
+	if (!render)
+		skipped++;
+	return render;
+}
+
+void util::DisplayThrottle::CountRendered()
+{
+	rendered++;
+}
+
+void util::DisplayThrottle::CountSkipped()
+{
+	skipped++;
+}
+
+std::pair<uint64_t, uint64_t> util::DisplayThrottle::GetStats() const
+{
+	return {rendered.load(), skipped.load()};
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace util
+{
+	// Decides on the video thread's tick whether a display is drawn, from the
+	// frame rate cap, the hidden flag and the size set over IPC. It only keeps
+	// counters and times, so it is tested without a graphics device.
+	class DisplayThrottle
+	{
+		public:
+		DisplayThrottle(uint32_t width, uint32_t height) : width(width), height(height) {}
+
+		void     SetMaxFPS(uint32_t fps);
+		uint32_t GetMaxFPS() const;
+		void     SetHidden(bool hidden);
+		bool     GetHidden() const;
+		void     SetSize(uint32_t width, uint32_t height);
+
+		// Video thread only. 'now' is os_gettime_ns(), 'seconds' the length of
+		// an output frame. Counts a skipped frame when it returns false.
+		bool Tick(uint64_t now, float seconds);
+
+		void CountRendered();
+		void CountSkipped();
+
+		// Rendered and skipped frames since creation.
+		std::pair<uint64_t, uint64_t> GetStats() const;
+
+		private:
+		std::atomic<uint32_t> maxFPS{0};
+		std::atomic<bool>     hidden{false};
+		std::atomic<uint32_t> width;
+		std::atomic<uint32_t> height;
+		std::atomic<uint64_t> rendered{0};
+		std::atomic<uint64_t> skipped{0};
+		uint64_t              lastRender = 0;
+	};
+} // namespace util
@@ -0,0 +1,335 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-encoderbenchmark.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <util/platform.h>
+#include <util/threading.h>
+
+#ifdef WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#else
+#include <fstream>
+#endif
+
+/* Same threshold the wizard has always used to decide that an encoder can't
+ * keep up with a configuration. */
+static const uint64_t MAX_SKIPPED_FRAMES = 10;
+
+static const std::chrono::milliseconds STOP_TIMEOUT(5000);
+
+/* Rows are copied out of a shared noise pattern at a per-row, per-frame offset
+ * so every frame differs from the previous one without generating new data. */
+static const size_t NOISE_SPAN = 1 << 20;
+
+util::EncoderBenchmark::EncoderBenchmark(
+    obs_encoder_t*     vencoder,
+    obs_encoder_t*     aencoder,
+    obs_output_t*      output,
+    const std::string& cachePath)
+    : vencoder(vencoder), aencoder(aencoder), output(output), cachePath(cachePath)
+{
+	if (!cachePath.empty())
+		cache = obs_data_create_from_json_file_safe(cachePath.c_str(), "bak");
+	if (!cache)
+		cache = obs_data_create();
+
+	signal_handler_t* sh = obs_output_get_signal_handler(output);
+	signal_handler_connect(sh, "deactivate", OnDeactivate, this);
+}
+
+util::EncoderBenchmark::~EncoderBenchmark()
+{
+	signal_handler_t* sh = obs_output_get_signal_handler(output);
+	signal_handler_disconnect(sh, "deactivate", OnDeactivate, this);
+
+	obs_data_release(cache);
+}
+
+std::string util::EncoderBenchmark::GetCpuModel()
+{
+	std::string model;
+
+#ifdef WIN32
+	char  name[256] = {};
+	DWORD size      = sizeof(name);
+	if (RegGetValueA(
+	        HKEY_LOCAL_MACHINE,
+	        "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+	        "ProcessorNameString",
+	        RRF_RT_REG_SZ,
+	        nullptr,
+	        name,
+	        &size)
+	    == ERROR_SUCCESS)
+		model = name;
+#elif defined(__APPLE__)
+	char   name[256] = {};
+	size_t size      = sizeof(name);
+	if (sysctlbyname("machdep.cpu.brand_string", name, &size, nullptr, 0) == 0)
+		model = name;
+#else
+	std::ifstream cpuinfo("/proc/cpuinfo");
+	std::string   line;
+	while (std::getline(cpuinfo, line)) {
+		if (line.compare(0, 10, "model name") != 0)
+			continue;
+
+		size_t pos = line.find(':');
+		if (pos != std::string::npos)
+			model = line.substr(line.find_first_not_of(" \t", pos + 1));
+		break;
+	}
+#endif
+
+	if (model.empty())
+		model = "unknown";
+
+	/* The same part can be exposed with a different number of cores (VMs,
+	 * SMT disabled), which matters as much as the model itself. */
+	std::ostringstream key;
+	key << model << " (" << os_get_physical_cores() << "C/" << os_get_logical_cores() << "T)";
+	return key.str();
+}
+
+obs_data_t* util::EncoderBenchmark::GetCacheBucket()
+{
+	auto child = [](obs_data_t* parent, const char* name) {
+		obs_data_t* obj = obs_data_get_obj(parent, name);
+		if (!obj) {
+			obj = obs_data_create();
+			obs_data_set_obj(parent, name, obj);
+		}
+		return obj;
+	};
+
+	/* Results are only comparable for the same encoder and preset on the same
+	 * libobs build. Rate control settings such as the bitrate follow the
+	 * user's connection and barely change the encoding cost, so they are left
+	 * out to keep the cache hit across runs. */
+	obs_data_t*        settings = obs_encoder_get_settings(vencoder);
+	std::ostringstream key;
+	key << obs_encoder_get_id(vencoder) << " " << obs_get_version_string() << " "
+	    << obs_data_get_string(settings, "preset");
+	obs_data_release(settings);
+
+	obs_data_t* cpu    = child(cache, GetCpuModel().c_str());
+	obs_data_t* bucket = child(cpu, key.str().c_str());
+	obs_data_release(cpu);
+	return bucket;
+}
+
+bool util::EncoderBenchmark::Run(
+    const Config&                config,
+    std::chrono::milliseconds    duration,
+    const std::function<bool()>& cancelled,
+    Result&                      result)
+{
+	std::ostringstream key;
+	key << config.cx << "x" << config.cy << "@" << config.fps_num << "/" << config.fps_den;
+
+	obs_data_t* bucket = GetCacheBucket();
+	obs_data_t* entry  = obs_data_get_obj(bucket, key.str().c_str());
+
+	if (entry) {
+		result.encodeFps = obs_data_get_double(entry, "encodeFps");
+		result.cpu       = obs_data_get_double(entry, "cpu");
+		result.skipped   = uint64_t(obs_data_get_int(entry, "skipped"));
+		result.total     = uint64_t(obs_data_get_int(entry, "total"));
+		result.cached    = true;
+
+		obs_data_release(entry);
+		obs_data_release(bucket);
+		return true;
+	}
+
+	if (!Measure(config, duration, cancelled, result)) {
+		obs_data_release(bucket);
+		return false;
+	}
+
+	entry = obs_data_create();
+	obs_data_set_double(entry, "encodeFps", result.encodeFps);
+	obs_data_set_double(entry, "cpu", result.cpu);
+	obs_data_set_int(entry, "skipped", int64_t(result.skipped));
+	obs_data_set_int(entry, "total", int64_t(result.total));
+	obs_data_set_obj(bucket, key.str().c_str(), entry);
+	obs_data_release(entry);
+	obs_data_release(bucket);
+
+	dirty = true;
+	return true;
+}
+
+void util::EncoderBenchmark::Save()
+{
+	if (!dirty || cachePath.empty())
+		return;
+
+	if (obs_data_save_json_safe(cache, cachePath.c_str(), "tmp", "bak"))
+		dirty = false;
+	else
+		blog(LOG_WARNING, "Failed to save encoder benchmark cache to '%s'", cachePath.c_str());
+}
+
+void util::EncoderBenchmark::OnDeactivate(void* data, calldata_t*)
+{
+	EncoderBenchmark*            self = reinterpret_cast<EncoderBenchmark*>(data);
+	std::unique_lock<std::mutex> lock(self->mtx);
+	self->active  = false;
+	self->stopped = os_gettime_ns();
+	self->cv.notify_all();
+}
+
+void util::EncoderBenchmark::FillFrame(struct video_frame& frame, const Config& config, uint64_t index)
+{
+	/* NV12: full size luma plane followed by an interleaved half height
+	 * chroma plane, both config.cx bytes wide. */
+	const uint32_t heights[2] = {config.cy, config.cy / 2};
+
+	for (size_t plane = 0; plane < 2; plane++) {
+		for (uint32_t row = 0; row < heights[plane]; row++) {
+			size_t offset = size_t((row * 1031 + index * 97 + plane * 4099) % NOISE_SPAN);
+			memcpy(frame.data[plane] + size_t(row) * frame.linesize[plane], noise.data() + offset, config.cx);
+		}
+	}
+}
+
+bool util::EncoderBenchmark::Measure(
+    const Config&                config,
+    std::chrono::milliseconds    duration,
+    const std::function<bool()>& cancelled,
+    Result&                      result)
+{
+	if (noise.size() < NOISE_SPAN + config.cx) {
+		/* Moderate amplitude noise: busy enough that the encoder can't skip
+		 * blocks, without being the pathological worst case of full range
+		 * white noise. */
+		std::mt19937                       rng(0x0b5);
+		std::uniform_int_distribution<int> dist(64, 191);
+
+		noise.resize(NOISE_SPAN + config.cx);
+		for (uint8_t& value : noise)
+			value = uint8_t(dist(rng));
+	}
+
+	struct video_output_info voi = {};
+	voi.name                     = "encoder_benchmark";
+	voi.format                   = VIDEO_FORMAT_NV12;
+	voi.fps_num                  = config.fps_num;
+	voi.fps_den                  = config.fps_den;
+	voi.width                    = config.cx;
+	voi.height                   = config.cy;
+	voi.cache_size               = 6;
+	voi.colorspace               = VIDEO_CS_709;
+	voi.range                    = VIDEO_RANGE_PARTIAL;
+
+	video_t* video = nullptr;
+	if (video_output_open(&video, &voi) != VIDEO_OUTPUT_SUCCESS) {
+		blog(LOG_WARNING, "Encoder benchmark: failed to open a %ux%u video output", config.cx, config.cy);
+		return false;
+	}
+
+	obs_encoder_set_video(vencoder, video);
+	obs_encoder_set_audio(aencoder, obs_get_audio());
+	obs_output_set_media(output, video, obs_get_audio());
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		active = true;
+	}
+
+	if (!obs_output_start(output)) {
+		blog(LOG_WARNING, "Encoder benchmark: failed to start output for %ux%u", config.cx, config.cy);
+		obs_encoder_set_video(vencoder, obs_get_video());
+		video_output_close(video);
+		return false;
+	}
+
+	/* Only video packets that made it out of the encoder are counted. */
+	const uint64_t encodedBase = uint64_t(obs_output_get_total_frames(output));
+
+	const uint64_t interval = 1000000000ULL * config.fps_den / config.fps_num;
+	const uint64_t start    = os_gettime_ns();
+	const uint64_t end      = start + uint64_t(std::chrono::nanoseconds(duration).count());
+
+	os_cpu_usage_info_t* cpuInfo = os_cpu_usage_info_start();
+
+	bool     aborted = false;
+	uint64_t index   = 0;
+	for (uint64_t next = start; next < end; next += interval, index++) {
+		if (cancelled && cancelled()) {
+			aborted = true;
+			break;
+		}
+
+		struct video_frame frame;
+		if (video_output_lock_frame(video, &frame, 1, next)) {
+			FillFrame(frame, config, index);
+			video_output_unlock_frame(video);
+		}
+
+		/* Once the encoder has fallen behind the result can't change. */
+		if (video_output_get_skipped_frames(video) > MAX_SKIPPED_FRAMES)
+			break;
+
+		os_sleepto_ns(next + interval);
+	}
+
+	result.cpu       = os_cpu_usage_info_query(cpuInfo);
+	result.skipped   = video_output_get_skipped_frames(video);
+	result.total     = video_output_get_total_frames(video);
+	result.cached    = false;
+	os_cpu_usage_info_destroy(cpuInfo);
+
+	/* Stopping drains the encoder, so the rate below is packets actually
+	 * encoded over the time it took to produce them, not the rate frames
+	 * were fed in. */
+	obs_output_stop(output);
+	uint64_t stoppedAt = 0;
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		if (cv.wait_for(lock, STOP_TIMEOUT, [this]() { return !active; })) {
+			stoppedAt = stopped;
+		} else {
+			lock.unlock();
+			blog(LOG_WARNING, "Encoder benchmark: output did not stop in time, forcing it");
+			obs_output_force_stop(output);
+		}
+	}
+	if (!stoppedAt)
+		stoppedAt = os_gettime_ns();
+
+	uint64_t encoded = uint64_t(obs_output_get_total_frames(output));
+	encoded          = encoded >= encodedBase ? encoded - encodedBase : encoded;
+	result.encodeFps = double(encoded) * 1000000000.0 / double(std::max<uint64_t>(stoppedAt - start, 1));
+
+	/* The encoder must not reference the private video output past this
+	 * point. */
+	obs_encoder_set_video(vencoder, obs_get_video());
+	obs_output_set_media(output, obs_get_video(), obs_get_audio());
+	video_output_close(video);
+
+	return !aborted;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <obs.h>
+
+namespace util
+{
+	/* Measures how well the software video encoder keeps up with a given
+	 * resolution/framerate. A single encoder/output chain is kept warm across
+	 * configurations and fed synthetic frames from a private video output, so
+	 * the global video pipeline never has to be reset between runs. Results are
+	 * cached on disk per CPU model and encoder preset. */
+	class EncoderBenchmark
+	{
+		public:
+		struct Config
+		{
+			uint32_t cx;
+			uint32_t cy;
+			uint32_t fps_num;
+			uint32_t fps_den;
+		};
+
+		struct Result
+		{
+			double   encodeFps = 0.0;
+			double   cpu       = 0.0;
+			uint64_t skipped   = 0;
+			uint64_t total     = 0;
+			bool     cached    = false;
+		};
+
+		EncoderBenchmark(
+		    obs_encoder_t*     vencoder,
+		    obs_encoder_t*     aencoder,
+		    obs_output_t*      output,
+		    const std::string& cachePath);
+		~EncoderBenchmark();
+
+		/* Runs (or looks up) a single configuration. Returns false if the run
+		 * was cancelled or the pipeline could not be started. */
+		bool Run(
+		    const Config&                config,
+		    std::chrono::milliseconds    duration,
+		    const std::function<bool()>& cancelled,
+		    Result&                      result);
+
+		void Save();
+
+		static std::string GetCpuModel();
+
+		private:
+		bool Measure(
+		    const Config&                config,
+		    std::chrono::milliseconds    duration,
+		    const std::function<bool()>& cancelled,
+		    Result&                      result);
+
+		obs_data_t* GetCacheBucket();
+		void        FillFrame(struct video_frame& frame, const Config& config, uint64_t index);
+
+		static void OnDeactivate(void* data, calldata_t*);
+
+		obs_encoder_t* vencoder;
+		obs_encoder_t* aencoder;
+		obs_output_t*  output;
+
+		std::string cachePath;
+		obs_data_t* cache = nullptr;
+		bool        dirty = false;
+
+		std::vector<uint8_t> noise;
+
+		std::mutex              mtx;
+		std::condition_variable cv;
+		bool                    active  = false;
+		uint64_t                stopped = 0;
+	};
+} // namespace util
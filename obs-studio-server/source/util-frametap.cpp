@@ -0,0 +1,175 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-frametap.h"
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <graphics/vec4.h>
+#include <util/platform.h>
+
+// Names only have to be unique inside this process, the pid covers the rest.
+static std::atomic<uint32_t> nextTapId{1};
+
+static uint64_t CurrentProcessId()
+{
+#ifdef _WIN32
+	return uint64_t(GetCurrentProcessId());
+#else
+	return uint64_t(getpid());
+#endif
+}
+
+util::FrameTap::FrameTap(obs_video_rendering_mode mode, uint32_t width, uint32_t height, uint32_t fps)
+    : mode(mode), width(width), height(height)
+{
+	interval = fps > 0 ? 1000000000ULL / fps : 0;
+
+	uint32_t    stride  = width * 4;
+	std::string shmName = frametap::SharedMemoryName(CurrentProcessId(), nextTapId++);
+	if (!memory.Create(shmName, frametap::MappingSize(stride, height))) {
+		blog(LOG_ERROR, "Failed to create frame tap shared memory '%s'.", shmName.c_str());
+		return;
+	}
+
+	header            = new (memory.Data()) frametap::Header();
+	header->magic     = frametap::Magic;
+	header->version   = frametap::Version;
+	header->width     = width;
+	header->height    = height;
+	header->stride    = stride;
+	header->slotCount = frametap::SlotCount;
+	header->frameSize = uint64_t(stride) * height;
+	header->latest.store(0);
+	for (frametap::Slot& slot : header->slots) {
+		slot.sequence.store(0);
+		slot.timestamp = 0;
+	}
+
+	obs_enter_graphics();
+	texrender = gs_texrender_create(GS_BGRA, GS_ZS_NONE);
+	for (gs_stagesurf_t*& stage : stages)
+		stage = gs_stagesurface_create(width, height, GS_BGRA);
+	obs_leave_graphics();
+
+	name = shmName;
+	obs_add_tick_callback(Tick, this);
+}
+
+util::FrameTap::~FrameTap()
+{
+	if (!name.empty())
+		obs_remove_tick_callback(Tick, this);
+
+	obs_enter_graphics();
+	gs_texrender_destroy(texrender);
+	for (gs_stagesurf_t* stage : stages)
+		gs_stagesurface_destroy(stage);
+	obs_leave_graphics();
+}
+
+void util::FrameTap::Tick(void* data, float seconds)
+{
+	UNUSED_PARAMETER(seconds);
+	FrameTap* tap = static_cast<FrameTap*>(data);
+
+	uint64_t now = os_gettime_ns();
+	if (tap->interval && tap->lastCapture && now - tap->lastCapture < tap->interval)
+		return;
+	tap->lastCapture = now;
+
+	obs_enter_graphics();
+	tap->Capture();
+	obs_leave_graphics();
+}
+
+void util::FrameTap::Capture()
+{
+	if (!texrender || !stages[0] || !stages[1])
+		return;
+
+	obs_video_info ovi;
+	if (!obs_get_video_info(&ovi))
+		return;
+
+	gs_texrender_reset(texrender);
+	if (gs_texrender_begin(texrender, width, height)) {
+		vec4 clear;
+		vec4_zero(&clear);
+		gs_clear(GS_CLEAR_COLOR, &clear, 0.0f, 0);
+		gs_ortho(0.0f, float(ovi.base_width), 0.0f, float(ovi.base_height), -100.0f, 100.0f);
+
+		gs_blend_state_push();
+		gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+		switch (mode) {
+		case OBS_MAIN_VIDEO_RENDERING:
+			obs_render_main_texture();
+			break;
+		case OBS_STREAMING_VIDEO_RENDERING:
+			obs_render_streaming_texture();
+			break;
+		case OBS_RECORDING_VIDEO_RENDERING:
+			obs_render_recording_texture();
+			break;
+		}
+		gs_blend_state_pop();
+		gs_texrender_end(texrender);
+
+		gs_stage_texture(stages[current], gs_texrender_get_texture(texrender));
+		stagedTimestamp[current] = os_gettime_ns();
+	}
+
+	// The other surface was staged on the previous capture, its copy has had a
+	// whole tick to finish.
+	uint32_t previous = current ^ 1;
+	if (staged)
+		Publish(stages[previous], stagedTimestamp[previous]);
+
+	staged  = true;
+	current = previous;
+}
+
+void util::FrameTap::Publish(gs_stagesurf_t* surface, uint64_t timestamp)
+{
+	uint8_t* data     = nullptr;
+	uint32_t linesize = 0;
+	if (!gs_stagesurface_map(surface, &data, &linesize))
+		return;
+
+	// Seqlock: a slot reads as 0 while it is rewritten, readers compare the
+	// sequence before and after copying to catch a frame that was overwritten.
+	uint64_t        frame = ++sequence;
+	frametap::Slot& slot  = header->slots[frametap::SlotIndex(frame)];
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	uint8_t* dst = static_cast<uint8_t*>(memory.Data()) + frametap::FramesOffset
+	               + size_t(frametap::SlotIndex(frame)) * header->frameSize;
+	if (linesize == header->stride) {
+		std::memcpy(dst, data, header->frameSize);
+	} else {
+		for (uint32_t y = 0; y < height; y++)
+			std::memcpy(dst + size_t(y) * header->stride, data + size_t(y) * linesize, header->stride);
+	}
+
+	slot.timestamp = timestamp;
+	slot.sequence.store(frame, std::memory_order_release);
+	header->latest.store(frame, std::memory_order_release);
+
+	gs_stagesurface_unmap(surface);
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <string>
+#include "frame-tap.hpp"
+
+namespace util
+{
+	// Renders one of the output textures at a reduced size and publishes it to
+	// a shared memory ring (see frame-tap.hpp), so a client can look at the
+	// program without a window. Rendering and the GPU readback happen on the
+	// video thread's tick; a staged frame is read back one tick later so the
+	// map never waits on the GPU.
+	class FrameTap
+	{
+		public:
+		FrameTap(obs_video_rendering_mode mode, uint32_t width, uint32_t height, uint32_t fps);
+		~FrameTap();
+
+		FrameTap(const FrameTap&) = delete;
+		FrameTap& operator=(const FrameTap&) = delete;
+
+		// Empty when the shared memory could not be created.
+		const std::string& GetSharedMemoryName() const
+		{
+			return name;
+		}
+
+		private:
+		static void Tick(void* data, float seconds);
+
+		void Capture();
+		void Publish(gs_stagesurf_t* surface, uint64_t timestamp);
+
+		obs_video_rendering_mode mode;
+		uint32_t                 width;
+		uint32_t                 height;
+		uint64_t                 interval;
+		uint64_t                 lastCapture = 0;
+
+		std::string            name;
+		frametap::SharedMemory memory;
+		frametap::Header*      header   = nullptr;
+		uint64_t               sequence = 0;
+
+		gs_texrender_t* texrender          = nullptr;
+		gs_stagesurf_t* stages[2]          = {nullptr, nullptr};
+		uint64_t        stagedTimestamp[2] = {0, 0};
+		uint32_t        current            = 0;
+		bool            staged             = false;
+	};
+} // namespace util
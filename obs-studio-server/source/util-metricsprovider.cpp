@@ -18,7 +18,7 @@
 
 #include "util-metricsprovider.h"
 
-#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <thread>
@@ -31,15 +31,26 @@
 #include <windows.h>
 #include "TCHAR.h"
 
+#else
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <util/base.h>
+
 #endif
 
 ///////////////////////
 // MetricsPipeClient //
 ///////////////////////
-#ifdef WIN32
 util::MetricsProvider::~MetricsProvider()
 {
+	// The polling thread drains whatever is still queued before leaving
 	m_StopPolling = true;
+	{
+		std::lock_guard<std::mutex> l(m_WakeMutex);
+		m_WakeCondition.notify_one();
+	}
 	if (m_PollingThread.joinable()) {
 		m_PollingThread.join();
 	}
@@ -48,26 +59,46 @@ util::MetricsProvider::~MetricsProvider()
 
 	// If we should blame the server
 	if (m_BlameServer) {
-		message.type = MessageType::Status;
-		strcpy_s(message.param1, "Backend Crash");
+		message.type   = MessageType::Status;
+		message.param1 = "Backend Crash";
 	} else if (m_BlameFrontend) {
-		message.type = MessageType::Status;
-		strcpy_s(message.param1, "Frontend Crash");
+		message.type   = MessageType::Status;
+		message.param1 = "Frontend Crash";
 	} else if (m_BlameUser) {
-		message.type = MessageType::Status;
-		strcpy_s(message.param1, "User Crash");
+		message.type   = MessageType::Status;
+		message.param1 = "User Crash";
 	} else {
 		message.type = MessageType::Shutdown;
 	}
 
 	if (m_PipeIsOpen) {
-		SendPipeMessage(message);
+		WritePending();
+
+		std::vector<char> buffer;
+		SerializeMessage(message, buffer);
+
+		std::lock_guard<std::mutex> l(m_WriteMutex);
+		SendPipeMessage(buffer);
+#ifdef WIN32
 		CloseHandle(m_Pipe);
+#else
+		close(m_Socket);
+#endif
+		m_PipeIsOpen = false;
+	}
+
+	// Anything left can only come from a pipe that was never opened
+	MetricsMessage* pending = m_Pending.exchange(nullptr);
+	while (pending) {
+		MetricsMessage* next = pending->next;
+		delete pending;
+		pending = next;
 	}
 }
 
 bool util::MetricsProvider::Initialize(std::string pipe_name, std::string current_version, bool send_messages_async)
 {
+#ifdef WIN32
 	m_Pipe = CreateFileA(
 	    pipe_name.c_str(),
 	    GENERIC_WRITE,
@@ -84,14 +115,49 @@ bool util::MetricsProvider::Initialize(std::string pipe_name, std::string curren
 		return false;
 	}
 
+	uint32_t pid = uint32_t(GetCurrentProcessId());
+#else
+	sockaddr_un address = {};
+	address.sun_family  = AF_UNIX;
+	if (pipe_name.size() >= sizeof(address.sun_path)) {
+		blog(LOG_WARNING, "Metrics socket path '%s' is too long.", pipe_name.c_str());
+		m_PipeIsOpen = false;
+		return false;
+	}
+	strncpy(address.sun_path, pipe_name.c_str(), sizeof(address.sun_path) - 1);
+
+	m_Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (m_Socket < 0 || connect(m_Socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+		blog(LOG_WARNING, "Failed to connect to the metrics socket '%s', metrics are disabled.", pipe_name.c_str());
+		if (m_Socket >= 0)
+			close(m_Socket);
+		m_Socket     = -1;
+		m_PipeIsOpen = false;
+		return false;
+	}
+
+#ifdef SO_NOSIGPIPE
+	// A crash handler going away must not take us down with SIGPIPE
+	int noSigPipe = 1;
+	setsockopt(m_Socket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+	uint32_t pid = uint32_t(getpid());
+#endif
+
 	m_PipeIsOpen = true;
 
 	// Send the pid
 	MetricsMessage message;
-	DWORD          pid = GetCurrentProcessId();
-	message.type       = MessageType::Pid;
-	memcpy(message.param1, &pid, sizeof(DWORD));
-	bool result = SendPipeMessage(message);
+	message.type   = MessageType::Pid;
+	message.param1 = std::string(reinterpret_cast<const char*>(&pid), sizeof(pid));
+
+	std::vector<char> buffer;
+	SerializeMessage(message, buffer);
+	{
+		std::lock_guard<std::mutex> l(m_WriteMutex);
+		SendPipeMessage(buffer);
+	}
 
 	// Start pooling and send our tag
 	StartPolling(send_messages_async);
@@ -105,110 +171,174 @@ void util::MetricsProvider::StartPolling(bool send_messages_async)
 	// Update how we should send the messages, it it's synchronous just exist
 	m_SendMessagesAsync = send_messages_async;
 	if (!m_SendMessagesAsync) {
+		// Deliver anything queued before we knew how to send it
+		WritePending();
 		return;
 	}
 
 	m_PollingThread = std::thread([=]() {
-		while (!m_StopPolling) {
-			// Check if we have data to be sent
+		while (true) {
 			{
-				m_PollingMutex.lock();
-				std::queue<MetricsMessage> pendingData = std::move(m_AsyncData);
-				m_PollingMutex.unlock();
-
-				while (!pendingData.empty()) {
-					auto message = pendingData.front();
-					pendingData.pop();
-
-					bool result = SendPipeMessage(message);
-					if (!result) {
-						// ?
-					}
-				}
+				std::unique_lock<std::mutex> lock(m_WakeMutex);
+				m_WakeCondition.wait(lock, [this]() { return m_Pending.load() != nullptr || m_StopPolling; });
 			}
 
-			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			WritePending();
+
+			if (m_StopPolling && m_Pending.load() == nullptr)
+				break;
 		}
 	});
 }
 
 void util::MetricsProvider::SendStatus(std::string status)
 {
-	MetricsMessage message = {};
-	message.type           = MessageType::Status;
-	strcpy_s(message.param1, status.c_str());
-
-	PrepareMessage(message);
+	PrepareMessage(MessageType::Status, std::move(status));
 }
 
 void util::MetricsProvider::SendTag(std::string tag, std::string value)
 {
-	MetricsMessage message = {};
-	message.type           = MessageType::Tag;
-	strcpy_s(message.param1, tag.c_str());
-	strcpy_s(message.param2, value.c_str());
+	PrepareMessage(MessageType::Tag, std::move(tag), std::move(value));
+}
+
+void util::MetricsProvider::PrepareMessage(MessageType type, std::string param1, std::string param2)
+{
+	// Check if the message should be send asynchronous, else send it directly
+	if (!m_SendMessagesAsync) {
+		MetricsMessage message;
+		message.type   = type;
+		message.param1 = std::move(param1);
+		message.param2 = std::move(param2);
+
+		std::vector<char> buffer;
+		SerializeMessage(message, buffer);
+
+		std::lock_guard<std::mutex> l(m_WriteMutex);
+		SendPipeMessage(buffer);
+		return;
+	}
+
+	MetricsMessage* message = new MetricsMessage;
+	message->type           = type;
+	message->param1         = std::move(param1);
+	message->param2         = std::move(param2);
+
+	// Push onto the pending stack, producers never block each other or the writer.
+	// The message belongs to the writer as soon as the exchange succeeds, so only
+	// the local copy of the previous head is looked at afterwards.
+	MetricsMessage* head = m_Pending.load(std::memory_order_relaxed);
+	do {
+		message->next = head;
+	} while (!m_Pending.compare_exchange_weak(head, message, std::memory_order_release, std::memory_order_relaxed));
+
+	// Only the message that made the stack non-empty needs to wake the writer, it
+	// picks up everything pushed after it in the same batch
+	if (head == nullptr) {
+		std::lock_guard<std::mutex> l(m_WakeMutex);
+		m_WakeCondition.notify_one();
+	}
+}
+
+void util::MetricsProvider::WritePending()
+{
+	std::lock_guard<std::mutex> l(m_WriteMutex);
 
-	PrepareMessage(message);
+	MetricsMessage* head = m_Pending.exchange(nullptr, std::memory_order_acquire);
+	if (!head)
+		return;
+
+	// The stack holds the newest message first, restore the send order
+	MetricsMessage* ordered = nullptr;
+	while (head) {
+		MetricsMessage* next = head->next;
+		head->next           = ordered;
+		ordered              = head;
+		head                 = next;
+	}
+
+	// Coalesce the whole batch into a single write
+	std::vector<char> buffer;
+	while (ordered) {
+		MetricsMessage* next = ordered->next;
+		SerializeMessage(*ordered, buffer);
+		delete ordered;
+		ordered = next;
+	}
+
+	SendPipeMessage(buffer);
 }
 
-void util::MetricsProvider::PrepareMessage(MetricsMessage& message)
+void util::MetricsProvider::Flush()
 {
-	std::lock_guard<std::mutex> l(m_PollingMutex);
+	WritePending();
+}
 
-	// Check if the message should be send asynchronous, else send it directly
-	if (m_SendMessagesAsync) {
-		m_AsyncData.emplace(message);
-	} else {
-		SendPipeMessage(message);
-    }
+void util::MetricsProvider::SerializeMessage(const MetricsMessage& message, std::vector<char>& buffer)
+{
+	auto putU32 = [&buffer](uint32_t value) {
+		for (int i = 0; i < 4; i++)
+			buffer.push_back(char((value >> (8 * i)) & 0xFF));
+	};
+	auto putString = [&](const std::string& value) {
+		putU32(uint32_t(value.size()));
+		buffer.insert(buffer.end(), value.begin(), value.end());
+	};
+
+	putU32(uint32_t(1 + 4 + message.param1.size() + 4 + message.param2.size()));
+	buffer.push_back(char(message.type));
+	putString(message.param1);
+	putString(message.param2);
 }
 
-bool util::MetricsProvider::SendPipeMessage(MetricsMessage& message)
+bool util::MetricsProvider::SendPipeMessage(const std::vector<char>& buffer)
 {
-	if (m_PipeIsOpen) {
+	if (!m_PipeIsOpen)
+		return false;
+
+	const char* data      = buffer.data();
+	size_t      remaining = buffer.size();
+	while (remaining > 0) {
+#ifdef WIN32
 		DWORD numBytesWritten = 0;
-		return WriteFile(
-		    m_Pipe,                 // handle to our outbound pipe
-		    &message,               // data to send
-		    sizeof(MetricsMessage), // length of data to send (bytes)
-		    &numBytesWritten,       // will store actual amount of data sent
-		    NULL                    // not using overlapped IO
-		);
+		if (!WriteFile(
+		        m_Pipe,           // handle to our outbound pipe
+		        data,             // data to send
+		        DWORD(remaining), // length of data to send (bytes)
+		        &numBytesWritten, // will store actual amount of data sent
+		        NULL              // not using overlapped IO
+		        ))
+			return false;
+		size_t written = numBytesWritten;
+#else
+#ifdef MSG_NOSIGNAL
+		ssize_t written = send(m_Socket, data, remaining, MSG_NOSIGNAL);
+#else
+		ssize_t written = send(m_Socket, data, remaining, 0);
+#endif
+		if (written <= 0)
+			return false;
+#endif
+		data += written;
+		remaining -= size_t(written);
 	}
 
-	return false;
+	return true;
 }
 
 void util::MetricsProvider::BlameServer()
 {
 	m_BlameServer = true;
-
-    MetricsMessage message = {};
-	message.type           = MessageType::Blame;
-	strcpy_s(message.param1, "Backend Crash");
-
-	PrepareMessage(message);
+	PrepareMessage(MessageType::Blame, "Backend Crash");
 }
 
 void util::MetricsProvider::BlameUser()
 {
 	m_BlameUser = true;
-
-    MetricsMessage message = {};
-	message.type           = MessageType::Blame;
-	strcpy_s(message.param1, "User Crash");
-
-	PrepareMessage(message);
+	PrepareMessage(MessageType::Blame, "User Crash");
 }
 
 void util::MetricsProvider::BlameFrontend()
 {
 	m_BlameFrontend = true;
-
-    MetricsMessage message = {};
-	message.type           = MessageType::Blame;
-	strcpy_s(message.param1, "Frontend Crash");
-
-	PrepareMessage(message);
+	PrepareMessage(MessageType::Blame, "Frontend Crash");
 }
-#endif
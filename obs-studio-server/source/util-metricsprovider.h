@@ -18,12 +18,14 @@
  */
 
 #pragma once
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 #include <vector>
 #include <mutex>
-#include <queue>
 #include <thread>
 
 #undef strtoll
@@ -33,9 +35,7 @@ namespace util
 {
     class MetricsProvider
     {
-        const static int StringSize = 64;
-
-        enum class MessageType
+        enum class MessageType : uint8_t
         {
             Pid,
             Tag,
@@ -44,19 +44,23 @@ namespace util
             Shutdown
         };
 
+        // Messages are linked intrusively so producers can publish them with a single
+        // compare-and-swap, see PrepareMessage()
         struct MetricsMessage
         {
-            MessageType type;
-            char        param1[StringSize];
-            char        param2[StringSize];
+            MessageType     type;
+            std::string     param1;
+            std::string     param2;
+            MetricsMessage* next = nullptr;
         };
 
         public:
         ~MetricsProvider();
 
-        // Connect this client with the crash handler pipe indicated by 'pipe_name', optionally
-        // you can pass the current SLOBS version (parameter 'current_version') and set if the
-        // IPC messages should be send synchronously or asynchronously (parameter 'send_messages_async')
+        // Connect this client with the crash handler pipe indicated by 'pipe_name' (a named pipe on
+        // Windows, a UNIX domain socket path elsewhere), optionally you can pass the current SLOBS
+        // version (parameter 'current_version') and set if the IPC messages should be send
+        // synchronously or asynchronously (parameter 'send_messages_async')
         bool Initialize(std::string pipe_name, std::string current_version = "unknown", bool send_messages_async = true);
 
         // Send an status to the crash handler, if SLOBS crashes unexpectedly this status will be
@@ -73,20 +77,35 @@ namespace util
         void BlameUser();
         void BlameFrontend();
 
+        // Write every queued message from the calling thread, use this before the process is
+        // terminated on purpose so nothing is left behind in the queue.
+        void Flush();
+
         private:
         void StartPolling(bool send_messages_async = true);
         void SendTag(std::string tag, std::string value);
-        void PrepareMessage(MetricsMessage& message);
-        bool SendPipeMessage(MetricsMessage& message);
+        void PrepareMessage(MessageType type, std::string param1 = "", std::string param2 = "");
+        void WritePending();
+        bool SendPipeMessage(const std::vector<char>& buffer);
+
+        // Wire format, one frame per message, all integers little endian:
+        // u32 frame size (excluding itself), u8 type, u32 param1 size, param1, u32 param2 size, param2
+        static void SerializeMessage(const MetricsMessage& message, std::vector<char>& buffer);
 
         private:
-        void*                      m_Pipe;
-        bool                       m_PipeIsOpen        = false;
-        bool                       m_StopPolling       = false;
-        bool                       m_SendMessagesAsync = true;
-        std::thread                m_PollingThread;
-        std::mutex                 m_PollingMutex;
-        std::queue<MetricsMessage> m_AsyncData;
+#ifdef WIN32
+        void* m_Pipe = nullptr;
+#else
+        int m_Socket = -1;
+#endif
+        bool                         m_PipeIsOpen        = false;
+        bool                         m_SendMessagesAsync = true;
+        std::atomic<bool>            m_StopPolling       = {false};
+        std::thread                  m_PollingThread;
+        std::mutex                   m_WriteMutex;
+        std::mutex                   m_WakeMutex;
+        std::condition_variable      m_WakeCondition;
+        std::atomic<MetricsMessage*> m_Pending = {nullptr};
 
         bool m_BlameServer   = false;
         bool m_BlameFrontend = false;
@@ -0,0 +1,386 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-snapshot.h"
+#include <cstring>
+#include <util/bmem.h>
+#include <util/platform.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Nesting deeper than this is treated as a corrupt file rather than recursed into.
+static constexpr uint32_t MaxDataDepth = 64;
+
+enum DataItemType : uint8_t
+{
+	DataNull   = 0,
+	DataString = 1,
+	DataInt    = 2,
+	DataDouble = 3,
+	DataBool   = 4,
+	DataObject = 5,
+	DataArray  = 6,
+};
+
+void util::SnapshotWriter::Write(const void* data, size_t size)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+void util::SnapshotWriter::WriteU8(uint8_t value)
+{
+	buffer.push_back(value);
+}
+
+void util::SnapshotWriter::WriteU32(uint32_t value)
+{
+	Write(&value, sizeof(value));
+}
+
+void util::SnapshotWriter::WriteI32(int32_t value)
+{
+	Write(&value, sizeof(value));
+}
+
+void util::SnapshotWriter::WriteI64(int64_t value)
+{
+	Write(&value, sizeof(value));
+}
+
+void util::SnapshotWriter::WriteF32(float value)
+{
+	Write(&value, sizeof(value));
+}
+
+void util::SnapshotWriter::WriteF64(double value)
+{
+	Write(&value, sizeof(value));
+}
+
+void util::SnapshotWriter::WriteString(const char* value)
+{
+	uint32_t length = value ? uint32_t(strlen(value)) : 0;
+	WriteU32(length);
+	Write(value, length);
+}
+
+void util::SnapshotWriter::WriteData(obs_data_t* data)
+{
+	size_t   countOffset = buffer.size();
+	uint32_t count       = 0;
+	WriteU32(0);
+
+	for (obs_data_item_t* item = data ? obs_data_first(data) : nullptr; item; obs_data_item_next(&item)) {
+		if (!obs_data_item_has_user_value(item))
+			continue;
+
+		WriteString(obs_data_item_get_name(item));
+		switch (obs_data_item_gettype(item)) {
+		case OBS_DATA_STRING:
+			WriteU8(DataString);
+			WriteString(obs_data_item_get_string(item));
+			break;
+		case OBS_DATA_NUMBER:
+			if (obs_data_item_numtype(item) == OBS_DATA_NUM_INT) {
+				WriteU8(DataInt);
+				WriteI64(obs_data_item_get_int(item));
+			} else {
+				WriteU8(DataDouble);
+				WriteF64(obs_data_item_get_double(item));
+			}
+			break;
+		case OBS_DATA_BOOLEAN:
+			WriteU8(DataBool);
+			WriteU8(obs_data_item_get_bool(item) ? 1 : 0);
+			break;
+		case OBS_DATA_OBJECT: {
+			obs_data_t* object = obs_data_item_get_obj(item);
+			WriteU8(DataObject);
+			WriteData(object);
+			obs_data_release(object);
+			break;
+		}
+		case OBS_DATA_ARRAY: {
+			obs_data_array_t* array = obs_data_item_get_array(item);
+			size_t            size  = obs_data_array_count(array);
+			WriteU8(DataArray);
+			WriteU32(uint32_t(size));
+			for (size_t idx = 0; idx < size; idx++) {
+				obs_data_t* object = obs_data_array_item(array, idx);
+				WriteData(object);
+				obs_data_release(object);
+			}
+			obs_data_array_release(array);
+			break;
+		}
+		default:
+			WriteU8(DataNull);
+			break;
+		}
+		count++;
+	}
+
+	memcpy(buffer.data() + countOffset, &count, sizeof(count));
+}
+
+size_t util::SnapshotWriter::BeginRecord(uint8_t type)
+{
+	WriteU8(type);
+	size_t offset = buffer.size();
+	WriteU32(0);
+	return offset;
+}
+
+void util::SnapshotWriter::EndRecord(size_t offset)
+{
+	uint32_t size = uint32_t(buffer.size() - offset - sizeof(uint32_t));
+	memcpy(buffer.data() + offset, &size, sizeof(size));
+}
+
+// Flushes the file's data to the disk, so a rename that lands after a power
+// loss never points at blocks that were not written yet.
+static bool SyncFile(FILE* file)
+{
+#ifdef _WIN32
+	return FlushFileBuffers(HANDLE(_get_osfhandle(_fileno(file)))) != FALSE;
+#else
+	return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool util::SnapshotWriter::WriteFile(const std::string& path) const
+{
+	std::string temporary = path + ".tmp";
+
+	FILE* file = os_fopen(temporary.c_str(), "wb");
+	if (!file)
+		return false;
+
+	bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+	written      = fflush(file) == 0 && SyncFile(file) && written;
+	fclose(file);
+
+	if (!written || os_safe_replace(path.c_str(), temporary.c_str(), nullptr) != 0) {
+		os_unlink(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool util::SnapshotReader::Read(void* data, size_t size)
+{
+	if (!ok || size_t(end - cur) < size) {
+		ok = false;
+		memset(data, 0, size);
+		return false;
+	}
+	memcpy(data, cur, size);
+	cur += size;
+	return true;
+}
+
+uint8_t util::SnapshotReader::ReadU8()
+{
+	uint8_t value;
+	Read(&value, sizeof(value));
+	return value;
+}
+
+uint32_t util::SnapshotReader::ReadU32()
+{
+	uint32_t value;
+	Read(&value, sizeof(value));
+	return value;
+}
+
+int32_t util::SnapshotReader::ReadI32()
+{
+	int32_t value;
+	Read(&value, sizeof(value));
+	return value;
+}
+
+int64_t util::SnapshotReader::ReadI64()
+{
+	int64_t value;
+	Read(&value, sizeof(value));
+	return value;
+}
+
+float util::SnapshotReader::ReadF32()
+{
+	float value;
+	Read(&value, sizeof(value));
+	return value;
+}
+
+double util::SnapshotReader::ReadF64()
+{
+	double value;
+	Read(&value, sizeof(value));
+	return value;
+}
+
+std::string util::SnapshotReader::ReadString()
+{
+	uint32_t length = ReadU32();
+	if (!ok || size_t(end - cur) < length) {
+		ok = false;
+		return std::string();
+	}
+	std::string value(reinterpret_cast<const char*>(cur), length);
+	cur += length;
+	return value;
+}
+
+obs_data_t* util::SnapshotReader::ReadData()
+{
+	obs_data_t* data = obs_data_create();
+	if (!ReadDataInto(data, 0)) {
+		obs_data_release(data);
+		return nullptr;
+	}
+	return data;
+}
+
+bool util::SnapshotReader::ReadDataInto(obs_data_t* data, uint32_t depth)
+{
+	if (depth > MaxDataDepth) {
+		ok = false;
+		return false;
+	}
+
+	uint32_t count = ReadU32();
+	for (uint32_t idx = 0; ok && idx < count; idx++) {
+		std::string name = ReadString();
+		switch (ReadU8()) {
+		case DataNull:
+			break;
+		case DataString:
+			obs_data_set_string(data, name.c_str(), ReadString().c_str());
+			break;
+		case DataInt:
+			obs_data_set_int(data, name.c_str(), ReadI64());
+			break;
+		case DataDouble:
+			obs_data_set_double(data, name.c_str(), ReadF64());
+			break;
+		case DataBool:
+			obs_data_set_bool(data, name.c_str(), ReadU8() != 0);
+			break;
+		case DataObject: {
+			obs_data_t* object = obs_data_create();
+			if (ReadDataInto(object, depth + 1))
+				obs_data_set_obj(data, name.c_str(), object);
+			obs_data_release(object);
+			break;
+		}
+		case DataArray: {
+			obs_data_array_t* array = obs_data_array_create();
+			uint32_t          size  = ReadU32();
+			for (uint32_t item = 0; ok && item < size; item++) {
+				obs_data_t* object = obs_data_create();
+				if (ReadDataInto(object, depth + 1))
+					obs_data_array_push_back(array, object);
+				obs_data_release(object);
+			}
+			obs_data_set_array(data, name.c_str(), array);
+			obs_data_array_release(array);
+			break;
+		}
+		default:
+			ok = false;
+			break;
+		}
+	}
+	return ok;
+}
+
+bool util::SnapshotReader::NextRecord(uint8_t& type, SnapshotReader& payload)
+{
+	type          = ReadU8();
+	uint32_t size = ReadU32();
+	if (!ok || size_t(end - cur) < size) {
+		ok = false;
+		return false;
+	}
+	payload = SnapshotReader(cur, size);
+	cur += size;
+	return true;
+}
+
+util::MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file && file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+#else
+	if (data)
+		munmap(const_cast<uint8_t*>(data), size);
+#endif
+}
+
+bool util::MappedFile::Open(const std::string& path)
+{
+#ifdef _WIN32
+	wchar_t* widePath = nullptr;
+	if (!os_utf8_to_wcs_ptr(path.c_str(), 0, &widePath))
+		return false;
+	file = CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	bfree(widePath);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		return false;
+
+	mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+		return false;
+	data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	size = size_t(fileSize.QuadPart);
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (view != MAP_FAILED) {
+			data = static_cast<const uint8_t*>(view);
+			size = size_t(st.st_size);
+		}
+	}
+	close(fd);
+#endif
+	return data != nullptr;
+}
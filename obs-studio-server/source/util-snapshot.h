@@ -0,0 +1,129 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <obs.h>
+
+namespace util
+{
+	// Little-endian binary encoding used by scene collection snapshots.
+	// Records are a type byte and a 32-bit payload size, so a reader can skip
+	// records it does not know. obs_data is stored as typed items, only values
+	// the user set are written, the same as obs_data_get_json.
+	class SnapshotWriter
+	{
+		public:
+		void WriteU8(uint8_t value);
+		void WriteU32(uint32_t value);
+		void WriteI32(int32_t value);
+		void WriteI64(int64_t value);
+		void WriteF32(float value);
+		void WriteF64(double value);
+		void WriteString(const char* value);
+		void WriteData(obs_data_t* data);
+
+		// Returns the offset EndRecord patches the payload size at.
+		size_t BeginRecord(uint8_t type);
+		void   EndRecord(size_t offset);
+
+		const std::vector<uint8_t>& GetBuffer() const
+		{
+			return buffer;
+		}
+
+		// Writes to a temporary file next to path, syncs it to disk and renames
+		// it over path, so a crash never leaves a truncated snapshot behind.
+		bool WriteFile(const std::string& path) const;
+
+		private:
+		void Write(const void* data, size_t size);
+
+		std::vector<uint8_t> buffer;
+	};
+
+	// Reads from a borrowed range. A read past the end, or of a malformed
+	// value, puts the reader in a failed state in which every read returns
+	// zero, so callers can check Ok() once per record.
+	class SnapshotReader
+	{
+		public:
+		SnapshotReader(const uint8_t* data, size_t size) : cur(data), end(data + size) {}
+
+		uint8_t     ReadU8();
+		uint32_t    ReadU32();
+		int32_t     ReadI32();
+		int64_t     ReadI64();
+		float       ReadF32();
+		double      ReadF64();
+		std::string ReadString();
+		// Caller releases the result, nullptr on failure.
+		obs_data_t* ReadData();
+
+		// Splits off the payload of the next record and skips past it.
+		bool NextRecord(uint8_t& type, SnapshotReader& payload);
+
+		bool Ok() const
+		{
+			return ok;
+		}
+		bool AtEnd() const
+		{
+			return cur == end;
+		}
+
+		private:
+		bool Read(void* data, size_t size);
+		bool ReadDataInto(obs_data_t* data, uint32_t depth);
+
+		const uint8_t* cur;
+		const uint8_t* end;
+		bool           ok = true;
+	};
+
+	// Read-only memory mapping of a whole file.
+	class MappedFile
+	{
+		public:
+		MappedFile() {}
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& path);
+
+		const uint8_t* Data() const
+		{
+			return data;
+		}
+		size_t Size() const
+		{
+			return size;
+		}
+
+		private:
+		const uint8_t* data = nullptr;
+		size_t         size = 0;
+#ifdef _WIN32
+		void* file    = nullptr;
+		void* mapping = nullptr;
+#endif
+	};
+} // namespace util
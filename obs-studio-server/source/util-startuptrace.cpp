@@ -0,0 +1,120 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-startuptrace.h"
+#include <algorithm>
+#include <fstream>
+#include <util/platform.h>
+
+#undef strtoll
+#include "nlohmann/json.hpp"
+
+// Nesting depth of the open scopes on the current thread.
+static thread_local uint32_t scopeDepth = 0;
+
+util::StartupTrace& util::StartupTrace::GetInstance()
+{
+	static StartupTrace instance;
+	return instance;
+}
+
+void util::StartupTrace::Begin()
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	events.clear();
+	threads.clear();
+	origin    = os_gettime_ns();
+	recording = true;
+}
+
+void util::StartupTrace::End()
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	recording = false;
+}
+
+std::vector<util::StartupTrace::Event> util::StartupTrace::GetEvents()
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	return events;
+}
+
+void util::StartupTrace::Record(Event&& event)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	if (!recording)
+		return;
+
+	event.start = event.start > origin ? event.start - origin : 0;
+
+	std::thread::id current = std::this_thread::get_id();
+	auto            thread  = std::find(threads.begin(), threads.end(), current);
+	event.thread            = uint32_t(thread - threads.begin());
+	if (thread == threads.end())
+		threads.push_back(current);
+
+	events.push_back(std::move(event));
+}
+
+std::string util::StartupTrace::ToChromeTrace()
+{
+	nlohmann::json trace;
+	trace["displayTimeUnit"] = "ms";
+	trace["traceEvents"]     = nlohmann::json::array();
+
+	for (const Event& event : GetEvents()) {
+		// Complete events, timestamps in microseconds
+		trace["traceEvents"].push_back({{"name", event.name},
+		                                {"cat", event.category},
+		                                {"ph", "X"},
+		                                {"ts", double(event.start) / 1000.0},
+		                                {"dur", double(event.duration) / 1000.0},
+		                                {"pid", 1},
+		                                {"tid", event.thread},
+		                                {"args", {{"depth", event.depth}}}});
+	}
+
+	return trace.dump();
+}
+
+bool util::StartupTrace::WriteChromeTrace(const std::string& path)
+{
+	std::ofstream file(path, std::ios_base::out | std::ios_base::trunc);
+	if (!file.is_open())
+		return false;
+
+	file << ToChromeTrace();
+	return file.good();
+}
+
+util::StartupTrace::Scope::Scope(const char* category, std::string name)
+    : category(category), name(std::move(name)), start(os_gettime_ns()), depth(scopeDepth++)
+{}
+
+util::StartupTrace::Scope::~Scope()
+{
+	scopeDepth--;
+
+	Event event;
+	event.name     = std::move(name);
+	event.category = std::move(category);
+	event.start    = start;
+	event.duration = os_gettime_ns() - start;
+	event.depth    = depth;
+	StartupTrace::GetInstance().Record(std::move(event));
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+	// Records nested, timed phases of server startup. Recording happens only
+	// between Begin() and End(), so scopes in code that also runs later (config
+	// loads, video resets) cost nothing once the server is up.
+	class StartupTrace
+	{
+		public:
+		struct Event
+		{
+			std::string name;
+			std::string category;
+			uint64_t    start; // ns since Begin()
+			uint64_t    duration;
+			uint32_t    depth;
+			uint32_t    thread; // index in order of first appearance
+		};
+
+		// Times the enclosing block as one phase, nested under any scope that is
+		// still open on the same thread.
+		class Scope
+		{
+			public:
+			Scope(const char* category, std::string name);
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+			private:
+			std::string category;
+			std::string name;
+			uint64_t    start;
+			uint32_t    depth;
+		};
+
+		// Consecutive phases of one function: each Next() closes the previous
+		// phase and opens a new one at the same depth.
+		class Phase
+		{
+			public:
+			Phase(const char* category) : category(category) {}
+			~Phase()
+			{
+				End();
+			}
+
+			void Next(std::string name)
+			{
+				scope.reset();
+				scope.reset(new Scope(category, std::move(name)));
+			}
+			void End()
+			{
+				scope.reset();
+			}
+
+			private:
+			const char*            category;
+			std::unique_ptr<Scope> scope;
+		};
+
+		static StartupTrace& GetInstance();
+
+		void Begin();
+		void End();
+
+		std::vector<Event> GetEvents();
+
+		// Chrome trace-event format, loadable in chrome://tracing or Perfetto.
+		std::string ToChromeTrace();
+		bool        WriteChromeTrace(const std::string& path);
+
+		private:
+		StartupTrace() = default;
+
+		void Record(Event&& event);
+
+		std::mutex         mtx;
+		bool               recording = false;
+		uint64_t           origin    = 0;
+		std::vector<Event> events;
+
+		std::vector<std::thread::id> threads;
+	};
+} // namespace util
@@ -0,0 +1,123 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "osn-volmeter-snapshot.hpp"
+
+// Contention benchmark for the volmeter sequence lock: one writer standing in
+// for the audio thread updates 64 meters, while a reader sweeps all of them
+// once per millisecond like a 1 kHz poller. Runs twice, once with the writer
+// storing back to back (worst case) and once with one store per meter every
+// 10 ms (an audio tick). Reports writer throughput and sweep latency, and
+// fails on any torn read.
+//
+// Usage: osn-server-bench-volmeter [seconds per phase]
+
+static const size_t Meters = 64;
+
+static uint64_t RunPhase(const char* name, double seconds, std::chrono::microseconds writeInterval)
+{
+	std::vector<osn::VolmeterSnapshot> snapshots(Meters);
+	std::atomic<bool>                  running{true};
+	uint64_t                           stores = 0;
+
+	// Every store writes one value to every field, a reader must never see two.
+	std::thread writer([&]() {
+		float levels[MAX_AUDIO_CHANNELS];
+		auto  next = std::chrono::steady_clock::now();
+		for (uint32_t round = 1; running.load(std::memory_order_relaxed); round++) {
+			float value = float(round & 0xfffff);
+			std::fill(levels, levels + MAX_AUDIO_CHANNELS, value);
+			for (auto& snapshot : snapshots)
+				snapshot.Store(std::chrono::milliseconds(round), int32_t(round & 0xfffff), levels, levels, levels);
+			stores += Meters;
+
+			if (writeInterval.count() != 0) {
+				next += writeInterval;
+				std::this_thread::sleep_until(next);
+			}
+		}
+	});
+
+	std::vector<double> latencies;
+	uint64_t            torn  = 0;
+	auto                start = std::chrono::steady_clock::now();
+	auto                end   = start + std::chrono::duration<double>(seconds);
+	auto                next  = start;
+
+	osn::VolmeterLevels data;
+	while (std::chrono::steady_clock::now() < end) {
+		auto begin = std::chrono::steady_clock::now();
+		for (auto& snapshot : snapshots) {
+			snapshot.Load(data);
+
+			float expected = float(data.ch);
+			if (data.lastUpdateTime.count() != 0 && (data.lastUpdateTime.count() & 0xfffff) != data.ch)
+				torn++;
+			for (size_t idx = 0; idx < MAX_AUDIO_CHANNELS; idx++) {
+				if (data.magnitude[idx] != expected || data.peak[idx] != expected
+				    || data.input_peak[idx] != expected)
+					torn++;
+			}
+		}
+		latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+
+		next += std::chrono::milliseconds(1);
+		std::this_thread::sleep_until(next);
+	}
+
+	running = false;
+	writer.join();
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](double p) {
+		return latencies.empty() ? 0.0 : latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))];
+	};
+
+	printf("%s\n", name);
+	printf("  writer stores:   %.0f /s\n", stores / elapsed);
+	printf("  reader sweeps:   %zu (%.0f /s)\n", latencies.size(), latencies.size() / elapsed);
+	printf(
+	    "  sweep latency:   p50 %.1f us, p99 %.1f us, max %.1f us\n",
+	    percentile(0.5),
+	    percentile(0.99),
+	    percentile(1.0));
+	printf("  torn reads:      %llu\n", (unsigned long long)torn);
+	return torn;
+}
+
+int main(int argc, char* argv[])
+{
+	double seconds = argc > 1 ? atof(argv[1]) : 1.0;
+	if (seconds <= 0)
+		seconds = 1.0;
+
+	printf("%zu meters, %u hardware threads\n", Meters, std::thread::hardware_concurrency());
+
+	uint64_t torn = RunPhase("saturated writer", seconds, std::chrono::microseconds(0));
+	torn += RunPhase("audio-rate writer (10 ms)", seconds, std::chrono::microseconds(10000));
+
+	return torn == 0 ? 0 : 1;
+}
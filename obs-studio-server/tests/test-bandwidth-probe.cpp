@@ -0,0 +1,159 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include <cstdio>
+#include "util-bandwidthprobe.h"
+#include "test-check.h"
+
+// Feeds the bandwidth probe's rules with synthetic byte counter series, read
+// every 500 ms the way BandwidthProbe::Evaluate does.
+
+static const uint64_t INTERVAL_NS = 500000000ULL;
+
+// Bytes sent during one interval at the given throughput.
+static uint64_t Bytes(uint64_t kbps)
+{
+	return kbps * 1000 / 8 / 2;
+}
+
+// Runs readings until the sampler is done or 'limit' readings were taken,
+// the throughput of reading n is rate(n). Returns the readings taken.
+template<typename Rate>
+static size_t Run(util::ThroughputSampler& sampler, Rate rate, size_t limit = 100)
+{
+	uint64_t bytes = 0, time = 0;
+	for (size_t n = 0; n < limit; n++) {
+		bytes += Bytes(rate(n));
+		time += INTERVAL_NS;
+		if (sampler.Add(bytes, time))
+			return n + 1;
+	}
+	return limit;
+}
+
+static void TestEarlyStop()
+{
+	// A steady stream settles as soon as there are enough samples.
+	util::ThroughputSampler sampler;
+	size_t readings = Run(sampler, [](size_t n) { return n % 2 ? 2525 : 2475; });
+	CHECK(readings == util::ThroughputSampler::WarmupReadings + util::ThroughputSampler::MinSamples);
+	CHECK(sampler.Samples().size() == util::ThroughputSampler::MinSamples);
+	CHECK(sampler.Kbps() >= 2475 && sampler.Kbps() <= 2525);
+}
+
+static void TestWarmup()
+{
+	// The connection burst before the window opens does not count.
+	util::ThroughputSampler sampler;
+	Run(sampler, [](size_t n) { return n < 2 ? 50000 : 3000; });
+	CHECK(sampler.Kbps() == 3000);
+	for (double kbps : sampler.Samples())
+		CHECK(kbps == 3000);
+}
+
+static void TestCap()
+{
+	// A throughput that never settles is measured for 10 seconds, then stops.
+	util::ThroughputSampler sampler;
+	size_t readings = Run(sampler, [](size_t n) { return n % 2 ? 4000 : 1000; });
+	CHECK(readings == util::ThroughputSampler::WarmupReadings + 20);
+	CHECK(sampler.Samples().size() == 20);
+	CHECK(sampler.Kbps() == 2500);
+}
+
+static void TestConfidence()
+{
+	CHECK(!util::ThroughputSampler::Converged({}));
+	CHECK(!util::ThroughputSampler::Converged({2500}));
+	CHECK(util::ThroughputSampler::Converged({2500, 2500, 2500, 2500, 2500, 2500}));
+
+	// Mean 1000, standard deviation 100 over six samples: the interval spans
+	// 1.96 * 100 / sqrt(6) = 80 kbps, more than 5% of the mean.
+	CHECK(!util::ThroughputSampler::Converged({900, 1100, 900, 1100, 900, 1100}));
+	// The same spread over 24 samples spans 40 kbps, within 5%.
+	std::vector<double> samples;
+	for (size_t n = 0; n < 24; n++)
+		samples.push_back(n % 2 ? 1100 : 900);
+	CHECK(util::ThroughputSampler::Converged(samples));
+}
+
+static void TestStalledClock()
+{
+	// Readings without time passing add no sample.
+	util::ThroughputSampler sampler;
+	CHECK(!sampler.Add(0, INTERVAL_NS));
+	CHECK(!sampler.Add(Bytes(2500), 2 * INTERVAL_NS));
+	CHECK(!sampler.Add(Bytes(2500) * 2, 2 * INTERVAL_NS));
+	CHECK(sampler.Samples().empty());
+	CHECK(sampler.Kbps() == 0);
+}
+
+static void TestConcurrency()
+{
+	CHECK(util::ProbeConcurrency(0, 10) == 3);
+	CHECK(util::ProbeConcurrency(1, 10) == 1);
+	CHECK(util::ProbeConcurrency(2, 10) == 2);
+	CHECK(util::ProbeConcurrency(4, 10) == 4);
+	CHECK(util::ProbeConcurrency(9, 10) == 4);
+	CHECK(util::ProbeConcurrency(4, 2) == 2);
+	CHECK(util::ProbeConcurrency(0, 1) == 1);
+}
+
+static void TestBitrate()
+{
+	CHECK(util::ProbeBitrate(2600, false, 2500) == 2500);
+	CHECK(util::ProbeBitrate(1875, false, 2500) == 2500);
+	CHECK(util::ProbeBitrate(1800, false, 2500) == 1260);
+	CHECK(util::ProbeBitrate(2600, true, 2500) == 1820);
+}
+
+static void TestRanking()
+{
+	std::vector<util::ProbeResult> results(4);
+	CHECK(util::PickBestProbe(results) == results.size());
+
+	// Untested servers never win.
+	results[0] = {6000, -1};
+	results[1] = {2000, 80};
+	CHECK(util::PickBestProbe(results) == 1);
+
+	// More throughput wins when the gap is 400 kbps or more.
+	results[2] = {2400, 120};
+	CHECK(util::PickBestProbe(results) == 2);
+
+	// Within 400 kbps the faster connect wins.
+	results[3] = {2100, 40};
+	CHECK(util::PickBestProbe(results) == 3);
+	results[3] = {2100, 200};
+	CHECK(util::PickBestProbe(results) == 2);
+}
+
+int main()
+{
+	TestEarlyStop();
+	TestWarmup();
+	TestCap();
+	TestConfidence();
+	TestStalledClock();
+	TestConcurrency();
+	TestBitrate();
+	TestRanking();
+
+	return CheckResult();
+}
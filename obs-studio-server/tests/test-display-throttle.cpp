@@ -0,0 +1,123 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include <cstdio>
+#include "util-displaythrottle.h"
+#include "test-check.h"
+
+// Drives the throttle with synthetic tick times, the way the video thread
+// calls it for OBS_content_setDisplayMaxFPS/setDisplayHidden, and checks the
+// counters getDisplayRenderStats reports.
+
+static const uint64_t FRAME_NS = 1000000000ULL / 60;
+static const float    FRAME_S  = 1.0f / 60.0f;
+
+// Runs 'ticks' output frames of a 60 fps canvas starting at 'start', with the
+// given jitter pattern added to every other tick. Returns the drawn frames and
+// counts them like the display callback does.
+static uint64_t Run(util::DisplayThrottle& throttle, uint64_t& now, int ticks, int64_t jitter = 0)
+{
+	uint64_t drawn = 0;
+	for (int i = 0; i < ticks; i++) {
+		uint64_t at = now + uint64_t((i & 1) ? jitter : -jitter);
+		if (throttle.Tick(at, FRAME_S)) {
+			throttle.CountRendered();
+			drawn++;
+		}
+		now += FRAME_NS;
+	}
+	return drawn;
+}
+
+static void TestUncapped()
+{
+	util::DisplayThrottle throttle(960, 540);
+	uint64_t              now = 1000000000ULL;
+
+	CHECK(Run(throttle, now, 60) == 60);
+	CHECK(throttle.GetStats().first == 60);
+	CHECK(throttle.GetStats().second == 0);
+}
+
+static void TestMaxFPS()
+{
+	util::DisplayThrottle throttle(960, 540);
+	uint64_t              now = 1000000000ULL;
+
+	throttle.SetMaxFPS(30);
+	CHECK(throttle.GetMaxFPS() == 30);
+	CHECK(Run(throttle, now, 60) == 30);
+
+	// A millisecond of jitter must not turn half the rate into a third.
+	CHECK(Run(throttle, now, 60, 1000000) == 30);
+
+	throttle.SetMaxFPS(20);
+	CHECK(Run(throttle, now, 60) == 20);
+
+	// A cap above the output rate draws every frame.
+	throttle.SetMaxFPS(120);
+	CHECK(Run(throttle, now, 60) == 60);
+
+	auto stats = throttle.GetStats();
+	CHECK(stats.first == 30 + 30 + 20 + 60);
+	CHECK(stats.first + stats.second == 240);
+}
+
+static void TestHidden()
+{
+	util::DisplayThrottle throttle(960, 540);
+	uint64_t              now = 1000000000ULL;
+
+	throttle.SetHidden(true);
+	CHECK(throttle.GetHidden());
+	CHECK(Run(throttle, now, 60) == 0);
+	CHECK(throttle.GetStats().first == 0);
+	CHECK(throttle.GetStats().second == 60);
+
+	throttle.SetHidden(false);
+	CHECK(Run(throttle, now, 60) == 60);
+	CHECK(throttle.GetStats().second == 60);
+}
+
+static void TestZeroSize()
+{
+	util::DisplayThrottle throttle(960, 540);
+	uint64_t              now = 1000000000ULL;
+
+	throttle.SetSize(0, 540);
+	CHECK(Run(throttle, now, 10) == 0);
+	throttle.SetSize(960, 0);
+	CHECK(Run(throttle, now, 10) == 0);
+	throttle.SetSize(320, 180);
+	CHECK(Run(throttle, now, 10) == 10);
+
+	// The display callback can still see an empty swap chain.
+	throttle.CountSkipped();
+	CHECK(throttle.GetStats().second == 21);
+}
+
+int main()
+{
+	TestUncapped();
+	TestMaxFPS();
+	TestHidden();
+	TestZeroSize();
+
+	return CheckResult();
+}
@@ -0,0 +1,198 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include <cmath>
+#include <cstdio>
+#include "gs-overlay.h"
+#include "test-check.h"
+
+// Builds the selection overlay of one item the way DrawSelectedSource does
+// and compares the vertex streams, without a graphics device.
+
+static const uint32_t OUTLINE   = 0xFFFF0000;
+static const uint32_t FILL      = 0xFFFFFFFF;
+static const uint32_t BORDER    = 0xFF00FF00;
+static const uint32_t GUIDELINE = 0xFF0000FF;
+
+static bool Near(float_t a, float_t b)
+{
+	return std::fabs(a - b) < 1e-3f;
+}
+
+static bool Position(const vec3& v, float_t x, float_t y)
+{
+	return Near(v.x, x) && Near(v.y, y) && Near(v.z, 0);
+}
+
+static bool AllColored(const GS::OverlayVertices& vertices, size_t first, size_t count, uint32_t color)
+{
+	for (size_t n = first; n < first + count; n++) {
+		if (vertices.colors[n] != color)
+			return false;
+	}
+	return true;
+}
+
+// A 200x100 item at (100, 50): the unit square maps to (100..300, 50..150).
+static void ItemTransform(matrix4& mtx)
+{
+	vec4_set(&mtx.x, 200, 0, 0, 0);
+	vec4_set(&mtx.y, 0, 100, 0, 0);
+	vec4_set(&mtx.z, 0, 0, 1, 0);
+	vec4_set(&mtx.t, 100, 50, 0, 1);
+}
+
+static void BuildItem(GS::OverlayBatch& batch)
+{
+	matrix4 mtx;
+	ItemTransform(mtx);
+
+	vec2 size;
+	size.x = 8;
+	size.y = 8;
+
+	batch.AddOutline(mtx, OUTLINE);
+
+	const float_t handles[8][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {0.5, 0}, {0.5, 1}, {0, 0.5}, {1, 0.5}};
+	for (size_t n = 0; n < 8; n++)
+		batch.AddHandle(handles[n][0], handles[n][1], mtx, size, FILL, BORDER);
+
+	batch.AddGuideline(0.5, 0, mtx, GUIDELINE);
+	batch.AddGuideline(0.5, 1, mtx, GUIDELINE);
+	batch.AddGuideline(0, 0.5, mtx, GUIDELINE);
+	batch.AddGuideline(1, 0.5, mtx, GUIDELINE);
+}
+
+static void TestOutline()
+{
+	GS::OverlayBatch batch;
+	BuildItem(batch);
+
+	// Four segments closing the box, ahead of the handle borders.
+	const GS::OverlayVertices& lines = batch.GetLines();
+	CHECK(lines.Size() == 8 + 8 * 8);
+	CHECK(lines.colors.size() == lines.Size());
+	if (lines.Size() != 72)
+		return;
+
+	const float_t corners[5][2] = {{100, 50}, {300, 50}, {300, 150}, {100, 150}, {100, 50}};
+	for (size_t n = 0; n < 4; n++) {
+		CHECK(Position(lines.positions[n * 2], corners[n][0], corners[n][1]));
+		CHECK(Position(lines.positions[n * 2 + 1], corners[n + 1][0], corners[n + 1][1]));
+	}
+	CHECK(AllColored(lines, 0, 8, OUTLINE));
+	CHECK(AllColored(lines, 8, 64, BORDER));
+}
+
+static void TestHandles()
+{
+	GS::OverlayBatch batch;
+	BuildItem(batch);
+
+	// Two triangles per handle, all in the fill color.
+	const GS::OverlayVertices& tris = batch.GetTriangles();
+	CHECK(tris.Size() == 8 * 6);
+	CHECK(AllColored(tris, 0, tris.Size(), FILL));
+	if (tris.Size() != 48)
+		return;
+
+	const float_t centers[8][2] = {
+	    {100, 50}, {300, 50}, {100, 150}, {300, 150}, {200, 50}, {200, 150}, {100, 100}, {300, 100}};
+	for (size_t n = 0; n < 8; n++) {
+		float_t l = centers[n][0] - 4, r = centers[n][0] + 4;
+		float_t t = centers[n][1] - 4, b = centers[n][1] + 4;
+
+		const vec3* quad = &tris.positions[n * 6];
+		CHECK(Position(quad[0], l, t));
+		CHECK(Position(quad[1], r, t));
+		CHECK(Position(quad[2], l, b));
+		CHECK(Position(quad[3], r, t));
+		CHECK(Position(quad[4], l, b));
+		CHECK(Position(quad[5], r, b));
+
+		// The border follows the same corners.
+		const vec3* border = &batch.GetLines().positions[8 + n * 8];
+		CHECK(Position(border[0], l, t));
+		CHECK(Position(border[1], r, t));
+		CHECK(Position(border[3], r, b));
+		CHECK(Position(border[5], l, b));
+		CHECK(Position(border[7], l, t));
+	}
+}
+
+static void TestGuidelines()
+{
+	GS::OverlayBatch batch;
+	BuildItem(batch);
+
+	// Each guideline leaves its edge midpoint away from the center.
+	const GS::OverlayVertices& guides = batch.GetGuidelines();
+	CHECK(guides.Size() == 4 * 2);
+	CHECK(AllColored(guides, 0, guides.Size(), GUIDELINE));
+	if (guides.Size() != 8)
+		return;
+
+	CHECK(Position(guides.positions[0], 200, 50));
+	CHECK(Position(guides.positions[1], 200, 50 - 65535.0f));
+	CHECK(Position(guides.positions[2], 200, 150));
+	CHECK(Position(guides.positions[3], 200, 150 + 65535.0f));
+	CHECK(Position(guides.positions[4], 100, 100));
+	CHECK(Position(guides.positions[5], 100 - 65535.0f, 100));
+	CHECK(Position(guides.positions[6], 300, 100));
+	CHECK(Position(guides.positions[7], 300 + 65535.0f, 100));
+}
+
+static void TestDraws()
+{
+	GS::OverlayBatch batch;
+	CHECK(batch.Empty());
+	CHECK(batch.GetLines().Draws(8190) == 0);
+
+	// One item: one draw per stream.
+	BuildItem(batch);
+	CHECK(!batch.Empty());
+	CHECK(batch.GetTriangles().Draws(8190) == 1);
+	CHECK(batch.GetLines().Draws(8190) == 1);
+	CHECK(batch.GetGuidelines().Draws(8190) == 1);
+
+	// 200 items still fit each stream into a couple of draws.
+	for (size_t n = 1; n < 200; n++)
+		BuildItem(batch);
+	CHECK(batch.GetTriangles().Size() == 200 * 48);
+	CHECK(batch.GetTriangles().Draws(8190) == 2);
+	CHECK(batch.GetLines().Draws(8190) == 2);
+	CHECK(batch.GetGuidelines().Draws(8190) == 1);
+
+	// Splits exactly on the buffer capacity.
+	CHECK(batch.GetGuidelines().Draws(1600) == 1);
+	CHECK(batch.GetGuidelines().Draws(1599) == 2);
+
+	batch.Clear();
+	CHECK(batch.Empty());
+}
+
+int main()
+{
+	TestOutline();
+	TestHandles();
+	TestGuidelines();
+	TestDraws();
+
+	return CheckResult();
+}
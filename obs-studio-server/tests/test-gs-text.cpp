@@ -0,0 +1,156 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include "gs-text.h"
+#include "test-check.h"
+
+// The glyph geometry never touches the graphics subsystem, so it is checked
+// here without a device.
+
+static bool Near(float_t a, float_t b)
+{
+	return std::fabs(a - b) < 1e-5f;
+}
+
+static bool Position(const vec3& v, float_t x, float_t y)
+{
+	return Near(v.x, x) && Near(v.y, y) && Near(v.z, 0);
+}
+
+static bool UV(const vec4& v, float_t u, float_t w)
+{
+	return Near(v.x, u) && Near(v.y, w);
+}
+
+static void TestRunLayout()
+{
+	GS::TextRun run;
+	GS::TextRunCache::BuildRun("12 px", 10, run);
+
+	// Four glyphs, the blank only advances.
+	CHECK(run.length == 5);
+	CHECK(run.positions.size() == 4 * 6);
+	CHECK(run.uvs.size() == run.positions.size());
+	if (run.positions.size() != 24)
+		return;
+
+	// "1": two triangles covering (0, 0) - (10, 20).
+	CHECK(Position(run.positions[0], 0, 0));
+	CHECK(Position(run.positions[1], 10, 0));
+	CHECK(Position(run.positions[2], 0, 20));
+	CHECK(Position(run.positions[3], 10, 0));
+	CHECK(Position(run.positions[4], 0, 20));
+	CHECK(Position(run.positions[5], 10, 20));
+
+	// "2" follows directly.
+	CHECK(Position(run.positions[6], 10, 0));
+	CHECK(Position(run.positions[11], 20, 20));
+
+	// "p" starts after the blank, at the fourth advance.
+	CHECK(Position(run.positions[12], 30, 0));
+	CHECK(Position(run.positions[17], 40, 20));
+
+	// "x" ends the run.
+	CHECK(Position(run.positions[18], 40, 0));
+	CHECK(Position(run.positions[23], 50, 20));
+}
+
+static void TestRunUVs()
+{
+	GS::TextRun run;
+	GS::TextRunCache::BuildRun("10px", 4, run);
+	CHECK(run.uvs.size() == 4 * 6);
+	if (run.uvs.size() != 24)
+		return;
+
+	// "1" is the first cell of the 4x4 atlas.
+	CHECK(UV(run.uvs[0], 0, 0));
+	CHECK(UV(run.uvs[5], 0.25f, 0.25f));
+
+	// "0" is the tenth cell: column 1, row 2.
+	CHECK(UV(run.uvs[6], 0.25f, 0.5f));
+	CHECK(UV(run.uvs[11], 0.5f, 0.75f));
+
+	// "p" and "x" follow it on the same row.
+	CHECK(UV(run.uvs[12], 0.5f, 0.5f));
+	CHECK(UV(run.uvs[18], 0.75f, 0.5f));
+	CHECK(UV(run.uvs[23], 1.0f, 0.75f));
+}
+
+static void TestMissingGlyphs()
+{
+	GS::TextRun run;
+	GS::TextRunCache::BuildRun("a-z", 8, run);
+	CHECK(run.length == 3);
+	CHECK(run.positions.empty());
+	CHECK(run.uvs.empty());
+
+	GS::TextRunCache::BuildRun("", 8, run);
+	CHECK(run.length == 0);
+	CHECK(run.positions.empty());
+}
+
+static void TestCache()
+{
+	GS::TextRunCache cache(2);
+
+	const GS::TextRun& first = cache.GetDistanceLabel(1920, 8);
+	CHECK(&cache.GetDistanceLabel(1920, 8) == &first);
+	CHECK(cache.Size() == 1);
+
+	// "1920 px": six glyphs and a blank.
+	CHECK(first.length == 7);
+	CHECK(first.positions.size() == 6 * 6);
+
+	cache.GetDistanceLabel(1920, 16);
+	cache.GetDistanceLabel(1080, 8);
+	CHECK(cache.Size() == 3);
+
+	cache.Trim();
+	CHECK(cache.Size() == 0);
+
+	cache.GetDistanceLabel(1, 8);
+	cache.Trim();
+	CHECK(cache.Size() == 1);
+
+	cache.Clear();
+	CHECK(cache.Size() == 0);
+}
+
+static void TestLabels()
+{
+	GS::TextLabel a = {100, 8, 1, 2};
+	GS::TextLabel b = a;
+	CHECK(a == b);
+
+	b.x = 3;
+	CHECK(a != b);
+}
+
+int main()
+{
+	TestRunLayout();
+	TestRunUVs();
+	TestMissingGlyphs();
+	TestCache();
+	TestLabels();
+
+	return CheckResult();
+}
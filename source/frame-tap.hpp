@@ -0,0 +1,197 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A frame tap publishes downscaled BGRA frames of one render mode into a
+// shared memory ring. The server writes it, the client maps it read-only and
+// hands out views on it, so frames never travel over IPC.
+namespace frametap
+{
+	constexpr uint32_t Magic     = 0x5446534f; // "OSFT"
+	constexpr uint32_t Version   = 1;
+	constexpr uint32_t SlotCount = 3;
+
+	struct Slot
+	{
+		// Sequence number of the frame in the slot, 0 while it is being written.
+		std::atomic<uint64_t> sequence;
+		uint64_t              timestamp;
+	};
+
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t width;
+		uint32_t height;
+		uint32_t stride;
+		uint32_t slotCount;
+		uint64_t frameSize;
+
+		// Sequence number of the last complete frame, 0 until the first one.
+		std::atomic<uint64_t> latest;
+		Slot                  slots[SlotCount];
+	};
+
+	// Frames start on a cache line after the header, frame i of the ring at
+	// FramesOffset + i * frameSize.
+	constexpr size_t FramesOffset = (sizeof(Header) + 63) & ~size_t(63);
+
+	inline size_t MappingSize(uint32_t stride, uint32_t height)
+	{
+		return FramesOffset + size_t(SlotCount) * stride * height;
+	}
+
+	inline uint32_t SlotIndex(uint64_t sequence)
+	{
+		return uint32_t(sequence % SlotCount);
+	}
+
+	// Short on purpose, macOS limits shared memory names to 31 characters.
+	inline std::string SharedMemoryName(uint64_t pid, uint32_t id)
+	{
+#ifdef _WIN32
+		return "Local\\osn-frametap-" + std::to_string(pid) + "-" + std::to_string(id);
+#else
+		return "/osnft." + std::to_string(pid) + "." + std::to_string(id);
+#endif
+	}
+
+	class SharedMemory
+	{
+		public:
+		SharedMemory() {}
+		SharedMemory(const SharedMemory&) = delete;
+		SharedMemory& operator=(const SharedMemory&) = delete;
+		~SharedMemory()
+		{
+			Close();
+		}
+
+		// Server side, creates a zeroed mapping of the given size.
+		bool Create(const std::string& name, size_t size)
+		{
+#ifdef _WIN32
+			m_handle = CreateFileMappingA(
+			    INVALID_HANDLE_VALUE,
+			    nullptr,
+			    PAGE_READWRITE,
+			    DWORD(uint64_t(size) >> 32),
+			    DWORD(size & 0xFFFFFFFF),
+			    name.c_str());
+			if (!m_handle)
+				return false;
+			m_data = MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+#else
+			int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd < 0)
+				return false;
+			m_name = name;
+			if (ftruncate(fd, off_t(size)) == 0)
+				m_data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			close(fd);
+			if (m_data == MAP_FAILED)
+				m_data = nullptr;
+#endif
+			m_size = size;
+			return m_data != nullptr;
+		}
+
+		// Client side, maps an existing ring. The client never writes to it, but
+		// the mapping is writable so a stray write through a JavaScript view
+		// corrupts a frame instead of faulting.
+		bool Open(const std::string& name)
+		{
+#ifdef _WIN32
+			m_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+			if (!m_handle)
+				return false;
+			m_data = MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+			if (m_data) {
+				MEMORY_BASIC_INFORMATION info;
+				if (VirtualQuery(m_data, &info, sizeof(info)))
+					m_size = info.RegionSize;
+			}
+#else
+			int fd = shm_open(name.c_str(), O_RDWR, 0);
+			if (fd < 0)
+				return false;
+			struct stat st;
+			if (fstat(fd, &st) == 0 && st.st_size > 0) {
+				m_size = size_t(st.st_size);
+				m_data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			}
+			close(fd);
+			if (m_data == MAP_FAILED)
+				m_data = nullptr;
+#endif
+			return m_data != nullptr;
+		}
+
+		void Close()
+		{
+#ifdef _WIN32
+			if (m_data)
+				UnmapViewOfFile(m_data);
+			if (m_handle)
+				CloseHandle(m_handle);
+			m_handle = nullptr;
+#else
+			if (m_data)
+				munmap(m_data, m_size);
+			// Only the creator unlinks, open mappings stay valid until unmapped.
+			if (!m_name.empty())
+				shm_unlink(m_name.c_str());
+			m_name.clear();
+#endif
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		void* Data() const
+		{
+			return m_data;
+		}
+
+		size_t Size() const
+		{
+			return m_size;
+		}
+
+		private:
+		void*  m_data = nullptr;
+		size_t m_size = 0;
+#ifdef _WIN32
+		HANDLE m_handle = nullptr;
+#else
+		std::string m_name;
+#endif
+	};
+} // namespace frametap
@@ -0,0 +1,208 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <ipc-function.hpp>
+#include <ipc-value.hpp>
+
+// Shared description of the functions the server exposes. Both sides build
+// against this header: the server registers its handlers from these entries
+// and the client calls through them, so a name or argument type can only
+// change in one place, and argument types are checked when the client is
+// compiled. Every entry also carries a stable 32-bit id derived from its
+// collection and function name, and the ids and signatures of all entries
+// are folded into a digest the client compares with the server's on connect.
+namespace ipc_registry
+{
+	constexpr uint32_t hash(const char* str, uint32_t seed = 2166136261u)
+	{
+		return *str ? hash(str + 1, (seed ^ uint32_t(uint8_t(*str))) * 16777619u) : seed;
+	}
+
+	constexpr uint32_t make_id(const char* collection, const char* function)
+	{
+		return hash(function, hash("::", hash(collection)));
+	}
+
+	template<ipc::type... Args>
+	struct function
+	{
+		const char* collection;
+		const char* name;
+		uint32_t    id;
+
+		constexpr function(const char* collection, const char* name)
+		    : collection(collection), name(name), id(make_id(collection, name))
+		{}
+
+		constexpr uint32_t signature() const
+		{
+			uint32_t value = id;
+			((value = (value ^ uint32_t(Args)) * 16777619u), ...);
+			return (value ^ uint32_t(sizeof...(Args))) * 16777619u;
+		}
+
+		static std::vector<ipc::type> arguments()
+		{
+			return {Args...};
+		}
+	};
+
+	// Which C++ types may be passed for an argument declared with a given ipc::type.
+	template<ipc::type Type, typename T>
+	struct accepts : std::false_type
+	{};
+	template<>
+	struct accepts<ipc::type::Int32, int32_t> : std::true_type
+	{};
+	template<>
+	struct accepts<ipc::type::UInt32, uint32_t> : std::true_type
+	{};
+	template<>
+	struct accepts<ipc::type::Int64, int64_t> : std::true_type
+	{};
+	template<>
+	struct accepts<ipc::type::UInt64, uint64_t> : std::true_type
+	{};
+	template<>
+	struct accepts<ipc::type::Float, float> : std::true_type
+	{};
+	template<>
+	struct accepts<ipc::type::Double, double> : std::true_type
+	{};
+	template<>
+	struct accepts<ipc::type::String, std::string> : std::true_type
+	{};
+	template<>
+	struct accepts<ipc::type::Binary, std::vector<char>> : std::true_type
+	{};
+
+	template<ipc::type... Args, typename... T>
+	std::vector<ipc::value> arguments(const function<Args...>&, T&&... args)
+	{
+		static_assert(sizeof...(Args) == sizeof...(T), "Argument count does not match the IPC registry.");
+		static_assert(
+		    (accepts<Args, std::decay_t<T>>::value && ...), "Argument type does not match the IPC registry.");
+		return {ipc::value(std::forward<T>(args))...};
+	}
+
+	// Server side: build the ipc::function for an entry.
+	template<ipc::type... Args, typename Handler>
+	std::shared_ptr<ipc::function> make_function(const function<Args...>& fn, Handler handler, void* data = nullptr)
+	{
+		return std::make_shared<ipc::function>(fn.name, function<Args...>::arguments(), handler, data);
+	}
+
+	// Client side: synchronous and fire-and-forget calls through an entry.
+	template<typename Client, ipc::type... Args, typename... T>
+	std::vector<ipc::value> call_synchronous(Client& conn, const function<Args...>& fn, T&&... args)
+	{
+		return conn->call_synchronous_helper(fn.collection, fn.name, arguments(fn, std::forward<T>(args)...));
+	}
+
+	template<typename Client, ipc::type... Args, typename... T>
+	void call(Client& conn, const function<Args...>& fn, T&&... args)
+	{
+		conn->call(fn.collection, fn.name, arguments(fn, std::forward<T>(args)...));
+	}
+
+	namespace System
+	{
+		constexpr const char* Name = "System";
+
+		constexpr function<> Shutdown{Name, "Shutdown"};
+		constexpr function<> GetRegistryDigest{Name, "GetRegistryDigest"};
+	} // namespace System
+
+	namespace Global
+	{
+		constexpr const char* Name = "Global";
+
+		constexpr function<ipc::type::UInt32>                    GetOutputSource{Name, "GetOutputSource"};
+		constexpr function<ipc::type::UInt32, ipc::type::UInt64> SetOutputSource{Name, "SetOutputSource"};
+		constexpr function<ipc::type::String>                    GetOutputFlagsFromId{Name, "GetOutputFlagsFromId"};
+		constexpr function<>                                     GetTypeCatalog{Name, "GetTypeCatalog"};
+		constexpr function<>                                     LaggedFrames{Name, "LaggedFrames"};
+		constexpr function<>                                     TotalFrames{Name, "TotalFrames"};
+		constexpr function<>                                     GetLocale{Name, "GetLocale"};
+		constexpr function<ipc::type::String>                    SetLocale{Name, "SetLocale"};
+		constexpr function<>                                     GetMultipleRendering{Name, "GetMultipleRendering"};
+		constexpr function<ipc::type::Int32>                     SetMultipleRendering{Name, "SetMultipleRendering"};
+	} // namespace Global
+
+	namespace Collection
+	{
+		constexpr const char* Name = "Collection";
+
+		constexpr function<ipc::type::String> Save{Name, "Save"};
+		constexpr function<ipc::type::String> Load{Name, "Load"};
+		constexpr function<ipc::type::String> ExportJSON{Name, "ExportJSON"};
+	} // namespace Collection
+
+	namespace Input
+	{
+		constexpr const char* Name = "Input";
+
+		// type, name, settings hash, settings length, settings (empty to refer
+		// to a blob the server already holds), hash of the settings the caller
+		// already holds from an earlier create, hotkeys.
+		constexpr function<
+		    ipc::type::String,
+		    ipc::type::String,
+		    ipc::type::UInt64,
+		    ipc::type::UInt64,
+		    ipc::type::String,
+		    ipc::type::UInt64,
+		    ipc::type::String>
+		    CreateInterned{Name, "CreateInterned"};
+	} // namespace Input
+
+	template<typename... Functions>
+	constexpr uint32_t digest_of(const Functions&... functions)
+	{
+		uint32_t value = 2166136261u;
+		((value = (value ^ functions.signature()) * 16777619u), ...);
+		return value;
+	}
+
+	// Add new entries here as well, the digest only covers what is listed.
+	constexpr uint32_t digest = digest_of(
+	    System::Shutdown,
+	    System::GetRegistryDigest,
+	    Global::GetOutputSource,
+	    Global::SetOutputSource,
+	    Global::GetOutputFlagsFromId,
+	    Global::GetTypeCatalog,
+	    Global::LaggedFrames,
+	    Global::TotalFrames,
+	    Global::GetLocale,
+	    Global::SetLocale,
+	    Global::GetMultipleRendering,
+	    Global::SetMultipleRendering,
+	    Collection::Save,
+	    Collection::Load,
+	    Collection::ExportJSON,
+	    Input::CreateInterned);
+} // namespace ipc_registry
@@ -0,0 +1,40 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <string>
+
+// The client creates a readiness object before spawning the server, and the
+// server signals it as soon as its IPC socket accepts connections. This lets
+// the client connect the moment the server is up instead of polling.
+namespace readiness
+{
+	// POSIX: the write end of a pipe inherited by the server. The server writes
+	// a single byte once it listens; EOF without that byte means it died.
+	constexpr const char* FdEnvironmentVariable = "OSN_READY_FD";
+
+	// Windows: a manual-reset named event derived from the socket name the
+	// server is started with.
+	inline std::string EventName(const std::string& uri)
+	{
+		std::string name = "Local\\osn-ready-";
+		for (char c : uri)
+			name += (c == '\\' || c == '/') ? '_' : c;
+		return name;
+	}
+} // namespace readiness
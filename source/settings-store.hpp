@@ -0,0 +1,156 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Settings blobs interned by content. Collections often hold many sources
+// with the same settings JSON, so each side keeps one copy per distinct blob
+// and the create path refers to a blob by its content hash once the server
+// has seen it.
+namespace settings_store
+{
+	// Entries kept by the bounded caches on either side of the connection.
+	constexpr size_t Capacity = 256;
+
+	using blob_t = std::shared_ptr<const std::string>;
+
+	// 64-bit FNV-1a. 0 is reserved for "no settings".
+	inline uint64_t hash(const std::string& blob, uint64_t seed = 14695981039346656037ull)
+	{
+		uint64_t value = seed;
+		for (char ch : blob)
+			value = (value ^ uint64_t(uint8_t(ch))) * 1099511628211ull;
+		return value ? value : 1;
+	}
+
+	// Hands out one shared copy per distinct blob, for as long as anything
+	// still references it.
+	class Pool
+	{
+		public:
+		blob_t intern(const std::string& blob)
+		{
+			uint64_t                     key = hash(blob);
+			std::unique_lock<std::mutex> lock(mutex);
+
+			auto range = entries.equal_range(key);
+			for (auto it = range.first; it != range.second; ++it) {
+				blob_t entry = it->second.lock();
+				if (entry && *entry == blob)
+					return entry;
+			}
+
+			if (++inserts >= Capacity) {
+				sweep();
+				inserts = 0;
+			}
+
+			blob_t entry = std::make_shared<const std::string>(blob);
+			entries.emplace(key, entry);
+			return entry;
+		}
+
+		size_t size()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			sweep();
+			return entries.size();
+		}
+
+		private:
+		void sweep()
+		{
+			for (auto it = entries.begin(); it != entries.end();) {
+				if (it->second.expired())
+					it = entries.erase(it);
+				else
+					++it;
+			}
+		}
+
+		std::mutex                                                          mutex;
+		std::unordered_multimap<uint64_t, std::weak_ptr<const std::string>> entries;
+		size_t                                                              inserts = 0;
+	};
+
+	// Least recently used map from content hash to a value, dropping the
+	// oldest entry once it holds more than its capacity.
+	template<typename T>
+	class Lru
+	{
+		public:
+		Lru(size_t capacity = Capacity) : capacity(capacity) {}
+
+		bool find(uint64_t key, T& value)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			auto                         it = index.find(key);
+			if (it == index.end())
+				return false;
+
+			order.splice(order.begin(), order, it->second);
+			value = it->second->second;
+			return true;
+		}
+
+		void insert(uint64_t key, T value)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			auto                         it = index.find(key);
+			if (it != index.end()) {
+				it->second->second = std::move(value);
+				order.splice(order.begin(), order, it->second);
+				return;
+			}
+
+			order.emplace_front(key, std::move(value));
+			index.emplace(key, order.begin());
+			if (order.size() > capacity) {
+				index.erase(order.back().first);
+				order.pop_back();
+			}
+		}
+
+		void erase(uint64_t key)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			auto                         it = index.find(key);
+			if (it == index.end())
+				return;
+
+			order.erase(it->second);
+			index.erase(it);
+		}
+
+		private:
+		using entry_t = std::pair<uint64_t, T>;
+
+		std::mutex                                                          mutex;
+		size_t                                                              capacity;
+		std::list<entry_t>                                                  order;
+		std::unordered_map<uint64_t, typename std::list<entry_t>::iterator> index;
+	};
+} // namespace settings_store
@@ -59,6 +59,25 @@ describe(testName, function() {
         expect(stats.averageTimeToRenderFrame).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'averageTimeToRenderFrame'));
         expect(stats.memoryUsage).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'memoryUsage'));
         expect(stats.diskSpaceAvailable).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'diskSpaceAvailable'));
+        expect(stats.recordingStartLatency).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'recordingStartLatency'));
+        expect(stats.recordingStartArmed).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'recordingStartArmed'));
+    });
+
+    it('Get startup trace', function() {
+        const trace = osn.NodeObs.OBS_API_getStartupTrace();
+
+        // Checking if the startup phases were recorded
+        expect(trace).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.StartupTrace, 'object'));
+        expect(trace.traceEvents.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.StartupTrace, 'event count'));
+
+        const names: string[] = trace.traceEvents.map((event: any) => event.name);
+        expect(names).to.include('OBS_API_initAPI', GetErrorMessage(ETestErrorMsg.StartupTrace, 'root phase'));
+        expect(names).to.include('modules', GetErrorMessage(ETestErrorMsg.StartupTrace, 'modules phase'));
+
+        trace.traceEvents.forEach((event: any) => {
+            expect(event.ph).to.equal('X', GetErrorMessage(ETestErrorMsg.StartupTrace, 'event phase'));
+            expect(event.dur).to.be.at.least(0, GetErrorMessage(ETestErrorMsg.StartupTrace, 'event duration'));
+        });
     });
 
     it('Get hotkeys of all sources and process them', function() {
@@ -153,6 +172,33 @@ describe(testName, function() {
         scene.release();
     });
 
+    it('Get hotkeys after sources are created and renamed', function() {
+        const inputName = 'hotkeys_index_input';
+        const renamedInputName = 'hotkeys_index_input_renamed';
+        const countHotkeys = function(objectName: string) {
+            const hotkeys: TOBSHotkey[] = osn.NodeObs.OBS_API_QueryHotkeys();
+            return hotkeys.filter(hotkey => hotkey.ObjectName == objectName).length;
+        };
+
+        // The first query fills the client side cache, the following ones only transfer changes
+        expect(countHotkeys(inputName)).to.equal(0, GetErrorMessage(ETestErrorMsg.HotkeysNotUpdated, 'initialization'));
+
+        // Creating source
+        const input = osn.InputFactory.create('ffmpeg_source', inputName);
+
+        // Checking if input source was created correctly
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, 'ffmpeg_source'));
+
+        const hotkeyCount = countHotkeys(inputName);
+        expect(hotkeyCount).to.not.equal(0, GetErrorMessage(ETestErrorMsg.HotkeysNotUpdated, 'source creation'));
+
+        input.name = renamedInputName;
+        expect(countHotkeys(inputName)).to.equal(0, GetErrorMessage(ETestErrorMsg.HotkeysNotUpdated, 'source rename'));
+        expect(countHotkeys(renamedInputName)).to.equal(hotkeyCount, GetErrorMessage(ETestErrorMsg.HotkeysNotUpdated, 'source rename'));
+
+        input.release();
+    });
+
     it('Stop crash handler', function() {
         // Stopping crash handler as a last test case
         expect(function() {
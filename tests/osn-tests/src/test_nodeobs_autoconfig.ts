@@ -49,6 +49,27 @@ describe(testName, function() {
         }
     });
 
+    it('Run the bandwidth test against a local RTMP server', async function() {
+        // The probes only target local stand-ins when the server process gets
+        // OSN_BANDWIDTH_TEST_SERVERS, e.g. rtmp://127.0.0.1/live
+        if (!process.env.OSN_BANDWIDTH_TEST_SERVERS) {
+            this.skip();
+        }
+
+        let progressInfo: IConfigProgress;
+
+        obs.startAutoconfig();
+
+        osn.NodeObs.StartBandwidthTest();
+
+        progressInfo = await obs.getNextProgressInfo('Bandwidth test');
+        expect(progressInfo.event).to.equal('stopping_step', GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(progressInfo.description).to.equal('bandwidth_test', GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(progressInfo.percentage).to.equal(100, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+
+        osn.NodeObs.TerminateAutoConfig();
+    });
+
     it('Run autoconfig', async function() {
         let progressInfo: IConfigProgress;
 	    let settingValue: any;
@@ -0,0 +1,127 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles, sleep } from '../util/general';
+import { EOBSInputTypes } from '../util/obs_enums';
+import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+
+const testName = 'nodeobs_display';
+
+interface IFrameTapFrame {
+    sequence: number;
+    timestamp: number;
+    width: number;
+    height: number;
+    stride: number;
+    data: Uint8Array;
+}
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Read main output frames from a frame tap', async () => {
+        // Red color source larger than the canvas so every pixel is covered
+        const settings = { color: 0xFF0000FF, width: 4096, height: 4096 };
+        const scene = osn.SceneFactory.create('frame_tap_scene');
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'frame_tap_color', settings);
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+        scene.add(input);
+        osn.Global.setOutputSource(0, scene);
+
+        expect(function() {
+            osn.NodeObs.OBS_content_createFrameTap('frame_tap', 0, 160, 90, 10);
+        }).to.not.throw(undefined, GetErrorMessage(ETestErrorMsg.CreateFrameTap));
+
+        let frame: IFrameTapFrame = undefined;
+        for (let i = 0; i < 30 && frame === undefined; i++) {
+            await sleep(100);
+            frame = osn.NodeObs.OBS_content_getFrameTapFrame('frame_tap');
+        }
+
+        expect(frame).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.FrameTapNoFrame));
+        expect(frame.width).to.equal(160, GetErrorMessage(ETestErrorMsg.FrameTapSize, 'width'));
+        expect(frame.height).to.equal(90, GetErrorMessage(ETestErrorMsg.FrameTapSize, 'height'));
+        expect(frame.stride).to.equal(160 * 4, GetErrorMessage(ETestErrorMsg.FrameTapSize, 'stride'));
+        expect(frame.data.length).to.equal(frame.stride * frame.height, GetErrorMessage(ETestErrorMsg.FrameTapSize, 'data length'));
+
+        // BGRA, sampled in the middle of the frame
+        const offset = 45 * frame.stride + 80 * 4;
+        const pixel = Array.from(frame.data.subarray(offset, offset + 4));
+        expect(osn.NodeObs.OBS_content_isFrameTapFrameValid('frame_tap', frame.sequence)).to.equal(true,
+            GetErrorMessage(ETestErrorMsg.FrameTapInvalidated));
+        expect(pixel).to.eql([0, 0, 255, 255], GetErrorMessage(ETestErrorMsg.FrameTapPixel, pixel.join(',')));
+
+        // Later frames replace earlier ones in the ring
+        let next: IFrameTapFrame = frame;
+        for (let i = 0; i < 30 && next.sequence === frame.sequence; i++) {
+            await sleep(100);
+            next = osn.NodeObs.OBS_content_getFrameTapFrame('frame_tap') || next;
+        }
+        expect(next.sequence).to.be.greaterThan(frame.sequence, GetErrorMessage(ETestErrorMsg.FrameTapNoFrame));
+
+        osn.NodeObs.OBS_content_destroyFrameTap('frame_tap');
+        expect(osn.NodeObs.OBS_content_getFrameTapFrame('frame_tap')).to.equal(undefined);
+
+        scene.release();
+        input.release();
+    });
+
+    it('Reject invalid frame tap arguments', () => {
+        // Only main, streaming and recording rendering can be tapped
+        expect(function() {
+            osn.NodeObs.OBS_content_createFrameTap('frame_tap_mode', 3, 160, 90, 10);
+        }).to.throw();
+        expect(osn.NodeObs.OBS_content_getFrameTapFrame('frame_tap_mode')).to.equal(undefined);
+
+        // Arguments are checked before anything reaches the server
+        expect(function() {
+            osn.NodeObs.OBS_content_createFrameTap('frame_tap_args', 0, 160);
+        }).to.throw(TypeError);
+        expect(function() {
+            osn.NodeObs.OBS_content_createFrameTap(0, 0, 160, 90, 10);
+        }).to.throw(TypeError);
+        expect(function() {
+            osn.NodeObs.OBS_content_getFrameTapFrame();
+        }).to.throw(TypeError);
+    });
+
+    it('Reject render stats of an unknown display', () => {
+        // Drawing needs a native window the test process doesn't have, the
+        // throttling and its counters are covered by the server's native
+        // display-throttle test. Here only the IPC path is exercised.
+        expect(function() {
+            osn.NodeObs.OBS_content_getDisplayRenderStats('no_such_display');
+        }).to.throw();
+    });
+});
@@ -0,0 +1,142 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as os from 'os';
+import * as path from 'path';
+import * as fs from 'fs';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles } from '../util/general';
+import { EOBSInputTypes } from '../util/obs_enums';
+import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+
+const testName = 'osn-collection';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+    const snapshotPath = path.join(os.tmpdir(), 'osn_collection_test.snapshot');
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        if (fs.existsSync(snapshotPath)) {
+            fs.unlinkSync(snapshotPath);
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Save a collection, release it and load it back', () => {
+        const settings = { color: 0xFF00FF00, width: 320, height: 180 };
+        let scene = osn.SceneFactory.create('collection_scene');
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'collection_color', settings);
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+        const sceneItem = scene.add(input);
+        sceneItem.position = { x: 10, y: 20 };
+
+        expect(function() {
+            osn.Collection.save(snapshotPath);
+        }).to.not.throw(undefined, GetErrorMessage(ETestErrorMsg.SaveCollection));
+
+        // The debug export describes the same objects as the file
+        const exported = JSON.parse(osn.Collection.exportJSON(snapshotPath));
+        const exportedScene = exported.scenes.find((entry: any) => entry.name === 'collection_scene');
+        expect(exportedScene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CollectionExport, 'collection_scene'));
+        expect(exportedScene.items.length).to.equal(1, GetErrorMessage(ETestErrorMsg.CollectionExport, 'collection_scene'));
+        expect(exported.inputs.some((entry: any) => entry.name === 'collection_color')).to.equal(true,
+            GetErrorMessage(ETestErrorMsg.CollectionExport, 'collection_color'));
+
+        scene.release();
+        input.release();
+
+        const counts = osn.Collection.load(snapshotPath);
+        expect(counts.inputs).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.LoadCollection));
+        expect(counts.scenes).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.LoadCollection));
+
+        scene = osn.SceneFactory.fromName('collection_scene');
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CollectionScene, 'collection_scene'));
+
+        const items = scene.getItems();
+        expect(items.length).to.equal(1, GetErrorMessage(ETestErrorMsg.CollectionScene, 'collection_scene'));
+        expect(items[0].source.name).to.equal('collection_color', GetErrorMessage(ETestErrorMsg.CollectionScene, 'collection_scene'));
+        expect(items[0].position.x).to.equal(10, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(items[0].position.y).to.equal(20, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(items[0].source.settings['color']).to.equal(settings.color, GetErrorMessage(ETestErrorMsg.CollectionScene, 'collection_color'));
+
+        scene.release();
+    });
+
+    it('Keep the items of a scene that already exists', () => {
+        const scene = osn.SceneFactory.create('collection_keep');
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'collection_keep_color');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+        scene.add(input);
+
+        osn.Collection.save(snapshotPath);
+
+        // Both sources are still alive, so nothing is created and no item is added twice
+        osn.Collection.load(snapshotPath);
+        expect(scene.getItems().length).to.equal(1, GetErrorMessage(ETestErrorMsg.CollectionScene, 'collection_keep'));
+
+        scene.release();
+        input.release();
+    });
+
+    it('Save and load a collection of 1000 sources in under a second each', () => {
+        const count = 1000;
+        const scene = osn.SceneFactory.create('collection_bench');
+        for (let i = 0; i < count; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'collection_bench_' + i, { width: 64, height: 64 });
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+            scene.add(input);
+            input.release();
+        }
+
+        let start = Date.now();
+        osn.Collection.save(snapshotPath);
+        const saveTime = Date.now() - start;
+        logInfo(testName, 'Saved ' + count + ' inputs in ' + saveTime + ' ms');
+        expect(saveTime).to.be.lessThan(1000, GetErrorMessage(ETestErrorMsg.CollectionSaveTime, saveTime.toString()));
+
+        scene.release();
+
+        start = Date.now();
+        const counts = osn.Collection.load(snapshotPath);
+        const loadTime = Date.now() - start;
+        logInfo(testName, 'Loaded ' + counts.inputs + ' inputs and ' + counts.scenes + ' scenes in ' + loadTime + ' ms');
+
+        expect(counts.inputs).to.be.at.least(count, GetErrorMessage(ETestErrorMsg.LoadCollection));
+        expect(loadTime).to.be.lessThan(1000, GetErrorMessage(ETestErrorMsg.CollectionLoadTime, loadTime.toString()));
+
+        const loaded = osn.SceneFactory.fromName('collection_bench');
+        expect(loaded.getItems().length).to.equal(count, GetErrorMessage(ETestErrorMsg.CollectionScene, 'collection_bench'));
+        loaded.release();
+
+        for (let i = 0; i < count; i++) {
+            osn.InputFactory.fromName('collection_bench_' + i).release();
+        }
+    });
+});
@@ -76,6 +76,26 @@ describe(testName, () => {
         });
     });
 
+    it('Get type catalog', () => {
+        const catalog = osn.Global.getTypeCatalog();
+        expect(catalog).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.TypeCatalog));
+
+        // The factories list the catalog's types, with matching flags
+        const inputTypes = catalog.filter(type => type.type == osn.ESourceType.Input).map(type => type.id);
+        const filterTypes = catalog.filter(type => type.type == osn.ESourceType.Filter).map(type => type.id);
+        const transitionTypes = catalog.filter(type => type.type == osn.ESourceType.Transition).map(type => type.id);
+
+        expect(osn.InputFactory.types()).to.eql(inputTypes, GetErrorMessage(ETestErrorMsg.TypeCatalog));
+        expect(osn.FilterFactory.types()).to.eql(filterTypes, GetErrorMessage(ETestErrorMsg.TypeCatalog));
+        expect(osn.TransitionFactory.types()).to.eql(transitionTypes, GetErrorMessage(ETestErrorMsg.TypeCatalog));
+        expect(inputTypes.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.TypeCatalog));
+        expect(osn.Global.getTypeCatalog()).to.eql(catalog, GetErrorMessage(ETestErrorMsg.TypeCatalog));
+
+        catalog.forEach(type => {
+            expect(type.outputFlags).to.equal(osn.Global.getOutputFlagsFromId(type.id), GetErrorMessage(ETestErrorMsg.GetOutputFlags, type.id));
+        });
+    });
+
     it('Get lagged frames value', () => {
         let laggedFrames: number = undefined;
 
@@ -11,6 +11,16 @@ import * as inputSettings from '../util/input_settings';
 
 const testName = 'osn-input';
 
+const internedSettings: ISettings = { color: 0xFF00FFFF, width: 64, height: 64 };
+
+function checkInternedSettings(name: string) {
+    const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, name, internedSettings);
+    expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+    expect(input.settings['color']).to.equal(internedSettings.color, GetErrorMessage(ETestErrorMsg.InputSetting, name));
+    expect(input.settings['width']).to.equal(internedSettings.width, GetErrorMessage(ETestErrorMsg.InputSetting, name));
+    input.release();
+}
+
 describe(testName, () => {
     let obs: OBSHandler;
     let hasTestFailed: boolean = false;
@@ -193,6 +203,70 @@ describe(testName, () => {
         });
     });
 
+    it('Create inputs sharing the same settings', () => {
+        const settings: ISettings = { color: 0xFF0000FF, width: 100, height: 100 };
+        const inputs: IInput[] = [];
+
+        // Later inputs only send a reference to the settings the first one sent
+        for (let i = 0; i < 4; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'shared_settings_' + i, settings);
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+            expect(input.settings['color']).to.equal(settings.color, GetErrorMessage(ETestErrorMsg.InputSetting, input.name));
+            inputs.push(input);
+        }
+
+        // Updating one input leaves the others untouched
+        inputs[0].update({ color: 0xFF00FF00 });
+        expect(inputs[0].settings['color']).to.equal(0xFF00FF00, GetErrorMessage(ETestErrorMsg.InputSetting, inputs[0].name));
+        inputs.slice(1).forEach(function(input) {
+            expect(input.settings['color']).to.equal(settings.color, GetErrorMessage(ETestErrorMsg.InputSetting, input.name));
+        });
+
+        inputs.forEach(function(input) {
+            input.release();
+        });
+    });
+
+    it('Get input dimensions asynchronously', async () => {
+        const inputs: IInput[] = [];
+        for (let i = 0; i < 8; i++) {
+            const settings: ISettings = { width: 100 + i, height: 200 + i };
+            const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'async_size_' + i, settings);
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+            inputs.push(input);
+        }
+
+        // Dimensions are never cached on the client, so all of these are in
+        // flight on the connection at the same time
+        const widths = inputs.map(input => input.getWidthAsync());
+        const heights = inputs.map(input => input.getHeightAsync());
+        const results = await Promise.all([Promise.all(widths), Promise.all(heights)]);
+
+        results[0].forEach((width, i) => {
+            expect(width).to.equal(100 + i, GetErrorMessage(ETestErrorMsg.InputSetting, inputs[i].name));
+        });
+        results[1].forEach((height, i) => {
+            expect(height).to.equal(200 + i, GetErrorMessage(ETestErrorMsg.InputSetting, inputs[i].name));
+        });
+
+        inputs.forEach(function(input) {
+            input.release();
+        });
+    });
+
+    it('Create inputs after the server dropped their settings', () => {
+        checkInternedSettings('evicted_settings_first');
+
+        // More distinct blobs than the server keeps (256). The client forgets the
+        // first one along with the server, so it is sent in full again
+        for (let i = 0; i < 300; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'evicted_settings_' + i, { width: 65 + i, height: 64 });
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+            input.release();
+        }
+        checkInternedSettings('evicted_settings_again');
+    });
+
     it('Create an instance of an input by getting it by name', () => {
         let inputFromName: IInput;
 
@@ -613,3 +687,49 @@ describe(testName, () => {
         }).to.throw();
     });
 });
+
+// Restarts the server under a client that keeps its settings cache, so it runs
+// apart from the other input tests
+describe(testName + '-restart', () => {
+    const restartTestName = testName + '-restart';
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(restartTestName, 'Starting ' + restartTestName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(restartTestName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(restartTestName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(restartTestName, 'Finished ' + restartTestName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Create inputs after the server restarted', () => {
+        checkInternedSettings('restarted_settings_first');
+
+        // The client still believes the new server process holds the blob, the
+        // server answers NotFound and the client resends it in full
+        obs.shutdown();
+        obs.startup();
+        checkInternedSettings('restarted_settings_again');
+    });
+});
@@ -81,4 +81,19 @@ describe(testName, () => {
         // Checking if returned modules are the ones opened
         expect(modules).to.include.members(moduleTypes, GetErrorMessage(ETestErrorMsg.Modules));
     });
+
+    it('Describe all loaded modules', () => {
+        // Getting every module descriptor in one call
+        const described = osn.ModuleFactory.describeAll();
+
+        // Checking if there is one descriptor per loaded module
+        expect(described).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.DescribeModules));
+        expect(described.length).to.equal(osn.ModuleFactory.modules().length, GetErrorMessage(ETestErrorMsg.DescribeModules));
+
+        // Describing again must hand back the same modules instead of new entries
+        const describedAgain = osn.ModuleFactory.describeAll();
+        expect(describedAgain.length).to.equal(described.length, GetErrorMessage(ETestErrorMsg.DescribeModules));
+        expect(describedAgain.map(module => module.fileName)).to.have.ordered.members(
+            described.map(module => module.fileName), GetErrorMessage(ETestErrorMsg.DescribeModules));
+    });
 });
@@ -266,6 +266,44 @@ describe(testName, () => {
         sceneItem.remove();
     });
 
+    it('Get scene item positions asynchronously', async () => {
+        // Getting scene
+        const scene = osn.SceneFactory.fromName(sceneName);
+
+        // Getting source
+        const source = osn.InputFactory.fromName(sourceName);
+
+        // Adding input source to scene several times to create scene items.
+        // Items added without a transform have no cached position, so every
+        // query below goes to the server.
+        const sceneItems: osn.ISceneItem[] = [];
+        for (let i = 0; i < 6; i++) {
+            const sceneItem = scene.add(source);
+            expect(sceneItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, EOBSInputTypes.ImageSource, sceneName));
+            sceneItem.position = {x: i, y: i * 2};
+            sceneItems.push(sceneItem);
+        }
+
+        // Removing an item drops the cached item list of the scene
+        sceneItems.pop().remove();
+
+        // Issuing all queries before awaiting any of them
+        const pending = sceneItems.map(sceneItem => sceneItem.getPositionAsync());
+        const itemsPending = scene.getItemsAsync();
+        const positions = await Promise.all(pending);
+        const items = await itemsPending;
+
+        // Checking if the pipelined responses match the values that were set
+        positions.forEach((position, i) => {
+            expect(position.x).to.equal(i, GetErrorMessage(ETestErrorMsg.PositionX));
+            expect(position.y).to.equal(i * 2, GetErrorMessage(ETestErrorMsg.PositionY));
+        });
+        expect(items.length).to.equal(sceneItems.length, GetErrorMessage(ETestErrorMsg.GetSceneItems, sceneName));
+
+        sceneItems.forEach(sceneItem => sceneItem.remove());
+        source.release();
+    });
+
     it('Set scene item rotation and get it', () => {
         let rotation: number = 180;
 
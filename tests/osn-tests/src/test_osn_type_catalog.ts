@@ -0,0 +1,67 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles } from '../util/general';
+import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+
+const testName = 'osn-type-catalog';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let connected: boolean = false;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+        connected = true;
+    });
+
+    // Shutdown OBS process, unless the test already disconnected from it
+    after(async function() {
+        if (connected) {
+            obs.shutdown();
+        }
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Answer type queries without a server round trip', () => {
+        const catalog = osn.Global.getTypeCatalog();
+        const inputTypes = osn.InputFactory.types();
+        const filterTypes = osn.FilterFactory.types();
+        const transitionTypes = osn.TransitionFactory.types();
+        expect(inputTypes.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.TypeCatalog));
+
+        // Without a connection any round trip fails the run, so the answers
+        // below can only come from the catalog
+        osn.NodeObs.IPC.disconnect();
+        connected = false;
+
+        expect(osn.Global.getTypeCatalog()).to.eql(catalog, GetErrorMessage(ETestErrorMsg.TypeCatalogRoundTrip));
+        expect(osn.InputFactory.types()).to.eql(inputTypes, GetErrorMessage(ETestErrorMsg.TypeCatalogRoundTrip));
+        expect(osn.FilterFactory.types()).to.eql(filterTypes, GetErrorMessage(ETestErrorMsg.TypeCatalogRoundTrip));
+        expect(osn.TransitionFactory.types()).to.eql(transitionTypes, GetErrorMessage(ETestErrorMsg.TypeCatalogRoundTrip));
+        catalog.forEach(type => {
+            expect(osn.Global.getOutputFlagsFromId(type.id)).to.equal(type.outputFlags, GetErrorMessage(ETestErrorMsg.TypeCatalogRoundTrip));
+        });
+    });
+});
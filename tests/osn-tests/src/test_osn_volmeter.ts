@@ -1,9 +1,11 @@
 import 'mocha';
+import * as fs from 'fs';
+import * as path from 'path';
 import { expect } from 'chai';
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { OBSHandler } from '../util/obs_handler';
-import { deleteConfigFiles } from '../util/general';
+import { deleteConfigFiles, sleep } from '../util/general';
 import { EOBSInputTypes } from '../util/obs_enums'
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 
@@ -23,6 +25,43 @@ interface IVolmeter {
     inputPeak: number[];
 }
 
+interface ILevels {
+    magnitude: Float32Array;
+    peak: Float32Array;
+    inputPeak: Float32Array;
+}
+
+// Writes a looping 440 Hz stereo tone, so a media source has audio to meter on any machine
+function writeTone(file: string, seconds: number) {
+    const sampleRate = 48000;
+    const channels = 2;
+    const samples = sampleRate * seconds;
+    const data = Buffer.alloc(samples * channels * 2);
+
+    for (let i = 0; i < samples; i++) {
+        const value = Math.round(Math.sin(2 * Math.PI * 440 * i / sampleRate) * 16384);
+        data.writeInt16LE(value, i * 4);
+        data.writeInt16LE(value, i * 4 + 2);
+    }
+
+    const header = Buffer.alloc(44);
+    header.write('RIFF', 0);
+    header.writeUInt32LE(36 + data.length, 4);
+    header.write('WAVE', 8);
+    header.write('fmt ', 12);
+    header.writeUInt32LE(16, 16);
+    header.writeUInt16LE(1, 20);
+    header.writeUInt16LE(channels, 22);
+    header.writeUInt32LE(sampleRate, 24);
+    header.writeUInt32LE(sampleRate * channels * 2, 28);
+    header.writeUInt16LE(channels * 2, 32);
+    header.writeUInt16LE(16, 34);
+    header.write('data', 36);
+    header.writeUInt32LE(data.length, 40);
+
+    fs.writeFileSync(file, Buffer.concat([header, data]));
+}
+
 const testName = 'osn-volmeter';
 
 describe(testName, () => {
@@ -99,7 +138,7 @@ describe(testName, () => {
         volmeter.attach(input);
 
         // Adding callback to volmeter
-        const cb = volmeter.addCallback((magnitude: number[], peak: number[], inputPeak: number[]) => {});
+        const cb = volmeter.addCallback((magnitude: Float32Array, peak: Float32Array, inputPeak: Float32Array) => {});
 
         // Checking if callback was added correctly
         expect(cb).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
@@ -112,4 +151,92 @@ describe(testName, () => {
 
         input.release();
     });
+
+    it('Add and remove callbacks of 64 volmeters attached to the same source', () => {
+        // Creating audio source
+        const input = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'input');
+
+        // Checking if input source was created correctly
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+
+        const volmeters: osn.IVolmeter[] = [];
+        const callbacks: osn.ICallbackData[] = [];
+
+        for (let i = 0; i < 64; i++) {
+            // Creating volmeter
+            const volmeter = osn.VolmeterFactory.create(osn.EFaderType.IEC);
+            expect(volmeter).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateVolmeter));
+            volmeter.attach(input);
+
+            // Adding callback to volmeter, levels are published from the audio thread from now on
+            const cb = volmeter.addCallback((magnitude: Float32Array, peak: Float32Array, inputPeak: Float32Array) => {});
+            expect(cb).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+
+            volmeters.push(volmeter);
+            callbacks.push(cb);
+        }
+
+        volmeters.forEach((volmeter, index) => {
+            // Removing callback from volmeter while the others keep running
+            const rmResult = volmeter.removeCallback(callbacks[index]);
+            expect(rmResult).to.equal(true, GetErrorMessage(ETestErrorMsg.RemoveVolmeterCallback));
+            volmeter.detach();
+        });
+
+        input.release();
+    });
+
+    it('Receive levels in reused Float32Array views', async function() {
+        // Creating a media source playing a tone
+        const tone = path.join(path.normalize(__dirname), '..', 'osnData', 'volmeter_tone.wav');
+        writeTone(tone, 2);
+
+        const input = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'volmeter_tone', {
+            local_file: tone,
+            looping: true,
+            restart_on_activate: false,
+        });
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.FFMPEGSource));
+        osn.Global.setOutputSource(1, input);
+
+        // Creating volmeter and collecting the levels of the first ticks
+        const volmeter = osn.VolmeterFactory.create(osn.EFaderType.IEC);
+        expect(volmeter).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateVolmeter));
+        volmeter.attach(input);
+
+        const levels: ILevels[] = [];
+        const cb = volmeter.addCallback((magnitude: Float32Array, peak: Float32Array, inputPeak: Float32Array) => {
+            if (levels.length < 3) {
+                levels.push({magnitude, peak, inputPeak});
+            }
+        });
+        expect(cb).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+
+        for (let i = 0; i < 100 && levels.length < 3; i++) {
+            await sleep(50);
+        }
+
+        volmeter.removeCallback(cb);
+        volmeter.detach();
+        osn.Global.setOutputSource(1, null);
+        input.release();
+        fs.unlinkSync(tone);
+
+        expect(levels.length).to.equal(3, GetErrorMessage(ETestErrorMsg.VolmeterLevels));
+
+        levels.forEach(level => {
+            expect(level.magnitude).to.be.an.instanceof(Float32Array, GetErrorMessage(ETestErrorMsg.VolmeterLevels));
+            expect(level.peak).to.be.an.instanceof(Float32Array, GetErrorMessage(ETestErrorMsg.VolmeterLevels));
+            expect(level.inputPeak).to.be.an.instanceof(Float32Array, GetErrorMessage(ETestErrorMsg.VolmeterLevels));
+            expect(level.magnitude.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.VolmeterLevels));
+
+            // Every tick is a view on the same per volmeter buffer, nothing is allocated per callback
+            expect(level.magnitude.buffer).to.equal(levels[0].magnitude.buffer, GetErrorMessage(ETestErrorMsg.VolmeterBufferReused));
+        });
+
+        // Ticks alternate between two slots, each keeping its views
+        expect(levels[2].magnitude).to.equal(levels[0].magnitude, GetErrorMessage(ETestErrorMsg.VolmeterBufferReused));
+        expect(levels[2].peak).to.equal(levels[0].peak, GetErrorMessage(ETestErrorMsg.VolmeterBufferReused));
+        expect(levels[1].magnitude).to.not.equal(levels[0].magnitude, GetErrorMessage(ETestErrorMsg.VolmeterBufferReused));
+    });
 });
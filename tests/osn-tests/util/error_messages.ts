@@ -1,6 +1,8 @@
 export const enum ETestErrorMsg {
     // nodeobs_api
     GetPerformanceStatistics = 'Get performance statistics',
+    StartupTrace = 'Startup trace %VALUE1% is wrong',
+    RecordingStartArmed = 'Recording did not start from the armed output',
     ShowHideInputHotkeys = 'Show hide hotkey container is wrong',
     SlideShowHotkeys = 'Slideshow hotkey container is wrong',
     FFMPEGSourceHotkeys = 'FFMPEG source hotkey container is wrong',
@@ -11,6 +13,7 @@ export const enum ETestErrorMsg {
     AudioLineHotkeys = 'Audio Line hotkey container is wrong',
     CoreAudioInputHotkeys = 'Core Audio Input hotkey container is wrong',
     CoreAudioOutputHotkeys = 'Core Audio Output hotkey container is wrong',
+    HotkeysNotUpdated = 'Hotkeys were not updated after %VALUE1%',
 
     // nodeobs_autoconfig
     BandwidthTest = 'Bandwidth test',
@@ -28,6 +31,12 @@ export const enum ETestErrorMsg {
     DefaultVideoOutput = 'Applied default settings does not have the expected value for video output',
     DefaultFPSType = 'Applied default settings does not have the expected value for fps type',
     DefaultFPSCommon = 'Applied default settings does not have the expected value for fps common',
+    // nodeobs_display
+    CreateFrameTap = 'Failed to create frame tap',
+    FrameTapNoFrame = 'Frame tap did not publish a frame',
+    FrameTapSize = 'Frame tap frame %VALUE1% is wrong',
+    FrameTapPixel = 'Frame tap pixel %VALUE1% does not match the color source',
+    FrameTapInvalidated = 'Frame tap frame was invalidated before it could be overwritten',
     // nodeobs_service
     StreamOutput = 'Stream output',
     RecordingOutput = 'Recording output',
@@ -38,6 +47,7 @@ export const enum ETestErrorMsg {
     RecordOutputStoppedWithError = 'Record ouput stopped with error | Error code: %VALUE1% / Error message: %VALUE2%',
     ReplayBufferDidNotStart = 'Replay buffer failed to start | Error code: %VALUE1% / Error message: %VALUE2%',
     ReplayBufferStoppedWithError = 'Replay buffer stopped with error | Error code: %VALUE1% / Error message: %VALUE2%',
+    RecordingSegment = 'Recording segment %VALUE1% was not closed correctly',
     // nodeobs_settings
     GeneralSettings = 'One or more general settings failed to be updated',
     SingleGeneralSetting = 'Failed to update general setting %VALUE1%',
@@ -63,12 +73,21 @@ export const enum ETestErrorMsg {
     FilterId = 'Filter %VALUE1% id value is wrong',
     FilterName = 'Filter %VALUE1% name is wrong',
     FilterSetting = 'Failed to update settings of filter %VALUE1%',
+    // osn-collection
+    SaveCollection = 'Failed to save the scene collection',
+    LoadCollection = 'Failed to load the scene collection',
+    CollectionExport = 'Exported collection does not match %VALUE1%',
+    CollectionScene = 'Loaded collection does not match %VALUE1%',
+    CollectionSaveTime = 'Saving the collection took %VALUE1% ms',
+    CollectionLoadTime = 'Loading the collection took %VALUE1% ms',
     // osn-global
     NoInputInChannel = 'There were no inputs in channel %VALUE1%',
     InputFromChannelId = 'Input returned from channel has wrong type',
     InputFromChannelName = 'Input returned from channel has wrong name',
     ChannelNotEmpty = 'Channel %VALUE1% was not empty',
     GetOutputFlags = 'Failed to get output flags from input id %VALUE1%',
+    TypeCatalog = 'Type catalog does not match the registered types',
+    TypeCatalogRoundTrip = 'Type catalog was fetched from the server again',
     LaggedFrames = 'Failed to get lagged frames value',
     TotalFrames = 'Failed to get total frames value',
     Locale = 'Failed to update locale',
@@ -93,6 +112,7 @@ export const enum ETestErrorMsg {
     // osn-module
     OpenModule = 'Failed to open module %VALUE1%',
     Modules = 'Failed to get all opened modules',
+    DescribeModules = 'Failed to describe all loaded modules',
     // osn-scene
     CreateScene = 'Failed to create scene %VALUE1%',
     SceneId = 'Scene %VALUE1% id value is wrong',
@@ -162,7 +182,9 @@ export const enum ETestErrorMsg {
     // osn-volmeter
     CreateVolmeter = 'Failed to create volmeter',
     VolmeterCallback = 'Failed to add callback to volmeter',
-    RemoveVolmeterCallback = 'Failed to remove callback from volmeter'
+    RemoveVolmeterCallback = 'Failed to remove callback from volmeter',
+    VolmeterLevels = 'Volmeter callback did not receive Float32Array levels',
+    VolmeterBufferReused = 'Volmeter callback levels are not views on the reused buffer'
 }
 
 export function GetErrorMessage(message: string, value1?: string, value2?: string, value3?: string): string {
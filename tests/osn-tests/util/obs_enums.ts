@@ -17,6 +17,7 @@ export const enum EOBSOutputSignal {
     Writing = 'writing',
     Wrote = 'wrote',
     WriteError = 'writing_error',
+    SegmentClosed = 'segment_closed',
 }
 
 export const enum EOBSInputTypes {
@@ -18,6 +18,8 @@ export interface IPerformanceState {
     averageTimeToRenderFrame: number;
     memoryUsage: number;
     diskSpaceAvailable: string;
+    recordingStartLatency: number;
+    recordingStartArmed: boolean;
 }
 
 export interface IOBSOutputSignalInfo {
@@ -25,6 +27,7 @@ export interface IOBSOutputSignalInfo {
     signal: EOBSOutputSignal;
     code: osn.EOutputCode;
     error: string;
+    path: string;
 }
 
 export interface IConfigProgress {